@@ -0,0 +1,154 @@
+#pragma once
+
+#include <vector>
+#include <color_spinor_field_order.h>
+#include <float_vector.h>
+
+/**
+   @file blas_helper.cuh
+
+   @brief Helpers shared by the host (CPU field) implementations of
+   the blas, reduce, multi-blas and multi-reduce kernels.
+*/
+
+namespace quda {
+
+  namespace blas {
+
+    /**
+       @brief Number of checkerboard sites accumulated into each
+       partial sum by the host reductions.  This is fixed, rather than
+       derived from the number of threads, so that the host reductions
+       give bit-identical results for any OpenMP configuration.
+    */
+    constexpr int host_reduce_block = 1024;
+
+    /**
+       @brief Site accessor used by the host blas kernels.  Entire
+       sites are loaded from, and saved to, a host field of any
+       supported order as an array of complex two-vectors in the
+       compute precision, which the blas functors then act on element
+       by element.
+       @tparam Float2 Compute type (float2 or double2)
+       @tparam Float Storage precision of the field
+       @tparam nSpin Number of spin components
+       @tparam nColor Number of colors
+       @tparam order Field order
+    */
+    template <typename Float2, typename Float, int nSpin, int nColor, QudaFieldOrder order>
+    struct HostSpinor {
+      typedef typename colorspinor_order_mapper<Float,order,nSpin,nColor>::type Order;
+      typedef typename Order::RegType RegType;
+      static constexpr int length = nSpin * nColor; // complex elements per site
+      Order field;
+
+      HostSpinor(const ColorSpinorField &f) : field(f) { }
+
+      inline void load(Float2 v[length], int x_cb, int parity) const
+      {
+        RegType tmp[2*length];
+        field.load(tmp, x_cb, parity);
+#pragma omp simd
+        for (int i=0; i<length; i++) {
+          v[i].x = tmp[2*i+0];
+          v[i].y = tmp[2*i+1];
+        }
+      }
+
+      inline void save(const Float2 v[length], int x_cb, int parity)
+      {
+        RegType tmp[2*length];
+#pragma omp simd
+        for (int i=0; i<length; i++) {
+          tmp[2*i+0] = v[i].x;
+          tmp[2*i+1] = v[i].y;
+        }
+        field.save(tmp, x_cb, parity);
+      }
+    };
+
+    /**
+       @brief Convert a coefficient matrix to the compute precision for
+       use by the host multi-blas functors, which index it as
+       a[NYW*i + j] (no padding to MAX_MULTI_BLAS_N as is done for the
+       constant-memory copy used on the device).
+       @param[out] host Host buffer the converted matrix is written to
+       @param[in] a The coefficient matrix
+       @param[in] NXZ Number of rows
+       @param[in] NYW Number of columns
+       @return Pointer to the converted matrix
+    */
+    template <typename Float2, typename T>
+    inline signed char* hostCoeff(signed char *host, const T *a, int NXZ, int NYW)
+    {
+      Float2 *A = reinterpret_cast<Float2*>(host);
+      for (int i=0; i<NXZ; i++) for (int j=0; j<NYW; j++) {
+          Complex a_ij(a[NYW*i+j]);
+          A[NYW*i+j].x = a_ij.real();
+          A[NYW*i+j].y = a_ij.imag();
+        }
+      return host;
+    }
+
+    /**
+       @brief Number of host reduction blocks required for a field
+       with the given checkerboard volume and number of parities.
+    */
+    inline int hostReduceBlocks(int volumeCB, int nParity)
+    { return nParity * ((volumeCB + host_reduce_block - 1) / host_reduce_block); }
+
+    /**
+       @brief Deterministic pairwise summation of the per-block partial
+       sums computed by the host reductions.  The partial sums are
+       stored as partial[i*m + j] for block i < n and reduction j < m,
+       and the result is left in partial[0..m).  The summation tree
+       depends only on n, so the result is independent of how the
+       blocks were distributed over threads, and the rounding error
+       grows as O(log n) rather than O(n).
+    */
+    template <typename T> inline void pairwiseSum(T *partial, int n, int m = 1)
+    {
+      for (int stride=1; stride<n; stride*=2) {
+        for (int i=0; i+stride<n; i+=2*stride) {
+          for (int j=0; j<m; j++) partial[i*m+j] += partial[(i+stride)*m+j];
+        }
+      }
+    }
+
+    /**
+       @brief Deterministic host reduction of site(parity, x_cb) over
+       the checkerboard sites of a field, for the host paths of the
+       reductions that live outside of blas (plaquette, topological
+       charge, etc.).  The sites are blocked as in the host blas
+       reductions, with the blocks distributed over OpenMP threads, so
+       the result is bit-identical for any thread count and schedule.
+       @param[in] site Functor returning the contribution of a site
+       @param[in] volumeCB Checkerboard volume
+       @param[in] nParity Number of parities
+       @return The sum over all sites
+    */
+    template <typename T, typename Site> inline T hostReduce(Site site, int volumeCB, int nParity = 2)
+    {
+      const int n_block = hostReduceBlocks(volumeCB, nParity) / nParity;
+      std::vector<T> partial(nParity * n_block);
+
+#pragma omp parallel for collapse(2) schedule(runtime)
+      for (int parity=0; parity<nParity; parity++) {
+        for (int b=0; b<n_block; b++) {
+          T sum;
+          ::quda::zero(sum);
+
+          const int x_end = (b+1)*host_reduce_block < volumeCB ? (b+1)*host_reduce_block : volumeCB;
+          for (int x=b*host_reduce_block; x<x_end; x++) sum += site(parity, x);
+
+          partial[parity*n_block + b] = sum;
+        }
+      }
+
+      pairwiseSum(partial.data(), nParity * n_block);
+      return partial[0];
+    }
+
+  } // namespace blas
+
+} // namespace quda
@@ -2,6 +2,7 @@
 #define _QUDA_BLAS_H
 
 #include <quda_internal.h>
+#include <comm_quda.h>
 #include <color_spinor_field.h>
 
 // ---------- blas_quda.cu ----------
@@ -66,6 +67,68 @@ namespace quda {
     void doubleCG3Update(double a, double b, ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField &z);
 
 
+    /**
+       @brief The result of a reduction whose global (multi-process)
+       sum may still be in flight.  The local reduction has completed
+       by the time the future is returned, so the caller can issue
+       further work, e.g., the next matrix-vector product, before
+       calling get() to wait for the global sum.  Futures are
+       move-only, and any outstanding reduction is completed when the
+       future is destroyed.
+    */
+    template <typename T> class ReduceFuture {
+      T value;
+      ReduceHandle *handle;
+
+    public:
+      /**
+         @brief Construct an empty future with no reduction in flight
+      */
+      ReduceFuture() : value(), handle(nullptr) { }
+
+      /**
+         @brief Start the global sum of a local reduction result
+         @param[in] local Result of the local reduction
+      */
+      ReduceFuture(const T &local) :
+        value(local), handle(reduceDoubleArrayStart(reinterpret_cast<const double*>(&value), sizeof(T)/sizeof(double))) { }
+
+      ReduceFuture(ReduceFuture &&f) : value(f.value), handle(f.handle) { f.handle = nullptr; }
+      ReduceFuture(const ReduceFuture &) = delete;
+      ReduceFuture& operator=(const ReduceFuture &) = delete;
+
+      ReduceFuture& operator=(ReduceFuture &&f)
+      {
+        if (this != &f) {
+          get(); // complete any reduction we are replacing
+          value = f.value;
+          handle = f.handle;
+          f.handle = nullptr;
+        }
+        return *this;
+      }
+
+      ~ReduceFuture() { get(); }
+
+      /**
+         @return Whether the global sum has completed
+      */
+      bool ready() { return !handle || comm_query_reduce(handle); }
+
+      /**
+         @brief Wait for the global sum to complete
+         @return The globally reduced result
+      */
+      T get()
+      {
+        if (handle) {
+          reduceDoubleArrayWait(handle, reinterpret_cast<double*>(&value));
+          handle = nullptr;
+        }
+        return value;
+      }
+    };
+
     // reduction kernels - defined in reduce_quda.cu
 
     double norm1(const ColorSpinorField &b);
@@ -113,6 +176,26 @@ namespace quda {
     double doubleCG3InitNorm(double a, ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField &z);
     double doubleCG3UpdateNorm(double a, double b, ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField &z);
 
+    /**
+       @brief Fused vector update and reductions of pipelined CG:
+       s = w + beta*s, z = q + beta*z, r -= alpha*s, w -= alpha*z
+       @return (r,r) and (w,r) of the updated vectors
+    */
+    double2 pipelinedCGUpdate(double alpha, double beta, ColorSpinorField &s, ColorSpinorField &z,
+                              ColorSpinorField &r, ColorSpinorField &w, ColorSpinorField &q);
+
+    // non-blocking variants of the above, which return once the local
+    // reduction is complete and leave the global sum in flight
+
+    ReduceFuture<double> norm2Async(const ColorSpinorField &a);
+    ReduceFuture<double> reDotProductAsync(ColorSpinorField &x, ColorSpinorField &y);
+    ReduceFuture<Complex> cDotProductAsync(ColorSpinorField &x, ColorSpinorField &y);
+    ReduceFuture<double3> cDotProductNormAAsync(ColorSpinorField &a, ColorSpinorField &b);
+    ReduceFuture<double3> tripleCGReductionAsync(ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField &z);
+    ReduceFuture<double4> quadrupleCGReductionAsync(ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField &z);
+    ReduceFuture<double2> pipelinedCGUpdateAsync(double alpha, double beta, ColorSpinorField &s, ColorSpinorField &z,
+                                                 ColorSpinorField &r, ColorSpinorField &w, ColorSpinorField &q);
+
 
     // multi-blas kernels - defined in multi_blas.cu
 
@@ -935,9 +935,11 @@ namespace quda {
 			int nFace, int dagger, MemoryLocation *destination=nullptr);
 
   /**
-     @brief Generate a random noise spinor.  This variant allows the user to manage the RNG state.
+     @brief Generate a random noise spinor.  This variant allows the
+     user to manage the RNG, which is advanced so that successive
+     calls draw fresh noise.
      @param src The colorspinorfield
-     @param randstates Random state
+     @param randstates Random number generator
      @param type The type of noise to create (QUDA_NOISE_GAUSSIAN or QUDA_NOISE_UNIFORM)
   */
   void spinorNoise(ColorSpinorField &src, RNG& randstates, QudaNoiseType type);
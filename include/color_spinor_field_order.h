@@ -1394,6 +1394,7 @@ namespace quda {
     template <typename Float, int Ns, int Nc>
       struct QDPJITDiracOrder {
   typedef typename mapper<Float>::type RegType;
+  static const int length = 2 * Ns * Nc;
   Float *field;
   int volumeCB;
   int stride;
@@ -1509,6 +1510,8 @@ namespace quda {
   template<typename T, int Ns, int Nc> struct colorspinor_order_mapper<T,QUDA_SPACE_COLOR_SPIN_FIELD_ORDER,Ns,Nc> { typedef colorspinor::SpaceColorSpinorOrder<T, Ns, Nc> type; };
   template<typename T, int Ns, int Nc> struct colorspinor_order_mapper<T,QUDA_SPACE_SPIN_COLOR_FIELD_ORDER,Ns,Nc> { typedef colorspinor::SpaceSpinorColorOrder<T, Ns, Nc> type; };
   template<typename T, int Ns, int Nc> struct colorspinor_order_mapper<T,QUDA_FLOAT2_FIELD_ORDER,Ns,Nc> { typedef colorspinor::FloatNOrder<T, Ns, Nc, 2> type; };
+  template<typename T, int Ns, int Nc> struct colorspinor_order_mapper<T,QUDA_PADDED_SPACE_SPIN_COLOR_FIELD_ORDER,Ns,Nc> { typedef colorspinor::PaddedSpaceSpinorColorOrder<T, Ns, Nc> type; };
+  template<typename T, int Ns, int Nc> struct colorspinor_order_mapper<T,QUDA_QDPJIT_FIELD_ORDER,Ns,Nc> { typedef colorspinor::QDPJITDiracOrder<T, Ns, Nc> type; };
 
 } // namespace quda
 
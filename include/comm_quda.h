@@ -1,11 +1,21 @@
 #pragma once
 #include <cstdint>
+#include <stddef.h>
+
+/* with the threaded backend every rank is a thread of one process, so
+   per-rank state of the comms layer has to be thread local */
+#ifdef THREADS_COMMS
+#define COMM_RANK_LOCAL thread_local
+#else
+#define COMM_RANK_LOCAL
+#endif
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
   typedef struct MsgHandle_s MsgHandle;
+  typedef struct ReduceHandle_s ReduceHandle;
   typedef struct Topology_s Topology;
 
   /* defined in quda.h; redefining here to avoid circular references */ 
@@ -132,7 +142,7 @@ extern "C" {
   */
   const char* comm_dim_topology_string();
 
-  /* implemented in comm_single.cpp, comm_qmp.cpp, and comm_mpi.cpp */
+  /* implemented in comm_single.cpp, comm_qmp.cpp, comm_mpi.cpp and comm_threads.cpp */
 
   void comm_init(int ndim, const int *dims, QudaCommsMap rank_from_coords, void *map_data);
   int comm_rank(void);
@@ -267,13 +277,96 @@ extern "C" {
   void comm_allreduce_max_array(double* data, size_t size);
   void comm_allreduce_int(int* data);
   void comm_allreduce_xor(uint64_t *data);
+
+  /**
+     @brief Start a non-blocking global sum of an array of doubles.
+     The input is copied into the handle, so the caller's buffer may
+     be reused as soon as this returns.  Backends without
+     non-blocking collectives complete the reduction here.
+     @param[in] data Local values to be summed
+     @param[in] size Number of elements
+     @return Handle to the reduction, which must be completed with
+     comm_wait_reduce
+  */
+  ReduceHandle *comm_iallreduce_array(const double *data, size_t size);
+
+  /**
+     @brief Start a non-blocking global sum of a single double
+     @param[in] data Local value to be summed
+     @return Handle to the reduction
+  */
+  ReduceHandle *comm_iallreduce(const double *data);
+
+  /**
+     @brief Test whether a non-blocking reduction has completed.
+     Calling this also gives the communication library an
+     opportunity to progress the reduction.
+     @param[in] rh Reduction handle
+     @return Non-zero if the reduction has completed
+  */
+  int comm_query_reduce(ReduceHandle *rh);
+
+  /**
+     @brief Complete a non-blocking reduction, writing the global sum
+     to data and freeing the handle
+     @param[in] rh Reduction handle
+     @param[out] data Array the result is written to
+  */
+  void comm_wait_reduce(ReduceHandle *rh, double *data);
+
   void comm_broadcast(void *data, size_t nbytes);
   void comm_barrier(void);
   void comm_abort(int status);
 
+#ifdef THREADS_COMMS
+  /* implemented in comm_threads.cpp */
+
+  /**
+     @brief Communication counters of a single rank, accumulated since
+     comm_init or the last comm_threads_stats_reset
+  */
+  typedef struct CommStats_s {
+    size_t messages;        // number of point-to-point messages sent
+    size_t bytes;           // total payload of the messages sent
+    size_t collectives;     // number of reductions, broadcasts and barriers
+    double collective_time; // wall-clock seconds spent in collectives
+  } CommStats;
+
+  /**
+     @brief Run rank_main(arg) on n threads, each of which acts as one
+     rank of the threaded comms backend, and return once all have
+     finished.  comm_init (or initCommsGridQuda) must be called from
+     within rank_main.
+     @param[in] n Number of ranks
+     @param[in] rank_main Function run by every rank
+     @param[in] arg Argument passed to rank_main
+     @return Zero on success
+  */
+  int comm_threads_launch(int n, void (*rank_main)(void *), void *arg);
+
+  /**
+     @brief Return the communication counters of the calling rank
+     @param[out] stats Counters of this rank
+  */
+  void comm_threads_stats(CommStats *stats);
+
+  /**
+     @brief Zero the communication counters of the calling rank
+  */
+  void comm_threads_stats_reset();
+#endif
+
   void reduceMaxDouble(double &);
   void reduceDouble(double &);
   void reduceDoubleArray(double *, const int len);
+
+  /**
+     @brief Non-blocking counterpart of reduceDoubleArray.  Returns
+     NULL if global reductions are disabled, in which case
+     reduceDoubleArrayWait leaves the data unchanged.
+  */
+  ReduceHandle *reduceDoubleArrayStart(const double *, const int len);
+  void reduceDoubleArrayWait(ReduceHandle *, double *);
   int commDim(int);
   int commCoords(int);
   int commDimPartitioned(int dir);
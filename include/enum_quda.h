@@ -125,6 +125,7 @@ extern "C" {
     QUDA_CA_CGNE_INVERTER,
     QUDA_CA_CGNR_INVERTER,
     QUDA_CA_GCR_INVERTER,
+    QUDA_PIPELINED_CG_INVERTER,
     QUDA_INVALID_INVERTER = QUDA_INVALID_ENUM
   } QudaInverterType;
 
@@ -486,6 +487,12 @@ extern "C" {
     QUDA_CONTRACT_INVALID = QUDA_INVALID_ENUM
   } QudaContractType;
 
+  typedef enum QudaWFlowType_s {
+    QUDA_WFLOW_TYPE_WILSON,
+    QUDA_WFLOW_TYPE_SYMANZIK,
+    QUDA_WFLOW_TYPE_INVALID = QUDA_INVALID_ENUM
+  } QudaWFlowType;
+
   //Allows to choose an appropriate external library
   typedef enum QudaExtLibType_s {
     QUDA_CUSOLVE_EXTLIB,
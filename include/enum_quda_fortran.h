@@ -123,6 +123,7 @@
 #define QUDA_CA_CGNE_INVERTER 23
 #define QUDA_CA_CGNR_INVERTER 24
 #define QUDA_CA_GCR_INVERTER 25
+#define QUDA_PIPELINED_CG_INVERTER 26
 #define QUDA_INVALID_INVERTER QUDA_INVALID_ENUM
 
 #define QudaEigType integer(4)
@@ -435,6 +436,11 @@
 #define QUDA_CONTRACT_TSLICE_MINUS 8
 #define QUDA_CONTRACT_INVALID QUDA_INVALID_ENUM
 
+#define QudaWFlowType integer(4)
+#define QUDA_WFLOW_TYPE_WILSON 0
+#define QUDA_WFLOW_TYPE_SYMANZIK 1
+#define QUDA_WFLOW_TYPE_INVALID QUDA_INVALID_ENUM
+
 #define QudaExtLibType integer(4)
 #define QUDA_CUSOLVE_EXTLIB 0
 #define QUDA_EIGEN_EXTLIB 1
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <enum_quda.h>
+
+/**
+   Native parallel binary I/O for host fields, which needs no external
+   library.  A file holds a header, an index with the offset, length
+   and checksum of the block of each rank, and then one contiguous,
+   page-aligned block per rank in rank order.  Every rank writes its
+   own block with pwrite and reads it back through mmap, so the files
+   are read on the process grid they were written on.
+ */
+
+namespace quda {
+
+  /**
+     @brief Whether a file is in the native field format
+     @param[in] filename File to test
+     @return True if the file exists and starts with the native header
+  */
+  bool is_native_field_file(const char *filename);
+
+  /**
+     @brief Precision to write fields of precision prec at.  This is
+     prec unless QUDA_FIELD_IO_PRECISION is set to a lower precision
+     (double, single, half or quarter), in which case fields are
+     down-converted on write.  Half and quarter precision store the
+     field compressed in block-float format, and apply only when
+     compress is true: other fields are written at single precision.
+     The variable is read on each call, so it may change between writes.
+     @param[in] prec Precision of the host field
+     @param[in] compress Whether lossy compression is acceptable
+     @return Precision used in the file
+  */
+  QudaPrecision native_field_io_precision(QudaPrecision prec, bool compress);
+
+  /**
+     @brief Read a gauge field in QDP order (four arrays of 18 reals
+     per site) from a native file
+     @param[in] filename File to read
+     @param[out] gauge Host arrays of the four directions
+     @param[in] prec Precision of the host arrays
+     @param[in] X Local lattice dimensions
+  */
+  void read_gauge_field_native(const char *filename, void *gauge[], QudaPrecision prec, const int *X);
+
+  /**
+     @brief Write a gauge field in QDP order to a native file
+     @param[in] filename File to write
+     @param[in] gauge Host arrays of the four directions
+     @param[in] prec Precision of the host arrays
+     @param[in] X Local lattice dimensions
+     @param[in] file_prec Precision to store in the file
+  */
+  void write_gauge_field_native(const char *filename, void *gauge[], QudaPrecision prec, const int *X,
+                                QudaPrecision file_prec);
+
+  /**
+     @brief Read Nvec color-spinor fields in space-spin-color order from
+     a native file
+     @param[in] filename File to read
+     @param[out] V Host arrays of the vectors
+     @param[in] prec Precision of the host arrays
+     @param[in] X Local lattice dimensions
+     @param[in] nColor Number of colors
+     @param[in] nSpin Number of spins
+     @param[in] Nvec Number of vectors
+  */
+  void read_spinor_field_native(const char *filename, void *V[], QudaPrecision prec, const int *X, int nColor,
+                                int nSpin, int Nvec);
+
+  /**
+     @brief Write Nvec color-spinor fields in space-spin-color order
+     to a native file.  With file_prec half or quarter the fields are
+     compressed, and the relative error of the compression is reported.
+     @param[in] filename File to write
+     @param[in] V Host arrays of the vectors
+     @param[in] prec Precision of the host arrays
+     @param[in] X Local lattice dimensions
+     @param[in] nColor Number of colors
+     @param[in] nSpin Number of spins
+     @param[in] Nvec Number of vectors
+     @param[in] file_prec Precision to store in the file, which may
+     be half or quarter
+  */
+  void write_spinor_field_native(const char *filename, void *V[], QudaPrecision prec, const int *X, int nColor,
+                                 int nSpin, int Nvec, QudaPrecision file_prec);
+
+} // namespace quda
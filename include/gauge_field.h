@@ -347,7 +347,9 @@ namespace quda {
     double abs_min(int dim=-1) const;
 
     /**
-       Compute checksum of this gauge field: this uses a XOR-based checksum method
+       Compute checksum of this gauge field: this uses a XOR-based
+       checksum method, where each word is first mixed with its
+       position in the field
        @param[in] mini Whether to compute a mini checksum or global checksum.
        A mini checksum only computes the checksum over a subset of the lattice
        sites and is to be used for online comparisons, e.g., checking
@@ -709,7 +711,10 @@ namespace quda {
 
   /**
      Compute XOR-based checksum of this gauge field: each gauge field entry is
-     converted to type uint64_t, and compute the cummulative XOR of these values.
+     converted to type uint64_t and hashed together with its global
+     position, and we compute the cummulative XOR of these values.
+     The host computation is multi-threaded and supports all the
+     host gauge orders.
      @param[in] mini Whether to compute a mini checksum or global checksum.
      A mini checksum only computes over a subset of the lattice
      sites and is to be used for online comparisons, e.g., checking
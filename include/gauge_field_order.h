@@ -1903,9 +1903,14 @@ namespace quda {
       const int volumeCB;
     QDPOrder(const GaugeField &u, Float *gauge_=0, Float **ghost_=0)
       : LegacyOrder<Float,length>(u, ghost_), volumeCB(u.VolumeCB())
-	{ for (int i=0; i<4; i++) gauge[i] = gauge_ ? ((Float**)gauge_)[i] : ((Float**)u.Gauge_p())[i]; }
+	{
+	  // one pointer per geometry component, e.g., six for tensor fields
+	  if (u.Geometry() > QUDA_MAX_DIM) errorQuda("Geometry %d not supported", u.Geometry());
+	  for (int i=0; i<u.Geometry(); i++) gauge[i] = gauge_ ? ((Float**)gauge_)[i] : ((Float**)u.Gauge_p())[i];
+	  for (int i=u.Geometry(); i<QUDA_MAX_DIM; i++) gauge[i] = nullptr;
+	}
     QDPOrder(const QDPOrder &order) : LegacyOrder<Float,length>(order), volumeCB(order.volumeCB) {
-	for(int i=0; i<4; i++) gauge[i] = order.gauge[i];
+	for(int i=0; i<QUDA_MAX_DIM; i++) gauge[i] = order.gauge[i];
       }
       virtual ~QDPOrder() { ; }
 
@@ -2677,6 +2682,8 @@ namespace quda {
   template<typename T, int Nc> struct gauge_order_mapper<T,QUDA_BQCD_GAUGE_ORDER,Nc> { typedef gauge::BQCDOrder<T, 2*Nc*Nc> type; };
   template<typename T, int Nc> struct gauge_order_mapper<T,QUDA_TIFR_GAUGE_ORDER,Nc> { typedef gauge::TIFROrder<T, 2*Nc*Nc> type; };
   template<typename T, int Nc> struct gauge_order_mapper<T,QUDA_TIFR_PADDED_GAUGE_ORDER,Nc> { typedef gauge::TIFRPaddedOrder<T, 2*Nc*Nc> type; };
+  template<typename T, int Nc> struct gauge_order_mapper<T,QUDA_CPS_WILSON_GAUGE_ORDER,Nc> { typedef gauge::CPSOrder<T, 2*Nc*Nc> type; };
+  template<typename T, int Nc> struct gauge_order_mapper<T,QUDA_MILC_SITE_GAUGE_ORDER,Nc> { typedef gauge::MILCSiteOrder<T, 2*Nc*Nc> type; };
   template<typename T, int Nc> struct gauge_order_mapper<T,QUDA_FLOAT2_GAUGE_ORDER,Nc> { typedef gauge::FloatNOrder<T, 2*Nc*Nc, 2, 2*Nc*Nc> type; };
 
   // experiments in reducing template instantation boilerplate
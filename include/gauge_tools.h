@@ -14,9 +14,11 @@ namespace quda {
 
 
 
-  /** Generate Gaussian distributed GaugeField
+  /** Generate Gaussian distributed GaugeField, on the device or (in
+   * QDP or MILC order) on the host.  The field only depends on the seed
+   * and generation of the RNG, not on the partitioning.
    * @param dataDs The GaugeField
-   * @param rngstate random states
+   * @param rngstate random number generator, advanced after the field is generated
    */
 
   void gaugeGauss(GaugeField &dataDs, RNG &rngstate);
@@ -55,6 +57,30 @@ namespace quda {
 			const GaugeField& dataOr,
 			double rho, double epsilon);
 
+  /**
+     Advance the gradient flow by one step of Luscher's third-order
+     Runge-Kutta integrator.  The stages alternate between in and out,
+     so the halo of both is refreshed and in is overwritten.
+
+     @param out Flowed gauge field
+     @param temp Runge-Kutta accumulator, with the geometry of in and no reconstruction
+     @param in Input gauge field, used as scratch space
+     @param epsilon Flow-time step size
+     @param wflow_type Wilson or tree-level Symanzik flow
+  */
+  void WFlowStep(GaugeField &out, GaugeField &temp, GaugeField &in,
+		 double epsilon, QudaWFlowType wflow_type);
+
+  /**
+     Measure the flow observables of an extended gauge field in a
+     single pass using the clover field strength
+
+     @param u The gauge field
+     @return double3 variable returning (plaquette energy density,
+     clover energy density, topological charge)
+  */
+  double3 computeWFlowObservables(const GaugeField &u);
+
 
   /**
    * @brief Gauge fixing with overrelaxation with support for single and multi GPU.
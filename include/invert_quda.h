@@ -506,6 +506,30 @@ namespace quda {
     void operator()(ColorSpinorField &out, ColorSpinorField &in);
   };
 
+  /**
+     @brief Pipelined (Ghysels-Vanroose) Conjugate-Gradient Solver.
+     All the inner products of an iteration are computed by a single
+     fused reduction, whose global sum is overlapped with the next
+     application of the operator, so each iteration incurs one global
+     synchronization that is hidden behind the matrix-vector product.
+   */
+  class PipelinedCG : public Solver {
+
+  private:
+    const DiracMatrix &mat;
+    const DiracMatrix &matSloppy;
+    // pointers to fields to avoid multiple creation overhead
+    ColorSpinorField *yp, *rp, *tmpp, *tmp2p, *tmp3p, *rSloppyp, *xSloppyp;
+    ColorSpinorField *pp, *sp, *zp, *wp, *qp;
+    bool init;
+
+  public:
+    PipelinedCG(DiracMatrix &mat, DiracMatrix &matSloppy, SolverParam &param, TimeProfile &profile);
+    virtual ~PipelinedCG();
+
+    void operator()(ColorSpinorField &out, ColorSpinorField &in);
+  };
+
 
 
   class CG3NE : public Solver {
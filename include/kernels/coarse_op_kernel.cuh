@@ -197,7 +197,7 @@ namespace quda {
   void ComputeUVCPU(Arg &arg) {
 
     for (int parity=0; parity<2; parity++) {
-#pragma omp parallel for
+#pragma omp parallel for schedule(runtime)
       for (int x_cb=0; x_cb<arg.fineVolumeCB; x_cb++) {
 	for (int ic_c=0; ic_c < coarseColor; ic_c++) // coarse color
 	  if (dir == QUDA_FORWARDS) // only for preconditioned clover is V != AV
@@ -270,7 +270,7 @@ namespace quda {
   template<typename Float, int fineSpin, int fineColor, int coarseColor, typename Arg>
   void ComputeAVCPU(Arg &arg) {
     for (int parity=0; parity<2; parity++) {
-#pragma omp parallel for
+#pragma omp parallel for schedule(runtime)
       for (int x_cb=0; x_cb<arg.fineVolumeCB; x_cb++) {
 	for (int ic_c=0; ic_c < coarseColor; ic_c++) // coarse color
 	  computeAV<Float,fineSpin,fineColor,coarseColor,Arg>(arg, parity, x_cb, ic_c);
@@ -316,7 +316,7 @@ namespace quda {
   template<typename Float, int fineSpin, int fineColor, int coarseColor, typename Arg>
   void ComputeTMAVCPU(Arg &arg) {
     for (int parity=0; parity<2; parity++) {
-#pragma omp parallel for
+#pragma omp parallel for schedule(runtime)
       for (int x_cb=0; x_cb<arg.fineVolumeCB; x_cb++) {
 	for (int v=0; v<coarseColor; v++) // coarse color
 	  computeTMAV<Float,fineSpin,fineColor,coarseColor,Arg>(arg, parity, x_cb, v);
@@ -593,7 +593,7 @@ namespace quda {
   void ComputeCloverInvMaxCPU(Arg &arg) {
     Float max = 0.0;
     for (int parity=0; parity<2; parity++) {
-#pragma omp parallel for reduction(max:max)
+#pragma omp parallel for schedule(runtime) reduction(max:max)
       for (int x_cb=0; x_cb<arg.fineVolumeCB; x_cb++) {
 	Float max_x = computeCloverInvMax<Float,Arg>(arg, parity, x_cb);
 	max = max > max_x ? max : max_x;
@@ -699,7 +699,7 @@ namespace quda {
   template<typename Float, int fineSpin, int fineColor, int coarseColor, typename Arg>
   void ComputeTMCAVCPU(Arg &arg) {
     for (int parity=0; parity<2; parity++) {
-#pragma omp parallel for
+#pragma omp parallel for schedule(runtime)
       for (int x_cb=0; x_cb<arg.fineVolumeCB; x_cb++) {
 	computeTMCAV<Float,fineSpin,fineColor,coarseColor,Arg>(arg, parity, x_cb);
       } // c/b volume
@@ -976,7 +976,7 @@ namespace quda {
     constexpr bool parity_flip = true;
 
     for (int parity=0; parity<2; parity++) {
-#pragma omp parallel for
+#pragma omp parallel for schedule(runtime)
       for (int x_cb=0; x_cb<arg.fineVolumeCB; x_cb++) { // Loop over fine volume
 	for (int c_row=0; c_row<coarseColor; c_row++)
 	  for (int c_col=0; c_col<coarseColor; c_col++)
@@ -1090,7 +1090,7 @@ namespace quda {
   template<typename Float, int nSpin, int nColor, typename Arg>
   void ComputeYReverseCPU(Arg &arg) {
     for (int parity=0; parity<2; parity++) {
-#pragma omp parallel for
+#pragma omp parallel for schedule(runtime)
       for (int x_cb=0; x_cb<arg.coarseVolumeCB; x_cb++) {
 	for (int ic_c = 0; ic_c < nColor; ic_c++) { //Color row
 	  for (int jc_c = 0; jc_c < nColor; jc_c++) { //Color col
@@ -1180,7 +1180,7 @@ namespace quda {
   template <bool from_coarse, typename Float, int fineSpin, int coarseSpin, int fineColor, int coarseColor, typename Arg>
   void ComputeCoarseCloverCPU(Arg &arg) {
     for (int parity=0; parity<2; parity++) {
-#pragma omp parallel for
+#pragma omp parallel for schedule(runtime)
       for (int x_cb=0; x_cb<arg.fineVolumeCB; x_cb++) {
         for (int jc_c=0; jc_c<coarseColor; jc_c++) {
           for (int ic_c=0; ic_c<coarseColor; ic_c++) {
@@ -1212,7 +1212,7 @@ namespace quda {
   template<typename Float, int nSpin, int nColor, typename Arg>
   void AddCoarseDiagonalCPU(Arg &arg) {
     for (int parity=0; parity<2; parity++) {
-#pragma omp parallel for
+#pragma omp parallel for schedule(runtime)
       for (int x_cb=0; x_cb<arg.coarseVolumeCB; x_cb++) {
         for(int s = 0; s < nSpin; s++) { //Spin
          for(int c = 0; c < nColor; c++) { //Color
@@ -1245,7 +1245,7 @@ namespace quda {
     const complex<Float> mu(0., arg.mu*arg.mu_factor);
 
     for (int parity=0; parity<2; parity++) {
-#pragma omp parallel for
+#pragma omp parallel for schedule(runtime)
       for (int x_cb=0; x_cb<arg.coarseVolumeCB; x_cb++) {
 	for(int s = 0; s < nSpin/2; s++) { //Spin
           for(int c = 0; c < nColor; c++) { //Color
@@ -1325,7 +1325,7 @@ namespace quda {
   template<typename Float, int nSpin, int nColor, typename Arg>
   void ConvertCPU(Arg &arg) {
     for (int parity=0; parity<2; parity++) {
-#pragma omp parallel for
+#pragma omp parallel for schedule(runtime)
       for (int x_cb=0; x_cb<arg.coarseVolumeCB; x_cb++) {
 	for(int c_row = 0; c_row < nColor; c_row++) { //Color row
 	  for(int c_col = 0; c_col < nColor; c_col++) { //Color column
@@ -1373,7 +1373,7 @@ namespace quda {
   template<typename Float, int nSpin, int nColor, typename Arg>
   void RescaleYCPU(Arg &arg) {
     for (int parity=0; parity<2; parity++) {
-#pragma omp parallel for
+#pragma omp parallel for schedule(runtime)
       for (int x_cb=0; x_cb<arg.coarseVolumeCB; x_cb++) {
 	for(int c_row = 0; c_row < nColor; c_row++) { //Color row
 	  for(int c_col = 0; c_col < nColor; c_col++) { //Color column
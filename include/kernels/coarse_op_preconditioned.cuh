@@ -77,7 +77,7 @@ namespace quda {
 
     for (int d=0; d<4; d++) {
       for (int parity=0; parity<2; parity++) {
-#pragma omp parallel for
+#pragma omp parallel for schedule(runtime)
 	for (int x_cb=0; x_cb<arg.Y.VolumeCB(); x_cb++) {
 	  for (int i=0; i<n; i++)
             for (int j=0; j<n; j++)
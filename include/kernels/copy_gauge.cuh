@@ -25,30 +25,43 @@ namespace quda {
   };
 
   /**
-     Generic CPU gauge reordering and packing
+     Generic CPU gauge reordering and packing.  The checkerboard of
+     each parity and link direction is split into tiles of consecutive
+     sites that are distributed over the OpenMP threads, so each
+     thread streams through a contiguous range of the output.
+     @param[in] arg Kernel argument
+     @param[in] tile Number of consecutive sites assigned to each work item
   */
   template <typename FloatOut, typename FloatIn, int length, typename Arg>
-  void copyGauge(Arg &arg) {
+  void copyGauge(Arg &arg, int tile = 1) {
     typedef typename mapper<FloatIn>::type RegTypeIn;
     typedef typename mapper<FloatOut>::type RegTypeOut;
 
+    const int volumeCB = arg.volume/2;
+    const int n_tile = (volumeCB + tile - 1) / tile;
+    const int geometry = arg.geometry;
+
+#pragma omp parallel for collapse(3) schedule(runtime)
     for (int parity=0; parity<2; parity++) {
 
-      for (int d=0; d<arg.geometry; d++) {
-	for (int x=0; x<arg.volume/2; x++) {
+      for (int d=0; d<geometry; d++) {
+        for (int t=0; t<n_tile; t++) {
+          const int x_end = (t + 1) * tile < volumeCB ? (t + 1) * tile : volumeCB;
+          for (int x = t * tile; x < x_end; x++) {
 #ifdef FINE_GRAINED_ACCESS
-	  for (int i=0; i<Ncolor(length); i++)
-	    for (int j=0; j<Ncolor(length); j++) {
-	      arg.out(d, parity, x, i, j) = arg.in(d, parity, x, i, j);
-	    }
+            for (int i=0; i<Ncolor(length); i++)
+              for (int j=0; j<Ncolor(length); j++) {
+                arg.out(d, parity, x, i, j) = arg.in(d, parity, x, i, j);
+              }
 #else
-	  RegTypeIn in[length];
-	  RegTypeOut out[length];
-	  arg.in.load(in, x, d, parity);
-	  for (int i=0; i<length; i++) out[i] = in[i];
-	  arg.out.save(out, x, d, parity);
+            RegTypeIn in[length];
+            RegTypeOut out[length];
+            arg.in.load(in, x, d, parity);
+            for (int i=0; i<length; i++) out[i] = in[i];
+            arg.out.save(out, x, d, parity);
 #endif
-	}
+          }
+        }
       }
 
     }
@@ -118,28 +131,42 @@ namespace quda {
   }
 
   /**
-     Generic CPU gauge ghost reordering and packing
+     Generic CPU gauge ghost reordering and packing.  The ghost zones
+     are split into tiles of consecutive face sites that are
+     distributed over the OpenMP threads, with each work item covering
+     its tile in every dimension.
+     @param[in] arg Kernel argument
+     @param[in] tile Number of consecutive face sites assigned to each work item
   */
   template <typename FloatOut, typename FloatIn, int length, typename Arg>
-  void copyGhost(Arg &arg) {
+  void copyGhost(Arg &arg, int tile = 1) {
     typedef typename mapper<FloatIn>::type RegTypeIn;
     typedef typename mapper<FloatOut>::type RegTypeOut;
 
+    int faceMax = 0;
+    for (int d=0; d<arg.nDim; d++) faceMax = arg.faceVolumeCB[d] > faceMax ? arg.faceVolumeCB[d] : faceMax;
+    const int n_tile = (faceMax + tile - 1) / tile;
+    const int nDim = arg.nDim;
+
+#pragma omp parallel for collapse(2) schedule(runtime)
     for (int parity=0; parity<2; parity++) {
 
-      for (int d=0; d<arg.nDim; d++) {
-        for (int x=0; x<arg.faceVolumeCB[d]; x++) {
+      for (int t=0; t<n_tile; t++) {
+        for (int d=0; d<nDim; d++) {
+          const int x_end = (t + 1) * tile < arg.faceVolumeCB[d] ? (t + 1) * tile : arg.faceVolumeCB[d];
+          for (int x = t * tile; x < x_end; x++) {
 #ifdef FINE_GRAINED_ACCESS
-          for (int i=0; i<Ncolor(length); i++)
-            for (int j=0; j<Ncolor(length); j++)
-              arg.out.Ghost(d+arg.out_offset, parity, x, i, j) = arg.in.Ghost(d+arg.in_offset, parity, x, i, j);
+            for (int i=0; i<Ncolor(length); i++)
+              for (int j=0; j<Ncolor(length); j++)
+                arg.out.Ghost(d+arg.out_offset, parity, x, i, j) = arg.in.Ghost(d+arg.in_offset, parity, x, i, j);
 #else
-          RegTypeIn in[length];
-          RegTypeOut out[length];
-          arg.in.loadGhost(in, x, d+arg.in_offset, parity); // assumes we are loading
-          for (int i=0; i<length; i++) out[i] = in[i];
-          arg.out.saveGhost(out, x, d+arg.out_offset, parity);
+            RegTypeIn in[length];
+            RegTypeOut out[length];
+            arg.in.loadGhost(in, x, d+arg.in_offset, parity); // assumes we are loading
+            for (int i=0; i<length; i++) out[i] = in[i];
+            arg.out.saveGhost(out, x, d+arg.out_offset, parity);
 #endif
+          }
         }
       }
 
@@ -370,9 +370,18 @@ namespace quda {
 
   }
 
-  // CPU kernel for applying the coarse Dslash to a vector
+  /**
+     CPU kernel for applying the coarse Dslash to a vector.  The
+     checkerboard of each parity is split into tiles of consecutive
+     sites that are distributed over the OpenMP threads.  Within a
+     tile every source is applied at a site before moving to the
+     next, so the links Y(x) and X(x) are reused from cache across
+     the right-hand sides of a multi-source field.
+     @param[in] arg Kernel argument
+     @param[in] tile Number of consecutive sites assigned to each work item
+  */
   template <typename Float, int nDim, int Ns, int Nc, int Mc, bool dslash, bool clover, bool dagger, DslashType type, typename Arg>
-  void coarseDslash(Arg arg)
+  void coarseDslash(Arg arg, int tile = 1)
   {
     // the fine-grain parameters mean nothing for CPU variant
     const int color_stride = 1;
@@ -381,20 +390,25 @@ namespace quda {
     const int dir = 0;
     const int dim = 0;
 
-    for (int parity= 0; parity < arg.nParity; parity++) {
-      // for full fields then set parity from loop else use arg setting
-      parity = (arg.nParity == 2) ? parity : arg.parity;
-
-      for (int src_idx = 0; src_idx < arg.dim[4]; src_idx++) {
-	//#pragma omp parallel for
-	for(int x_cb = 0; x_cb < arg.volumeCB; x_cb++) { // 4-d volume
-	  for (int s=0; s<2; s++) {
-	    for (int color_block=0; color_block<Nc; color_block+=Mc) { // Mc=Nc means all colors in a thread
-	      coarseDslash<Float,nDim,Ns,Nc,Mc,color_stride,dim_thread_split,dslash,clover,dagger,type,dir,dim>(arg, x_cb, src_idx, parity, s, color_block, color_offset);
-	    }
-	  }
-	} // 4-d volumeCB
-      } // src index
+    const int n_tile = (arg.volumeCB + tile - 1) / tile;
+
+#pragma omp parallel for collapse(2) schedule(runtime)
+    for (int p = 0; p < arg.nParity; p++) {
+      for (int t = 0; t < n_tile; t++) {
+        // for full fields then set parity from loop else use arg setting
+        const int parity = (arg.nParity == 2) ? p : arg.parity;
+        const int x_end = (t + 1) * tile < arg.volumeCB ? (t + 1) * tile : arg.volumeCB;
+
+        for (int x_cb = t * tile; x_cb < x_end; x_cb++) { // 4-d volume
+          for (int src_idx = 0; src_idx < arg.dim[4]; src_idx++) {
+            for (int s=0; s<2; s++) {
+              for (int color_block=0; color_block<Nc; color_block+=Mc) { // Mc=Nc means all colors in a thread
+                coarseDslash<Float,nDim,Ns,Nc,Mc,color_stride,dim_thread_split,dslash,clover,dagger,type,dir,dim>(arg, x_cb, src_idx, parity, s, color_block, color_offset);
+              }
+            }
+          } // src index
+        } // 4-d volumeCB
+      } // tile
     } // parity
 
   }
@@ -29,7 +29,7 @@ namespace quda {
   };
 
   template<typename Float, typename Arg>
-  __device__ inline double plaquette(Arg &arg, int x[], int parity, int mu, int nu) {
+  __host__ __device__ inline double plaquette(Arg &arg, int x[], int parity, int mu, int nu) {
     typedef Matrix<complex<Float>,3> Link;
 
     int dx[4] = {0, 0, 0, 0};
@@ -45,6 +45,28 @@ namespace quda {
     return getTrace( U1 * U2 * conj(U3) * conj(U4) ).x;
   }
 
+  /**
+     Spatial (x) and temporal (y) plaquette sums at one site
+  */
+  template<typename Float, typename Arg>
+  __host__ __device__ inline double2 plaquetteSite(Arg &arg, int idx, int parity) {
+    double2 plaq = make_double2(0.0,0.0);
+
+    int x[4];
+    getCoords(x, idx, arg.X, parity);
+    for (int dr=0; dr<4; ++dr) x[dr] += arg.border[dr]; // extended grid coordinates
+
+    for (int mu = 0; mu < 3; mu++) {
+      for (int nu = (mu+1); nu < 3; nu++) {
+        plaq.x += plaquette<Float>(arg, x, parity, mu, nu);
+      }
+
+      plaq.y += plaquette<Float>(arg, x, parity, mu, 3);
+    }
+
+    return plaq;
+  }
+
   template<int blockSize, typename Float, typename Gauge>
   __global__ void computePlaq(GaugePlaqArg<Gauge> arg){
     int idx = threadIdx.x + blockIdx.x*blockDim.x;
@@ -53,18 +75,7 @@ namespace quda {
     double2 plaq = make_double2(0.0,0.0);
 
     while (idx < arg.threads) {
-      int x[4];
-      getCoords(x, idx, arg.X, parity);
-      for (int dr=0; dr<4; ++dr) x[dr] += arg.border[dr]; // extended grid coordinates
-
-      for (int mu = 0; mu < 3; mu++) {
-	for (int nu = (mu+1); nu < 3; nu++) {
-	  plaq.x += plaquette<Float>(arg, x, parity, mu, nu);
-	}
-
-	plaq.y += plaquette<Float>(arg, x, parity, mu, 3);
-      }
-
+      plaq += plaquetteSite<Float>(arg, idx, parity);
       idx += blockDim.x*gridDim.x;
     }
 
@@ -6,6 +6,8 @@
 
 namespace quda {
 
+  class TuneParam;
+
   void printPeakMemUsage();
   void assertAllMemFree();
 
@@ -50,6 +52,65 @@ namespace quda {
 
   QudaFieldLocation get_pointer_location(const void *ptr);
 
+  /**
+     @brief Zero a host field, distributing the memory over the OpenMP
+     threads the way the host reorder kernels (copyGauge and
+     copyColorSpinor) distribute their work items.  The field is a set
+     of rows, e.g., the parities of each link direction, each a
+     contiguous range of row_bytes that holds row_items sites.  The
+     rows are split into tiles of sites that are zeroed in a
+     schedule(runtime) loop, using the thread count, chunk and tile of
+     the last host reorder kernel launched (see host_touch_param()).
+     On NUMA systems each page is then first touched, and so placed,
+     near the thread that later reorders it.
+     @param[in] row Pointers to the rows, in the order the kernels visit them
+     @param[in] n_row Number of rows
+     @param[in] row_bytes Number of bytes in each row
+     @param[in] row_items Number of sites in each row
+   */
+  void host_zero(void *const *row, int n_row, size_t row_bytes, size_t row_items);
+
+  /**
+     @brief Record the launch parameters of a host reorder kernel for
+     host_zero() to follow when first touching new host fields
+     @param[in] param Host launch parameters (threads, chunk and tile)
+   */
+  void host_touch_param(const TuneParam &param);
+
+  /**
+     @brief Allocate a short-lived host temporary.  While a
+     HostArenaScope is open the memory is bump allocated from the host
+     arena and is released when the innermost scope closes, with
+     host_free() a no-op on it; otherwise this is safe_malloc().  This
+     should only be called via the arena_malloc() macro.
+  */
+  void *arena_malloc_(const char *func, const char *file, int line, size_t size);
+
+  /**
+     @brief Release the chunks held by the calling thread's host arena
+     (called by endQuda); other threads release theirs on exit
+  */
+  void flush_host_arena();
+
+  /**
+     @brief RAII scope of the host arena, opened for the duration of
+     an interface call such as invertQuda.  All arena_malloc()
+     allocations made while it is open are released in one shot when
+     it is destroyed.  Scopes nest, and with QUDA_DEBUG_VERBOSE each
+     scope reports its allocation count and bytes when it closes.
+     Every thread has its own arena, so a scope only releases the
+     allocations made on the thread that opened it.
+  */
+  class HostArenaScope {
+    const char *name;
+    size_t chunk, offset, used, count, bytes; // arena position when opened
+  public:
+    HostArenaScope(const char *name);
+    ~HostArenaScope();
+    HostArenaScope(const HostArenaScope &) = delete;
+    HostArenaScope &operator=(const HostArenaScope &) = delete;
+  };
+
 } // namespace quda
 
 #define device_malloc(size) quda::device_malloc_(__func__, quda::file_name(__FILE__), __LINE__, size)
@@ -60,6 +121,7 @@ namespace quda {
 #define device_free(ptr) quda::device_free_(__func__, quda::file_name(__FILE__), __LINE__, ptr)
 #define device_pinned_free(ptr) quda::device_pinned_free_(__func__, quda::file_name(__FILE__), __LINE__, ptr)
 #define host_free(ptr) quda::host_free_(__func__, quda::file_name(__FILE__), __LINE__, ptr)
+#define arena_malloc(size) quda::arena_malloc_(__func__, quda::file_name(__FILE__), __LINE__, size)
 
 
 namespace quda {
@@ -100,15 +162,23 @@ namespace quda {
     void pinned_free_(const char *func, const char *file, int line, void *ptr);
 
     /**
-       @brief Free all outstanding device-memory allocations.
+       @brief Return all device-memory slabs without active
+       allocations to the device.
     */
     void flush_device();
 
     /**
-       @brief Free all outstanding pinned-memory allocations.
+       @brief Return all pinned-memory slabs without active
+       allocations to the host.
     */
     void flush_pinned();
 
+    /**
+       @brief Print the high-water marks, slack and fragmentation of
+       the memory pools (called by printPeakMemUsage).
+    */
+    void print_stats();
+
   } // namespace pool
 
 }
@@ -270,7 +270,7 @@ namespace quda {
     /** Wrapper for the sloppy smoothing coarse grid operator */
     DiracMatrix *matCoarseSmootherSloppy;
 
-    /** Parallel hyper-cubic random number generator for generating null-space vectors */
+    /** Counter-based random number generator for generating null-space vectors */
     RNG *rng;
 
     /**
@@ -14,13 +14,25 @@ namespace quda {
   /** @brief Perform heatbath and overrelaxation. Performs nhb heatbath steps followed by nover overrelaxation steps.
    *
    * @param[in,out] data Gauge field
-   * @param[in,out] rngstate state of the CURAND random number generator
+   * @param[in,out] rngstate random number generator, advanced by nhb
    * @param[in] Beta inverse of the gauge coupling, beta = 2 Nc / g_0^2
    * @param[in] nhb number of heatbath steps
    * @param[in] nover number of overrelaxation steps
    */
   void Monte( cudaGaugeField& data, RNG &rngstate, double Beta, int nhb, int nover);
 
+  /** @brief Perform heatbath and overrelaxation on a host field, threaded over the links of each parity and
+   * direction. The heatbath draws from the same counter-based streams as the device variant, so the result
+   * is independent of the number of threads and of the process grid.
+   *
+   * @param[in,out] data Gauge field in QDP or MILC order, extended in the partitioned dimensions
+   * @param[in,out] rngstate random number generator, advanced by nhb
+   * @param[in] Beta inverse of the gauge coupling, beta = 2 Nc / g_0^2
+   * @param[in] nhb number of heatbath steps
+   * @param[in] nover number of overrelaxation steps
+   */
+  void Monte( cpuGaugeField& data, RNG &rngstate, double Beta, int nhb, int nover);
+
   /** @brief Perform a cold start to the gauge field, identity SU(3) matrix, also fills the ghost links in multi-GPU case (no need to exchange data)
    *
    * @param[in,out] data Gauge field
@@ -30,7 +42,7 @@ namespace quda {
   /** @brief Perform a hot start to the gauge field, random SU(3) matrix, followed by reunitarization, also exchange borders links in multi-GPU case.
    *
    * @param[in,out] data Gauge field
-   * @param[in,out] rngstate state of the CURAND random number generator
+   * @param[in,out] rngstate random number generator, advanced by the call
    */
   void InitGaugeField( cudaGaugeField& data, RNG &rngstate);
 
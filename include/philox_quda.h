@@ -0,0 +1,121 @@
+#pragma once
+
+/**
+   @file philox_quda.h
+
+   @brief Counter-based Philox4x32-10 random number generator (Salmon
+   et al., "Parallel random numbers: as easy as 1, 2, 3", SC11).  A
+   Philox stream is a pure function of a 64-bit key and a 128-bit
+   counter, so there is no generator state to store per site: a
+   PhiloxState is set up on the fly from (seed, subsequence, offset)
+   by whichever thread needs it, and draws the same numbers
+   regardless of how the work was distributed over threads or
+   processes.
+*/
+
+namespace quda {
+
+  /**
+     @brief Thread-local Philox stream.  The key holds the seed, the
+     counter holds (draw, offset, subsequence), and out buffers the
+     four words produced by the last call to the Philox bijection.
+  */
+  struct PhiloxState {
+    unsigned int key[2];
+    unsigned int ctr[4];
+    unsigned int out[4];
+    int n; // number of unused words left in out
+  };
+
+  /**
+     @brief The Philox4x32 bijection with the recommended ten rounds
+     @param[out] out Four random words
+     @param[in] ctr Counter
+     @param[in] key Key
+  */
+  __host__ __device__ inline void philox4x32(unsigned int out[4], const unsigned int ctr[4], const unsigned int key[2])
+  {
+    unsigned int c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+    unsigned int k0 = key[0], k1 = key[1];
+
+#pragma unroll
+    for (int r=0; r<10; r++) {
+      const unsigned long long p0 = 0xD2511F53ull * c0;
+      const unsigned long long p1 = 0xCD9E8D57ull * c2;
+      c0 = static_cast<unsigned int>(p1 >> 32) ^ c1 ^ k0;
+      c2 = static_cast<unsigned int>(p0 >> 32) ^ c3 ^ k1;
+      c1 = static_cast<unsigned int>(p1);
+      c3 = static_cast<unsigned int>(p0);
+      k0 += 0x9E3779B9u;
+      k1 += 0xBB67AE85u;
+    }
+
+    out[0] = c0; out[1] = c1; out[2] = c2; out[3] = c3;
+  }
+
+  /**
+     @brief Set up a Philox stream, following the curand_init
+     convention: streams with different subsequences are independent,
+     and the offset selects a disjoint block of 2^32 draws within a
+     subsequence (e.g., one block per Monte Carlo sweep).
+     @param[out] state The stream
+     @param[in] seed Generator seed
+     @param[in] subsequence Subsequence (e.g., a global link index)
+     @param[in] offset Block of draws within the subsequence
+  */
+  __host__ __device__ inline void philoxInit(PhiloxState &state, unsigned long long seed,
+                                             unsigned long long subsequence, unsigned int offset)
+  {
+    state.key[0] = static_cast<unsigned int>(seed);
+    state.key[1] = static_cast<unsigned int>(seed >> 32);
+    state.ctr[0] = 0;
+    state.ctr[1] = offset;
+    state.ctr[2] = static_cast<unsigned int>(subsequence);
+    state.ctr[3] = static_cast<unsigned int>(subsequence >> 32);
+    state.n = 0;
+  }
+
+  /**
+     @brief Return the next 32-bit word of a Philox stream
+  */
+  __host__ __device__ inline unsigned int philoxNext(PhiloxState &state)
+  {
+    if (state.n == 0) {
+      philox4x32(state.out, state.ctr, state.key);
+      state.ctr[0]++;
+      state.n = 4;
+    }
+    return state.out[4 - state.n--];
+  }
+
+  /**
+     @brief Return a uniform random number in (0,1], matching the
+     range of curand_uniform
+     @param state Philox stream
+  */
+  template<class Real> __host__ __device__ inline Real Random(PhiloxState &state);
+
+  template<> __host__ __device__ inline float Random<float>(PhiloxState &state)
+  {
+    return (philoxNext(state) + 1.0f) * 2.3283064365386963e-10f; // 2^-32
+  }
+
+  template<> __host__ __device__ inline double Random<double>(PhiloxState &state)
+  {
+    const unsigned long long hi = philoxNext(state) >> 6; // 26 bits
+    const unsigned long long lo = philoxNext(state) >> 5; // 27 bits
+    return ((hi << 27 | lo) + 1.0) * 1.1102230246251565e-16; // 2^-53
+  }
+
+  /**
+     @brief Return a uniform random number between a and b
+     @param state Philox stream
+     @param a lower range
+     @param b upper range
+  */
+  template<class Real> __host__ __device__ inline Real Random(PhiloxState &state, Real a, Real b)
+  {
+    return a + (b - a) * Random<Real>(state);
+  }
+
+} // namespace quda
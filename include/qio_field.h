@@ -1,6 +1,8 @@
 #ifndef _GAUGE_QIO_H
 #define _GAUGE_QIO_H
 
+#include <field_io.h>
+
 #ifdef HAVE_QIO
 void read_gauge_field(const char *filename, void *gauge[], QudaPrecision prec, const int *X,
 		      int argc, char *argv[]);
@@ -11,25 +13,23 @@ void read_spinor_field(const char *filename, void *V[], QudaPrecision precision,
 void write_spinor_field(const char *filename, void *V[], QudaPrecision precision, const int *X,
 			int nColor, int nSpin, int Nvec, int argc, char *argv[]);
 #else
+// without QIO all fields are read and written in the native format
 inline void read_gauge_field(const char *filename, void *gauge[], QudaPrecision prec,
 		      const int *X, int argc, char *argv[]) {
-  printf("QIO support has not been enabled\n");
-  exit(-1);
+  quda::read_gauge_field_native(filename, gauge, prec, X);
 }
 inline void write_gauge_field(const char *filename, void *gauge[], QudaPrecision prec,
 		      const int *X, int argc, char *argv[]) {
-  printf("QIO support has not been enabled\n");
-  exit(-1);
+  quda::write_gauge_field_native(filename, gauge, prec, X, quda::native_field_io_precision(prec, false));
 }
 inline void read_spinor_field(const char *filename, void *V[], QudaPrecision precision, const int *X,
 			int nColor, int nSpin, int Nvec, int argc, char *argv[]) {
-  printf("QIO support has not been enabled\n");
-  exit(-1);
+  quda::read_spinor_field_native(filename, V, precision, X, nColor, nSpin, Nvec);
 }
 inline void write_spinor_field(const char *filename, void *V[], QudaPrecision precision, const int *X,
 			       int nColor, int nSpin, int Nvec, int argc, char *argv[]) {
-  printf("QIO support has not been enabled\n");
-  exit(-1);
+  quda::write_spinor_field_native(filename, V, precision, X, nColor, nSpin, Nvec,
+				  quda::native_field_io_precision(precision, true));
 }
 
 #endif
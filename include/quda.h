@@ -1150,6 +1150,21 @@ extern "C" {
    */
   void performOvrImpSTOUTnStep(unsigned int nSteps, double rho, double epsilon);
 
+  /**
+   * Performs the gradient flow on gaugePrecise and stores it in gaugeSmeared.
+   * The energy density E(t), t^2 E(t) and the topological charge Q(t) are
+   * measured on the resident field, without copies, every meas_interval steps.
+   * @param nSteps        Number of steps to apply.
+   * @param step_size     Flow-time step size epsilon.
+   * @param meas_interval Measure every meas_interval steps, never if zero.
+   * @param wflow_type    Wilson or tree-level Symanzik flow.
+   * @param obs           If non-null, filled with (t, E, t^2 E, Q) for each
+   *                      measurement, i.e., 4*(nSteps/meas_interval+1) doubles.
+   *                      E uses the clover definition of the field strength.
+   */
+  void performWFlownStep(unsigned int nSteps, double step_size, unsigned int meas_interval,
+                         QudaWFlowType wflow_type, double *obs);
+
   /**
    * Calculates the topological charge from gaugeSmeared, if it exist, or from gaugePrecise if no smeared fields are present.
    */
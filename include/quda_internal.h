@@ -10,8 +10,8 @@
 #error "MULTI_GPU must be enabled to use MPI or QMP"
 #endif
 
-#if (!defined(QMP_COMMS) && !defined(MPI_COMMS) && defined(MULTI_GPU))
-#error "MPI or QMP must be enabled to use MULTI_GPU"
+#if (!defined(QMP_COMMS) && !defined(MPI_COMMS) && !defined(THREADS_COMMS) && defined(MULTI_GPU))
+#error "MPI, QMP or threaded comms must be enabled to use MULTI_GPU"
 #endif
 
 #ifdef QMP_COMMS
@@ -3,138 +3,89 @@
 #ifdef __CUDACC_RTC__
 #define RNG int
 #else
-#include <curand_kernel.h>
+#include <philox_quda.h>
 
 namespace quda {
 
-#if defined(XORWOW)
-typedef struct curandStateXORWOW cuRNGState;
-#elif defined(MRG32k3a)
-typedef struct curandStateMRG32k3a cuRNGState;
-#else
-typedef struct curandStateMRG32k3a cuRNGState;
-#endif
-
 /**
-   @brief Class declaration to initialize and hold CURAND RNG states
+   @brief Counter-based random number generator shared by host and
+   device fields.  Rather than holding a per-site generator state, an
+   RNG is just a seed, a generation counter and the geometry needed to
+   map a local site to its global lexicographical index.  Each thread
+   sets up a Philox stream keyed on (seed, global site, stream index)
+   with the generation as offset, so the numbers drawn for a site do
+   not depend on the process grid, the thread count or the launch
+   configuration, and there is no state to back up while autotuning.
+   After each fill the owner calls advance() so that the next fill
+   draws fresh numbers.
 */
 class RNG {
 public:
-    RNG(int rng_sizes, int seedin, const int XX[4]);
-    /*! free array */
-    void Release();
-    /*! initialize curand rng states with seed */
-    void Init();
-    /*! @brief return curand rng array size */
-    int Size(){ return rng_size;};
-    int Node_Offset(){ return node_offset;};
-    int Seed(){ return seed;};
-    __host__ __device__ __inline__ cuRNGState* State(){ return state;};
-    /*! @brief Restore CURAND array states initialization */
-    void restore();
-    /*! @brief Backup CURAND array states initialization */
-    void backup();
-private:
-    /*! array with current curand rng state */
-    cuRNGState *state;
-    /*! array for backup of current curand rng state */
-    cuRNGState *backup_state;
-    /*! initial rng seed */
-    int seed;
-    /*! @brief number of curand states */
-    int rng_size;
-    /*! @brief offset in the index, in case of multigpus */
-    int node_offset;
-    int X[4];
-    /*! @brief allocate curand rng states array in device memory */
-    void AllocateRNG();
-    /*! @brief CURAND array states initialization */
-    void INITRNG(int rng_sizes, int seedin, int offsetin);
-};
-
-
-/**
-   @brief Return a random number between a and b
-   @param state curand rng state
-   @param a lower range
-   @param b upper range
-   @return  random number in range a,b
-*/
-template<class Real>
-inline  __device__ Real Random(cuRNGState &state, Real a, Real b){
-    Real res;
-    return res;
-}
-
-template<>
-inline  __device__ float Random<float>(cuRNGState &state, float a, float b){
-    return a + (b - a) * curand_uniform(&state);
-}
-
-template<>
-inline  __device__ double Random<double>(cuRNGState &state, double a, double b){
-    return a + (b - a) * curand_uniform_double(&state);
-}
-
-/**
-   @brief Return a random number between 0 and 1
-   @param state curand rng state
-   @return  random number in range 0,1
-*/
-template<class Real>
-inline  __device__ Real Random(cuRNGState &state){
-    Real res;
-    return res;
-}
-
-template<>
-inline  __device__ float Random<float>(cuRNGState &state){
-    return curand_uniform(&state);
-}
-
-template<>
-inline  __device__ double Random<double>(cuRNGState &state){
-    return curand_uniform_double(&state);
-}
-
-
-template<class Real>
-struct uniform { };
-template<>
-struct uniform<float> {
-    __device__
-        static inline float rand(cuRNGState &state) {
-        return curand_uniform(&state);
+    /**
+       @brief Create a generator for a lattice
+       @param seedin Generator seed
+       @param XX Local (non-extended) four-dimensional lattice dimensions
+    */
+    RNG(unsigned long long seedin, const int XX[4]);
+    unsigned long long Seed() const { return seed; }
+    /*! @brief return the generation counter, the number of fills done so far */
+    unsigned int Offset() const { return offset; }
+    /*! @brief move on to the next generation, call after each fill */
+    void advance(unsigned int n=1) { offset += n; }
+
+    /**
+       @brief Global lexicographical index of a local site
+       @param x Local (non-extended) coordinates of the site
+    */
+    __host__ __device__ inline long long globalIndex(const int x[4]) const {
+      long long g = 0;
+      for (int d=3; d>=0; d--) g = g * globalX[d] + x[d] + commCoord[d] * X[d];
+      return g;
     }
-};
-template<>
-struct uniform<double> {
-    __device__
-        static inline double rand(cuRNGState &state) {
-        return curand_uniform_double(&state);
+
+    /**
+       @brief Return the Philox stream of a site for the current generation
+       @param x Local (non-extended) coordinates of the site
+       @param stream Index of the stream within the site (e.g., link direction)
+       @param n_stream Number of streams per site
+    */
+    __host__ __device__ inline PhiloxState State(const int x[4], int stream=0, int n_stream=1) const {
+      PhiloxState state;
+      philoxInit(state, seed, globalIndex(x) * n_stream + stream, offset);
+      return state;
     }
-};
 
+    /**
+       @brief Return the Philox stream of a site for the current generation
+       @param x_cb Local checkerboard index of the site
+       @param parity Parity of the site
+       @param stream Index of the stream within the site
+       @param n_stream Number of streams per site
+    */
+    __host__ __device__ inline PhiloxState State(int x_cb, int parity, int stream=0, int n_stream=1) const {
+      int x[4];
+      int za = x_cb / (X[0] >> 1);
+      int zb = za / X[1];
+      x[1] = za - zb * X[1];
+      x[3] = zb / X[2];
+      x[2] = zb - x[3] * X[2];
+      x[0] = 2 * (x_cb - za * (X[0] >> 1)) + ((x[1] + x[2] + x[3] + parity) & 1);
+      return State(x, stream, n_stream);
+    }
 
+    /*! @brief local checkerboard volume the generator was created for */
+    int VolumeCB() const { return X[0] * X[1] * X[2] * X[3] / 2; }
 
-template<class Real>
-struct normal { };
-template<>
-struct normal<float> {
-    __device__
-        static inline float rand(cuRNGState &state) {
-        return curand_normal(&state);
-    }
-};
-template<>
-struct normal<double> {
-    __device__
-        static inline double rand(cuRNGState &state) {
-        return curand_normal_double(&state);
-    }
+private:
+    /*! initial rng seed */
+    unsigned long long seed;
+    /*! @brief number of fills done so far, used as the Philox offset */
+    unsigned int offset;
+    int X[4];
+    int globalX[4];
+    int commCoord[4];
 };
 
-
 }
 
 #endif
@@ -23,6 +23,8 @@ namespace quda {
 #else
 
 #include <sys/time.h>
+#include <time.h>
+#include <stdint.h>
 
 #ifdef INTERFACE_NVTX
 #include "nvToolsExt.h"
@@ -30,23 +32,57 @@ namespace quda {
 
 namespace quda {
 
+  /**
+     @return Nanoseconds on the monotonic raw clock, which is not
+     subject to NTP slewing.  On Linux this is read through the vDSO, so
+     it costs a few tens of nanoseconds and no system call.
+  */
+  inline uint64_t timerNanoseconds()
+  {
+    timespec ts;
+#ifdef CLOCK_MONOTONIC_RAW
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+#else
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + ts.tv_nsec;
+  }
+
   /**
    * Use this for recording a fine-grained profile of a QUDA
    * algorithm.  This uses host-side measurement, so should be used
    * for timing fully host-device synchronous algorithms.
    */
   struct Timer {
+    /**< Intervals are binned into a log histogram with four bins per octave */
+    static const int bins_per_octave = 4;
+
+    /**< Octaves covered by the histogram, starting at 16 ns */
+    static const int min_octave = 4;
+    static const int n_octave = 33;
+    static const int n_bin = n_octave * bins_per_octave + 2;
+
     /**< The cumulative sum of time */
     double time;
 
     /**< The last recorded time interval */
     double last;
 
+    /**< The cumulative sum of time in nanoseconds */
+    uint64_t total_ns;
+
     /**< Used to store when the timer was last started */
-    timeval start;
+    uint64_t start;
 
     /**< Used to store when the timer was last stopped */
-    timeval stop;
+    uint64_t stop;
+
+    /**< Shortest and longest recorded interval in nanoseconds */
+    uint64_t min_ns;
+    uint64_t max_ns;
+
+    /**< Histogram of the recorded intervals, used for percentiles */
+    uint32_t histogram[n_bin];
 
     /**< Are we currently timing? */
     bool running;
@@ -54,14 +90,14 @@ namespace quda {
     /**< Keep track of number of calls */
     int count;
 
-  Timer() : time(0.0), last(0.0), running(false), count(0) { ; } 
+  Timer() : time(0.0), last(0.0), total_ns(0), start(0), stop(0), min_ns(UINT64_MAX), max_ns(0), histogram(), running(false), count(0) { ; }
 
     void Start(const char *func, const char *file, int line) {
       if (running) {
 	printfQuda("ERROR: Cannot start an already running timer (%s:%d in %s())\n", file, line, func);
 	errorQuda("Aborting");
       }
-      gettimeofday(&start, NULL);
+      start = timerNanoseconds();
       running = true;
     }
 
@@ -70,12 +106,15 @@ namespace quda {
 	printfQuda("ERROR: Cannot stop an unstarted timer (%s:%d in %s())\n", file, line, func);
 	errorQuda("Aborting");
       }
-      gettimeofday(&stop, NULL);
-
-      long ds = stop.tv_sec - start.tv_sec;
-      long dus = stop.tv_usec - start.tv_usec;
-      last = ds + 0.000001*dus;
-      time += last;
+      stop = timerNanoseconds();
+
+      const uint64_t ns = stop - start;
+      total_ns += ns;
+      last = 1e-9 * ns;
+      time = 1e-9 * total_ns;
+      if (ns < min_ns) min_ns = ns;
+      if (ns > max_ns) max_ns = ns;
+      histogram[bin(ns)]++;
       count++;
 
       running = false;
@@ -83,6 +122,16 @@ namespace quda {
 
     double Last() { return last; }
 
+    /**
+       @return The exact shortest recorded interval in seconds
+    */
+    double Min() const { return count ? 1e-9 * min_ns : 0.0; }
+
+    /**
+       @return The exact longest recorded interval in seconds
+    */
+    double Max() const { return 1e-9 * max_ns; }
+
     void Reset(const char *func, const char *file, int line) {
       if (running) {
 	printfQuda("ERROR: Cannot reset a started timer (%s:%d in %s())\n", file, line, func);
@@ -90,9 +139,39 @@ namespace quda {
       }
       time = 0.0;
       last = 0.0;
+      total_ns = 0;
+      min_ns = UINT64_MAX;
+      max_ns = 0;
+      for (int i = 0; i < n_bin; i++) histogram[i] = 0;
       count = 0;
     }
 
+    /**
+       @return Histogram bin of an interval: bin 0 collects everything
+       below 2^min_octave ns, the last bin everything beyond the range
+    */
+    static int bin(uint64_t ns) {
+      if (ns < (1ull << min_octave)) return 0;
+      int octave = 63 - __builtin_clzll(ns);
+      if (octave >= min_octave + n_octave) return n_bin - 1;
+      // the two bits below the leading one select the bin within the octave
+      int sub = static_cast<int>((ns >> (octave - 2)) & 3);
+      return 1 + (octave - min_octave) * bins_per_octave + sub;
+    }
+
+    /**
+       @return Estimate of the q-quantile (0 <= q <= 1) of the recorded
+       intervals in seconds, accurate to the histogram bin width (about
+       19%) and clamped to the exact minimum and maximum, which are
+       returned as they are for q = 0 and q = 1
+    */
+    double Percentile(double q) const;
+
+    /**
+       @return The cost in seconds of one Start/Stop pair, measured once
+       on first use
+    */
+    static double Overhead();
   };
 
   /**< Enumeration type used for writing a simple but extensible profiling framework. */
@@ -163,6 +242,15 @@ namespace quda {
 #define POP_RANGE
 #endif
 
+  /**
+     @brief Hooks used by TimeProfile to place its regions on the
+     trace timeline.  These only record when QUDA_ENABLE_TRACE is set
+     (see tune.cpp).
+  */
+  int traceEnabled();
+  void traceRegionBegin_(const std::string &profile, const std::string &region);
+  void traceRegionEnd_(const std::string &profile, const std::string &region, double seconds);
+
   class TimeProfile {
     std::string fname;  /**< Which function are we profiling */
 #ifdef INTERFACE_NVTX
@@ -223,12 +311,14 @@ namespace quda {
       profile[idx].Start(func, file, line); 
       PUSH_RANGE(fname.c_str(),idx)
 	if (use_global) StartGlobal(func,file,line,idx);
+      if (traceEnabled()) traceRegionBegin_(fname, pname[idx]);
     }
 
 
     void Stop_(const char *func, const char *file, int line, QudaProfileType idx) {
       profile[idx].Stop(func, file, line); 
       POP_RANGE
+      if (traceEnabled()) traceRegionEnd_(fname, pname[idx], profile[idx].last);
 
       // switch off total timer if we need to
       if (switchOff && idx != QUDA_PROFILE_TOTAL) {
@@ -2,6 +2,8 @@
 #define _TUNE_KEY_H
 
 #include <cstring>
+#include <cstdint>
+#include <cstddef>
 
 namespace quda {
 
@@ -35,6 +37,42 @@ namespace quda {
       return *this;
     }
 
+    /**
+       @brief 64-bit hash of the volume, name and aux strings.  Callers
+       append to the strings after construction (e.g., strcat onto
+       aux), so the hash is computed from the current strings on every
+       call rather than cached.
+    */
+    std::uint64_t hash() const {
+      std::uint64_t h = hashString(hashString(hashString(0, volume), name), aux);
+      // final avalanche
+      h ^= h >> 33; h *= 0xff51afd7ed558ccdull; h ^= h >> 33; h *= 0xc4ceb9fe1a85ec53ull; h ^= h >> 33;
+      return h;
+    }
+
+  private:
+    /** multiply-xorshift mixing of a string eight bytes at a time */
+    static std::uint64_t hashString(std::uint64_t h, const char *str) {
+      const std::uint64_t k = 0x9e3779b97f4a7c15ull;
+      const std::size_t n = std::strlen(str);
+      std::size_t i = 0;
+      for (; i + 8 <= n; i += 8) {
+        std::uint64_t w;
+        std::memcpy(&w, str + i, 8);
+        h = (h ^ w) * k; h ^= h >> 29;
+      }
+      std::uint64_t w = static_cast<std::uint64_t>(n) << 56; // length terminates each field
+      std::memcpy(&w, str + i, n - i);
+      h = (h ^ w) * k; h ^= h >> 29;
+      return h;
+    }
+
+  public:
+    bool operator==(const TuneKey &other) const {
+      return std::strcmp(volume, other.volume) == 0 && std::strcmp(name, other.name) == 0 &&
+        std::strcmp(aux, other.aux) == 0;
+    }
+
     bool operator<(const TuneKey &other) const {
       int vc = std::strcmp(volume, other.volume);
       if (vc < 0) {
@@ -52,6 +90,11 @@ namespace quda {
   
   };
 
+  /** hash functor for using TuneKey in unordered containers */
+  struct TuneKeyHash {
+    std::size_t operator()(const TuneKey &key) const { return static_cast<std::size_t>(key.hash()); }
+  };
+
 }
 
 /** Return the key of the last kernel that has been tuned / called.*/
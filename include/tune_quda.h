@@ -7,12 +7,25 @@
 #include <cstring>
 #include <cfloat>
 #include <stdarg.h>
+#include <unordered_map>
 
 #include <tune_key.h>
 #include <quda_internal.h>
 
 namespace quda {
 
+  /**
+     @return The number of OpenMP threads available to host kernels
+     (one if QUDA was built without OpenMP)
+  */
+  int hostThreads();
+
+  /**
+     For host kernels (see Tunable::hostKernel) the launch parameters
+     are held in the block dimensions: block.x is the number of OpenMP
+     threads, block.y the dynamic schedule chunk size (zero for the
+     default static schedule) and block.z the site-blocking tile.
+   */
   class TuneParam {
 
   public:
@@ -25,12 +38,18 @@ namespace quda {
     float time;
     long long n_calls;
 
-    inline TuneParam() : block(32, 1, 1), grid(1, 1, 1), shared_bytes(0), aux(), time(FLT_MAX), n_calls(0) {
+    // work per launch and where it runs, recorded for the profile and roofline
+    long long flops;
+    long long bytes;
+    bool host;
+
+    inline TuneParam() : block(32, 1, 1), grid(1, 1, 1), shared_bytes(0), aux(), time(FLT_MAX), n_calls(0), flops(0), bytes(0), host(false) {
       aux = make_int4(1,1,1,1);
     }
 
     inline TuneParam(const TuneParam &param)
-      : block(param.block), grid(param.grid), shared_bytes(param.shared_bytes), aux(param.aux), comment(param.comment), time(param.time), n_calls(param.n_calls) { }
+      : block(param.block), grid(param.grid), shared_bytes(param.shared_bytes), aux(param.aux), comment(param.comment), time(param.time), n_calls(param.n_calls),
+        flops(param.flops), bytes(param.bytes), host(param.host) { }
 
     inline TuneParam& operator=(const TuneParam &param) {
       if (&param != this) {
@@ -41,6 +60,9 @@ namespace quda {
 	comment = param.comment;
 	time = param.time;
 	n_calls = param.n_calls;
+	flops = param.flops;
+	bytes = param.bytes;
+	host = param.host;
       }
       return *this;
     }
@@ -59,7 +81,7 @@ namespace quda {
 
   protected:
     virtual long long flops() const = 0;
-    virtual long long bytes() const { return 0; } // FIXME
+    virtual long long bytes() const = 0;
 
     // the minimum number of shared bytes per thread
     virtual unsigned int sharedBytesPerThread() const = 0;
@@ -215,6 +237,12 @@ namespace quda {
     virtual void postTune() { }
     virtual int tuningIter() const { return 1; }
 
+    /** @return The flops of one launch, as reported by flops() */
+    long long launchFlops() const { return flops(); }
+
+    /** @return The bytes moved by one launch, as reported by bytes() */
+    long long launchBytes() const { return bytes(); }
+
     virtual std::string paramString(const TuneParam &param) const
       {
 	std::stringstream ps;
@@ -268,6 +296,75 @@ namespace quda {
       return advanceSharedBytes(param) || advanceBlockDim(param) || advanceGridDim(param) || advanceAux(param);
     }
 
+    /**
+       @brief Whether this instance executes on the host.  Host
+       kernels are timed with std::chrono::steady_clock and tune the
+       OpenMP thread count, schedule chunk size and site-blocking tile
+       in place of the launch dimensions.  The key of a host kernel
+       should include getOmpThreadStr() so it is distinct from its
+       device counterpart.
+    */
+    virtual bool hostKernel() const { return false; }
+
+    /** @return Whether the host kernel makes use of the site-blocking tile param.block.z */
+    virtual bool tuneHostTile() const { return false; }
+
+    /** @return The largest site-blocking tile to try */
+    virtual unsigned int maxHostTile() const { return 64; }
+
+    /** @return The number of independent work items a host kernel distributes over its threads */
+    virtual unsigned int hostWorkItems() const { return minThreads(); }
+
+    virtual void initHostTuneParam(TuneParam &param) const
+    {
+      param.block = dim3(hostThreads(), 0, 1);
+      param.grid = dim3(1, 1, 1);
+      param.shared_bytes = 0;
+    }
+
+    /** sets default host values for when tuning is disabled */
+    virtual void defaultHostTuneParam(TuneParam &param) const { initHostTuneParam(param); }
+
+    /**
+       @brief Advance the host launch parameters: the tile is doubled
+       fastest, then the chunk size is stepped through static and
+       powers of four, and finally the thread count is halved.
+    */
+    virtual bool advanceHostTuneParam(TuneParam &param) const
+    {
+      if (tuneHostTile() && 2 * param.block.z <= maxHostTile()) {
+        param.block.z *= 2;
+        return true;
+      }
+      param.block.z = 1;
+
+      const unsigned int next_chunk = param.block.y ? 4 * param.block.y : 1;
+      if (param.block.x > 1 && next_chunk * param.block.x * param.block.z <= hostWorkItems()) {
+        param.block.y = next_chunk;
+        return true;
+      }
+      param.block.y = 0;
+
+      if (param.block.x > 1) {
+        // step down through the powers of two below the maximum
+        unsigned int threads = 1;
+        while (2 * threads < param.block.x) threads *= 2;
+        param.block.x = threads;
+        return true;
+      }
+      param.block.x = hostThreads();
+      return false;
+    }
+
+    std::string hostParamString(const TuneParam &param) const
+    {
+      std::stringstream ps;
+      ps << "threads=" << param.block.x << ", chunk=";
+      if (param.block.y) ps << param.block.y; else ps << "static";
+      if (tuneHostTile()) ps << ", tile=" << param.block.z;
+      return ps.str();
+    }
+
     /**
      * Check the launch parameters of the kernel to ensure that they are
      * valid for the current device.
@@ -476,11 +573,45 @@ namespace quda {
   */
   bool activeTuning();
 
+  /**
+     @brief Applies the host launch parameters of a host kernel to the
+     OpenMP runtime for the lifetime of the object, restoring the
+     previous thread count and schedule on destruction.  Host kernels
+     pick these up through "#pragma omp parallel for schedule(runtime)".
+   */
+  class HostLaunch {
+    int threads;
+    int kind;
+    int chunk;
+  public:
+    HostLaunch(const TuneParam &param);
+    ~HostLaunch();
+  };
+
+  /** in-memory tunecache, looked up on the hash of the key */
+  typedef std::unordered_map<TuneKey, TuneParam, TuneKeyHash> TuneCache;
+
+  /**
+   * @brief Return a reference to the tunecache
+   */
+  const TuneCache& getTuneCache();
+
+  /**
+   * @brief Read the tunecache from QUDA_RESOURCE_PATH.  The binary
+   * tunecache.bin is preferred, unless tunecache.tsv is newer.
+   */
   void loadTuneCache();
+
+  /**
+   * @brief Write the tunecache to QUDA_RESOURCE_PATH, both as the
+   * binary tunecache.bin and as the text export tunecache.tsv.
+   */
   void saveTuneCache(bool error = false);
 
   /**
-   * @brief Save profile to disk.
+   * @brief Save profile to disk, together with roofline.tsv giving
+   * the achieved throughput of each profiled kernel against the peak
+   * bandwidth measured by a STREAM-like probe.
    */
   void saveProfile(const std::string label = "");
 
@@ -14,6 +14,14 @@
  */
 QudaTune getTuning();
 
+/**
+   @brief Enable or disable autotuning, overriding QUDA_ENABLE_TUNING.
+   With tuning disabled host kernels run on all available OpenMP
+   threads, which checks that depend on the thread count rely on.
+   @param tune Whether autotuning is enabled
+ */
+void setTuning(QudaTune tune);
+
 QudaVerbosity getVerbosity();
 char *getOutputPrefix();
 FILE *getOutputFile();
@@ -36,9 +44,11 @@ bool getRankVerbosity();
 char *getPrintBuffer();
 
 /**
-   @brief Returns a string of the form
-   ",omp_threads=$OMP_NUM_THREADS", which can be used for storing the
+   @brief Returns a string of the form ",omp_threads=N", with N the
+   current omp_get_max_threads(), which can be used for storing the
    number of OMP threads for CPU functions recorded in the tune cache.
+   The string is rebuilt on each call, so it must be copied before
+   the thread count changes.
    @return Returns the string
 */
 char* getOmpThreadStr();
@@ -181,30 +181,35 @@ void blasCuda(const double2 &a, const double2 &b, const double2 &c,
 
 
 /**
-   Generic blas kernel with four loads and up to four stores.
+   Generic host blas kernel with five loads and up to five stores.
+   The sites are distributed over OpenMP threads, with each thread
+   operating on its own copy of the functor since some functors keep
+   per-element scratch state.
   */
-template <typename Float, int writeX, int writeY, int writeZ, int writeW, int writeV,
+template <typename Float2, int writeX, int writeY, int writeZ, int writeW, int writeV,
           typename SpinorX, typename SpinorY, typename SpinorZ,
           typename SpinorW, typename SpinorV, typename Functor>
-void genericBlas(SpinorX &X, SpinorY &Y, SpinorZ &Z, SpinorW &W, SpinorV &V, Functor f) {
-
-  for (int parity=0; parity<X.Nparity(); parity++) {
-    for (int x=0; x<X.VolumeCB(); x++) {
-      for (int s=0; s<X.Nspin(); s++) {
-	for (int c=0; c<X.Ncolor(); c++) {
-	  complex<Float> X_(X(parity, x, s, c));
-	  complex<Float> Y_ = Y(parity, x, s, c);
-	  complex<Float> Z_ = Z(parity, x, s, c);
-	  complex<Float> W_ = W(parity, x, s, c);
-	  complex<Float> V_ = V(parity, x, s, c);
-	  f(X_, Y_, Z_, W_, V_);
-	  if (writeX) X(parity, x, s, c) = X_;
-	  if (writeY) Y(parity, x, s, c) = Y_;
-	  if (writeZ) Z(parity, x, s, c) = Z_;
-	  if (writeW) W(parity, x, s, c) = W_;
-	  if (writeV) V(parity, x, s, c) = V_;
-	}
-      }
+void genericBlas(SpinorX &X, SpinorY &Y, SpinorZ &Z, SpinorW &W, SpinorV &V, Functor f,
+                 int volumeCB, int nParity) {
+
+  constexpr int length = SpinorX::length;
+  f.init();
+
+#pragma omp parallel for collapse(2) firstprivate(f)
+  for (int parity=0; parity<nParity; parity++) {
+    for (int x=0; x<volumeCB; x++) {
+      Float2 X_[length], Y_[length], Z_[length], W_[length], V_[length];
+      X.load(X_, x, parity);
+      Y.load(Y_, x, parity);
+      Z.load(Z_, x, parity);
+      W.load(W_, x, parity);
+      V.load(V_, x, parity);
+      for (int i=0; i<length; i++) f(X_[i], Y_[i], Z_[i], W_[i], V_[i]);
+      if (writeX) X.save(X_, x, parity);
+      if (writeY) Y.save(Y_, x, parity);
+      if (writeZ) Z.save(Z_, x, parity);
+      if (writeW) W.save(W_, x, parity);
+      if (writeV) V.save(V_, x, parity);
     }
   }
 }
@@ -213,9 +218,10 @@ template <typename Float, typename yFloat, int nSpin, int nColor, QudaFieldOrder
           int writeX, int writeY, int writeZ, int writeW, int writeV, typename Functor>
   void genericBlas(ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField &z,
 		   ColorSpinorField &w, ColorSpinorField &v, Functor f) {
-  colorspinor::FieldOrderCB<Float,nSpin,nColor,1,order> X(x), Z(z), W(w);
-  colorspinor::FieldOrderCB<yFloat,nSpin,nColor,1,order> Y(y), V(v);
-  genericBlas<yFloat,writeX,writeY,writeZ,writeW,writeV>(X, Y, Z, W, V, f);
+  typedef typename vector<yFloat,2>::type Float2;
+  HostSpinor<Float2,Float,nSpin,nColor,order> X(x), Z(z), W(w);
+  HostSpinor<Float2,yFloat,nSpin,nColor,order> Y(y), V(v);
+  genericBlas<Float2,writeX,writeY,writeZ,writeW,writeV>(X, Y, Z, W, V, f, x.VolumeCB(), x.SiteSubset());
 }
 
 template <typename Float, typename yFloat, int nSpin, QudaFieldOrder order,
@@ -268,7 +274,24 @@ void genericBlas(ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField &z,
   if (x.FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER) {
     genericBlas<Float,yFloat,QUDA_SPACE_SPIN_COLOR_FIELD_ORDER,writeX,writeY,writeZ,writeW,writeV,Functor>
       (x, y, z, w, v, f);
+  } else if (x.FieldOrder() == QUDA_SPACE_COLOR_SPIN_FIELD_ORDER) {
+    genericBlas<Float,yFloat,QUDA_SPACE_COLOR_SPIN_FIELD_ORDER,writeX,writeY,writeZ,writeW,writeV,Functor>
+      (x, y, z, w, v, f);
+  } else if (x.FieldOrder() == QUDA_PADDED_SPACE_SPIN_COLOR_FIELD_ORDER) {
+#ifdef BUILD_TIFR_INTERFACE
+    genericBlas<Float,yFloat,QUDA_PADDED_SPACE_SPIN_COLOR_FIELD_ORDER,writeX,writeY,writeZ,writeW,writeV,Functor>
+      (x, y, z, w, v, f);
+#else
+    errorQuda("TIFR interface has not been built\n");
+#endif
+  } else if (x.FieldOrder() == QUDA_QDPJIT_FIELD_ORDER) {
+#ifdef BUILD_QDPJIT_INTERFACE
+    genericBlas<Float,yFloat,QUDA_QDPJIT_FIELD_ORDER,writeX,writeY,writeZ,writeW,writeV,Functor>
+      (x, y, z, w, v, f);
+#else
+    errorQuda("QDPJIT interface has not been built\n");
+#endif
   } else {
-    errorQuda("Not implemented");
+    errorQuda("Field order %d not implemented", x.FieldOrder());
   }
 }
@@ -13,6 +13,7 @@
 #include <blas_quda.h>
 #include <color_spinor_field.h>
 #include <color_spinor_field_order.h>
+#include <blas_helper.cuh>
 
 #define checkSpinor(a, b)						\
   {									\
@@ -441,12 +442,15 @@ namespace quda {
 	: a(a), Ar3(static_cast<double3*>(blas::getDeviceReduceBuffer())) { ; }
 
       inline __device__ __host__ void init() {
-#ifdef __CUDA_ARCH__
 	typedef decltype(a.x) real;
+#ifdef __CUDA_ARCH__
 	double3 result = __ldg(Ar3);
+#else
+	// host reductions leave their local result in the host reduce buffer
+	double3 result = *static_cast<double3*>(blas::getHostReduceBuffer());
+#endif
 	a.y = a.x * (real)(result.y) * ((real)1.0 / (real)result.z);
 	a.x = a.x * (real)(result.x) * ((real)1.0 / (real)result.z);
-#endif
       }
 
       __device__ __host__ void operator()(FloatN &x, FloatN &y, FloatN &z, FloatN &w, FloatN &v)
@@ -460,9 +464,6 @@ namespace quda {
 		     ColorSpinorField &y, ColorSpinorField &z) {
       if (!commAsyncReduction())
 	errorQuda("This kernel requires asynchronous reductions to be set");
-      if (x.Location() == QUDA_CPU_FIELD_LOCATION)
-	errorQuda("This kernel cannot be run on CPU fields");
-
       blasCuda<caxpyxmazMR_,1,1>(make_double2(REAL(a), IMAG(a)), make_double2(0.0, 0.0),
                                  make_double2(0.0, 0.0), x, y, z, x, y);
     }
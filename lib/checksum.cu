@@ -10,19 +10,54 @@ namespace quda {
     typedef typename gauge_order_mapper<T,order,Nc>::type G;
     const G U;
     const int volumeCB;
-    ChecksumArg(const GaugeField &U, bool mini) : U(U), volumeCB(mini ? 1 : U.VolumeCB()) { }
+    const uint64_t offset; // global index of the first link on this process
+    ChecksumArg(const GaugeField &U, bool mini) : U(U), volumeCB(mini ? 1 : U.VolumeCB()),
+      offset(static_cast<uint64_t>(comm_rank()) * 2 * volumeCB * U.Geometry()) { }
   };
 
+  /**
+     @brief splitmix64 finalizer, used to decorrelate each word of the
+     field from its neighbours and from its position before the words
+     are combined
+  */
+  __device__ __host__ inline uint64_t mix64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+  }
+
+  /**
+     @brief Checksum of a single link.  Each 64-bit word of the link
+     is mixed with its global position in the field, so the XOR over
+     the field is independent of the order the links are visited in,
+     but unlike a plain XOR of the words it does not cancel for
+     repeated or permuted links.
+  */
   template <typename Arg>
   __device__ __host__ inline uint64_t siteChecksum(const Arg &arg, int d, int parity, int x_cb) {
-    const Matrix<complex<typename Arg::real>,Arg::nColor> u = arg.U(d, x_cb, parity);
-    return u.checksum(); 
+    typedef typename Arg::real real;
+    constexpr int n = 2 * Arg::nColor * Arg::nColor;
+    real u[n];
+    arg.U.load(u, x_cb, d, parity);
+
+    // ensure length is rounded up to 64-bit multiple
+    constexpr int length = (n * sizeof(real) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    uint64_t base_[length] = { };
+    real *data_ = reinterpret_cast<real*>( static_cast<void*>(base_) );
+    for (int i=0; i<n; i++) data_[i] = u[i];
+
+    const uint64_t link = arg.offset + (static_cast<uint64_t>(parity) * arg.volumeCB + x_cb) * arg.U.geometry + d;
+    uint64_t checksum_ = 0;
+#pragma omp simd reduction(^:checksum_)
+    for (int i=0; i<length; i++) checksum_ ^= mix64(base_[i] ^ mix64(link * length + i));
+    return checksum_;
   }
 
   template <typename Arg>
   uint64_t ChecksumCPU(const Arg &arg)
   {
     uint64_t checksum_ = 0;
+#pragma omp parallel for collapse(2) reduction(^:checksum_)
     for (int parity=0; parity<2; parity++)
       for (int x_cb=0; x_cb<arg.volumeCB; x_cb++)
 	for (int d=0; d<arg.U.geometry; d++)
@@ -43,6 +78,12 @@ namespace quda {
     } else if (u.Order() == QUDA_MILC_GAUGE_ORDER) {
       ChecksumArg<T,QUDA_MILC_GAUGE_ORDER,Nc> arg(u,mini);
       checksum = ChecksumCPU(arg);
+    } else if (u.Order() == QUDA_MILC_SITE_GAUGE_ORDER) {
+      ChecksumArg<T,QUDA_MILC_SITE_GAUGE_ORDER,Nc> arg(u,mini);
+      checksum = ChecksumCPU(arg);
+    } else if (u.Order() == QUDA_CPS_WILSON_GAUGE_ORDER) {
+      ChecksumArg<T,QUDA_CPS_WILSON_GAUGE_ORDER,Nc> arg(u,mini);
+      checksum = ChecksumCPU(arg);
     } else if (u.Order() == QUDA_BQCD_GAUGE_ORDER) {
       ChecksumArg<T,QUDA_BQCD_GAUGE_ORDER,Nc> arg(u,mini);
       checksum = ChecksumCPU(arg);
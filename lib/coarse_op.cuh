@@ -189,6 +189,7 @@ namespace quda {
       TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
 
       if (meta.Location() == QUDA_CPU_FIELD_LOCATION) {
+	HostLaunch launch(tp);
 
 	if (type == COMPUTE_UV) {
 
@@ -656,6 +657,8 @@ namespace quda {
       else return false;
     }
 
+    bool hostKernel() const { return meta.Location() == QUDA_CPU_FIELD_LOCATION; }
+
     void initTuneParam(TuneParam &param) const
     {
       TunableVectorYZ::initTuneParam(param);
@@ -40,6 +40,7 @@ namespace quda {
     void apply(const cudaStream_t &stream) {
       TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
       if (meta.Location() == QUDA_CPU_FIELD_LOCATION) {
+	HostLaunch launch(tp);
 	CalculateYhatCPU<Float,n,Arg>(arg);
       } else {
 #ifdef JITIFY
@@ -61,6 +62,8 @@ namespace quda {
       else return false;
     }
 
+    bool hostKernel() const { return meta.Location() == QUDA_CPU_FIELD_LOCATION; }
+
     TuneKey tuneKey() const {
       char Aux[TuneKey::aux_n];
       strcpy(Aux,aux);
@@ -70,7 +70,7 @@ char *comm_hostname(void)
 }
 
 
-static unsigned long int rand_seed = 137;
+static COMM_RANK_LOCAL unsigned long int rand_seed = 137;
 
 /**
  * We provide our own random number generator to avoid re-seeding
@@ -363,7 +363,7 @@ int comm_rank_displaced(const Topology *topo, const int displacement[])
 // FIXME: The following routines rely on a "default" topology.
 // They should probably be reworked or eliminated eventually.
 
-Topology *default_topo = NULL;
+COMM_RANK_LOCAL Topology *default_topo = NULL;
 
 void comm_set_default_topology(Topology *topo)
 {
@@ -379,10 +379,10 @@ Topology *comm_default_topology(void)
   return default_topo;
 }
 
-static int neighbor_rank[2][4] = { {-1,-1,-1,-1},
+static COMM_RANK_LOCAL int neighbor_rank[2][4] = { {-1,-1,-1,-1},
                                           {-1,-1,-1,-1} };
 
-static bool neighbors_cached = false;
+static COMM_RANK_LOCAL bool neighbors_cached = false;
 
 void comm_set_neighbor_ranks(Topology *topo){
 
@@ -599,7 +599,7 @@ void comm_finalize(void)
 }
 
 
-static int manual_set_partition[QUDA_MAX_DIM] = {0};
+static COMM_RANK_LOCAL int manual_set_partition[QUDA_MAX_DIM] = {0};
 
 void comm_dim_partitioned_set(int dim)
 { 
@@ -678,8 +678,8 @@ bool comm_gdr_blacklist() {
   return blacklist;
 }
 
-static bool globalReduce = true;
-static bool asyncReduce = false;
+static COMM_RANK_LOCAL bool globalReduce = true;
+static COMM_RANK_LOCAL bool asyncReduce = false;
 
 void reduceMaxDouble(double &max) { comm_allreduce_max(&max); }
 
@@ -688,6 +688,12 @@ void reduceDouble(double &sum) { if (globalReduce) comm_allreduce(&sum); }
 void reduceDoubleArray(double *sum, const int len)
 { if (globalReduce) comm_allreduce_array(sum, len); }
 
+ReduceHandle *reduceDoubleArrayStart(const double *sum, const int len)
+{ return globalReduce ? comm_iallreduce_array(sum, len) : NULL; }
+
+void reduceDoubleArrayWait(ReduceHandle *rh, double *sum)
+{ if (rh) comm_wait_reduce(rh, sum); }
+
 int commDim(int dir) { return comm_dim(dir); }
 
 int commCoords(int dir) { return comm_coord(dir); }
@@ -39,6 +39,23 @@ struct MsgHandle_s {
   bool custom;
 };
 
+struct ReduceHandle_s {
+  /**
+     The request for the in-flight reduction
+   */
+  MPI_Request request;
+
+  /**
+     Reduction buffer owned by the handle, summed in place
+   */
+  double *buffer;
+
+  /**
+     Number of elements in the reduction
+   */
+  size_t size;
+};
+
 static int rank = -1;
 static int size = -1;
 static int gpuid = -1;
@@ -362,6 +379,46 @@ void comm_allreduce_xor(uint64_t *data)
 }
 
 
+ReduceHandle *comm_iallreduce_array(const double *data, size_t size)
+{
+  ReduceHandle *rh = (ReduceHandle *)safe_malloc(sizeof(ReduceHandle));
+  rh->buffer = (double *)safe_malloc(size*sizeof(double));
+  rh->size = size;
+  memcpy(rh->buffer, data, size*sizeof(double));
+#if MPI_VERSION >= 3
+  MPI_CHECK( MPI_Iallreduce(MPI_IN_PLACE, rh->buffer, size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD, &rh->request) );
+#else
+  // no non-blocking collectives before MPI-3, so complete the reduction now
+  MPI_CHECK( MPI_Allreduce(MPI_IN_PLACE, rh->buffer, size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD) );
+  rh->request = MPI_REQUEST_NULL;
+#endif
+  return rh;
+}
+
+
+ReduceHandle *comm_iallreduce(const double *data)
+{
+  return comm_iallreduce_array(data, 1);
+}
+
+
+int comm_query_reduce(ReduceHandle *rh)
+{
+  int query;
+  MPI_CHECK( MPI_Test(&(rh->request), &query, MPI_STATUS_IGNORE) );
+  return query;
+}
+
+
+void comm_wait_reduce(ReduceHandle *rh, double *data)
+{
+  MPI_CHECK( MPI_Wait(&(rh->request), MPI_STATUS_IGNORE) );
+  memcpy(data, rh->buffer, rh->size*sizeof(double));
+  host_free(rh->buffer);
+  host_free(rh);
+}
+
+
 /**  broadcast from rank 0 */
 void comm_broadcast(void *data, size_t nbytes)
 {
@@ -321,6 +321,40 @@ void comm_allreduce_xor(uint64_t *data)
   QMP_CHECK( QMP_xor_ulong( reinterpret_cast<unsigned long*>(data) ));
 }
 
+struct ReduceHandle_s {
+  double *buffer;
+  size_t size;
+};
+
+// QMP has no non-blocking collectives, so the reduction is completed
+// when it is started and the wait just returns the result
+ReduceHandle *comm_iallreduce_array(const double *data, size_t size)
+{
+  ReduceHandle *rh = (ReduceHandle *)safe_malloc(sizeof(ReduceHandle));
+  rh->buffer = (double *)safe_malloc(size*sizeof(double));
+  rh->size = size;
+  memcpy(rh->buffer, data, size*sizeof(double));
+  QMP_CHECK( QMP_sum_double_array(rh->buffer, size) );
+  return rh;
+}
+
+ReduceHandle *comm_iallreduce(const double *data)
+{
+  return comm_iallreduce_array(data, 1);
+}
+
+int comm_query_reduce(ReduceHandle *rh)
+{
+  return 1;
+}
+
+void comm_wait_reduce(ReduceHandle *rh, double *data)
+{
+  memcpy(data, rh->buffer, rh->size*sizeof(double));
+  host_free(rh->buffer);
+  host_free(rh);
+}
+
 void comm_broadcast(void *data, size_t nbytes)
 {
   QMP_CHECK( QMP_broadcast(data, nbytes) );
@@ -0,0 +1,507 @@
+/**
+ * Shared-memory communications layer that runs every rank as a thread
+ * of a single process.  Ranks are started with comm_threads_launch().
+ *
+ * Point-to-point messages go through lock-free single-producer /
+ * single-consumer mailboxes, one per (source, destination, tag)
+ * triple, so the persistent handles behave like their MPI
+ * counterparts: a send is complete once its payload has been copied
+ * into the mailbox and a receive completes when the matching payload
+ * is taken out.  Mailboxes grow as needed, so a send never waits for
+ * the receiver however many messages are queued.  Collectives are performed over a binary tree of the
+ * ranks, so the summation order (and hence the result) is independent
+ * of thread scheduling.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <csignal>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <vector>
+#include <quda_internal.h>
+#include <comm_quda.h>
+
+/**
+   A single-producer / single-consumer queue of message slots, held in
+   a linked list of fixed-size segments.  The producer is the sending
+   rank and the consumer the receiving rank, so the only
+   synchronization needed is the acquire / release pair on head and
+   tail, and on the links between segments.  The producer appends a
+   segment when the last one fills, so it never waits for the
+   consumer.  A segment the consumer has emptied is handed back
+   through spare, so in steady state two segments alternate and their
+   payload storage is reused.
+ */
+struct Mailbox {
+  struct Segment {
+    static constexpr int capacity = 4;
+
+    /** payload storage, only ever resized by the producer */
+    std::vector<char> slot[capacity];
+
+    /** the segment after this one, published by the producer */
+    std::atomic<Segment*> next;
+
+    Segment() : next(nullptr) { }
+  };
+
+  /** segment holding message head (owned by the receiver) */
+  Segment *read;
+
+  /** number of messages consumed (written by the receiver) */
+  std::atomic<uint64_t> head;
+
+  /** keep the receiver and sender state on separate cache lines */
+  char pad[64 - sizeof(std::atomic<uint64_t>) - sizeof(Segment*)];
+
+  /** segment holding message tail (owned by the sender) */
+  Segment *write;
+
+  /** number of messages produced (written by the sender) */
+  std::atomic<uint64_t> tail;
+
+  /** an emptied segment for the sender to reuse */
+  std::atomic<Segment*> spare;
+
+  Mailbox() : read(new Segment), head(0), write(read), tail(0), spare(nullptr) { }
+
+  ~Mailbox()
+  {
+    while (read) {
+      Segment *next = read->next.load(std::memory_order_relaxed);
+      delete read;
+      read = next;
+    }
+    delete spare.load(std::memory_order_relaxed);
+  }
+
+  /**
+     Slot for message tail, appending a segment if the last one is full
+   */
+  std::vector<char> &push_slot(uint64_t tail)
+  {
+    if (tail > 0 && tail % Segment::capacity == 0) {
+      Segment *segment = spare.exchange(nullptr, std::memory_order_acquire);
+      if (!segment) segment = new Segment;
+      segment->next.store(nullptr, std::memory_order_relaxed);
+      write->next.store(segment, std::memory_order_release);
+      write = segment;
+    }
+    return write->slot[tail % Segment::capacity];
+  }
+
+  /**
+     Slot for message head, moving on to the next segment once the
+     current one has been emptied.  Message head must be available.
+   */
+  const std::vector<char> &pop_slot(uint64_t head)
+  {
+    if (head > 0 && head % Segment::capacity == 0) {
+      Segment *empty = read;
+      read = read->next.load(std::memory_order_acquire);
+      delete spare.exchange(empty, std::memory_order_acq_rel); // the sender did not take the last one
+    }
+    return read->slot[head % Segment::capacity];
+  }
+};
+
+struct MsgHandle_s {
+  /**
+     The mailbox shared with the peer rank
+   */
+  Mailbox *mailbox;
+
+  /**
+     User buffer that is sent from or received into
+   */
+  char *buffer;
+
+  /**
+     Block layout of the buffer: contiguous messages are a single
+     block with stride equal to blksize
+   */
+  size_t blksize;
+  int nblocks;
+  size_t stride;
+
+  /**
+     Whether this is a send or a receive handle
+   */
+  bool send;
+
+  /**
+     Whether a receive has been started but not yet completed
+   */
+  bool pending;
+};
+
+struct ReduceHandle_s {
+  double *buffer;
+  size_t size;
+};
+
+/**
+   Per-rank state of the tree collectives.  Two buffers are used in
+   alternating collectives, since a rank may start its next collective
+   while its children are still copying the result of the current one.
+ */
+struct CollectiveSlot {
+  std::vector<char> buffer[2];
+  std::atomic<uint64_t> up;   // last collective whose partial result is ready
+  char pad[64 - sizeof(std::atomic<uint64_t>)];
+  std::atomic<uint64_t> down; // last collective whose final result is ready
+  CollectiveSlot() : up(0), down(0) { }
+};
+
+static int nranks = 0;
+static CollectiveSlot *slots = nullptr;
+
+static std::mutex mailbox_mutex;
+static std::map<std::tuple<int,int,int>, std::unique_ptr<Mailbox> > mailboxes;
+
+static thread_local int rank = -1;
+static thread_local int gpuid = -1;
+static thread_local uint64_t collective_count = 0;
+static thread_local CommStats stats;
+
+static thread_local char partition_string[16];
+static thread_local char topology_string[128];
+
+/**
+   Spin until the condition holds.  There may be more ranks than
+   cores, so a waiting rank yields to the others.
+ */
+template <typename Cond> static inline void spin_wait(Cond cond)
+{
+  while (!cond()) std::this_thread::yield();
+}
+
+int comm_threads_launch(int n, void (*rank_main)(void *), void *arg)
+{
+  if (n < 1) errorQuda("Invalid number of ranks %d", n);
+  if (nranks) errorQuda("Ranks have already been launched");
+
+  nranks = n;
+  slots = new CollectiveSlot[n];
+
+  std::vector<std::thread> threads;
+  for (int r = 0; r < n; r++) {
+    threads.emplace_back([=]() {
+        rank = r;
+        rank_main(arg);
+      });
+  }
+  for (auto &t : threads) t.join();
+
+  mailboxes.clear();
+  delete []slots;
+  slots = nullptr;
+  nranks = 0;
+
+  return 0;
+}
+
+void comm_threads_stats(CommStats *s) { *s = stats; }
+
+void comm_threads_stats_reset() { memset(&stats, 0, sizeof(stats)); }
+
+/**
+   Tree all-reduce of n elements of type T with the binary operator
+   op.  Rank r combines the partial results of ranks 2r+1 and 2r+2
+   into its own, and the final result at rank 0 is copied back down
+   the same tree.  When reduce is false the partial results are
+   ignored and the data of rank 0 is broadcast.
+ */
+template <typename T, typename Op> static void tree_collective(T *data, size_t n, Op op, bool reduce)
+{
+  if (rank < 0) errorQuda("Collective called outside of a launched rank");
+  auto start = std::chrono::steady_clock::now();
+
+  uint64_t g = ++collective_count;
+  CollectiveSlot &self = slots[rank];
+  std::vector<char> &buf = self.buffer[g & 1];
+  buf.resize(n * sizeof(T));
+  T *result = reinterpret_cast<T*>(buf.data());
+  memcpy(result, data, n * sizeof(T));
+
+  for (int c = 2*rank+1; c <= 2*rank+2 && c < nranks; c++) {
+    spin_wait([&]() { return slots[c].up.load(std::memory_order_acquire) >= g; });
+    if (reduce) {
+      const T *child = reinterpret_cast<const T*>(slots[c].buffer[g & 1].data());
+      for (size_t i = 0; i < n; i++) result[i] = op(result[i], child[i]);
+    }
+  }
+  self.up.store(g, std::memory_order_release);
+
+  if (rank > 0) {
+    const int parent = (rank - 1) / 2;
+    spin_wait([&]() { return slots[parent].down.load(std::memory_order_acquire) >= g; });
+    memcpy(result, slots[parent].buffer[g & 1].data(), n * sizeof(T));
+  }
+  self.down.store(g, std::memory_order_release);
+
+  memcpy(data, result, n * sizeof(T));
+
+  stats.collectives++;
+  stats.collective_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename T> static void allreduce_sum(T *data, size_t n)
+{ tree_collective(data, n, [](T a, T b) { return a + b; }, true); }
+
+void comm_gather_hostname(char *hostname_recv_buf) {
+  // each rank fills its own entry and the rest are zero, so a bitwise or assembles the gather
+  memset(hostname_recv_buf, 0, 128*nranks);
+  strncpy(&hostname_recv_buf[128*rank], comm_hostname(), 128);
+  tree_collective(hostname_recv_buf, 128*nranks, [](char a, char b) { return (char)(a | b); }, true);
+}
+
+void comm_gather_gpuid(int *gpuid_recv_buf) {
+  memset(gpuid_recv_buf, 0, nranks*sizeof(int));
+  gpuid_recv_buf[rank] = gpuid;
+  allreduce_sum(gpuid_recv_buf, nranks);
+}
+
+
+void comm_init(int ndim, const int *dims, QudaCommsMap rank_from_coords, void *map_data)
+{
+  if (rank < 0) errorQuda("comm_init must be called from a rank started with comm_threads_launch");
+
+  int grid_size = 1;
+  for (int i = 0; i < ndim; i++) grid_size *= dims[i];
+  if (grid_size != nranks) {
+    errorQuda("Communication grid size declared via initCommsGridQuda() does not match"
+              " total number of ranks (%d != %d)", grid_size, nranks);
+  }
+
+  Topology *topo = comm_create_topology(ndim, dims, rank_from_coords, map_data);
+  comm_set_default_topology(topo);
+
+  // all ranks share the devices of this node, as if MPS were enabled
+  int device_count = 0;
+  if (cudaGetDeviceCount(&device_count) != cudaSuccess || device_count == 0) {
+    cudaGetLastError();
+    device_count = 1;
+  }
+  gpuid = rank % device_count;
+
+  comm_threads_stats_reset();
+
+  snprintf(partition_string, 16, ",comm=%d%d%d%d", comm_dim_partitioned(0), comm_dim_partitioned(1), comm_dim_partitioned(2), comm_dim_partitioned(3));
+  snprintf(topology_string, 128, ",topo=%d%d%d%d", comm_dim(0), comm_dim(1), comm_dim(2), comm_dim(3));
+}
+
+int comm_rank(void) { return rank; }
+
+int comm_size(void) { return nranks; }
+
+int comm_gpuid(void) { return gpuid; }
+
+
+static const int max_displacement = 4;
+
+static void check_displacement(const int displacement[], int ndim) {
+  for (int i=0; i<ndim; i++) {
+    if (abs(displacement[i]) > max_displacement){
+      errorQuda("Requested displacement[%d] = %d is greater than maximum allowed", i, displacement[i]);
+    }
+  }
+}
+
+/**
+   Find (or create) the mailbox carrying messages from rank src to
+   rank dst that were sent with the given displacement.  As with the
+   MPI tags, a receive with displacement d matches a send with
+   displacement -d.
+ */
+static Mailbox *get_mailbox(int src, int dst, const int displacement[], int ndim)
+{
+  int tag = 0;
+  for (int i=ndim-1; i>=0; i--) tag = tag * 4 * max_displacement + displacement[i] + max_displacement;
+
+  std::lock_guard<std::mutex> lock(mailbox_mutex);
+  std::unique_ptr<Mailbox> &mailbox = mailboxes[std::make_tuple(src, dst, tag)];
+  if (!mailbox) mailbox.reset(new Mailbox);
+  return mailbox.get();
+}
+
+static MsgHandle *declare(void *buffer, const int displacement[], size_t blksize, int nblocks, size_t stride, bool send)
+{
+  Topology *topo = comm_default_topology();
+  int ndim = comm_ndim(topo);
+  check_displacement(displacement, ndim);
+
+  int peer = comm_rank_displaced(topo, displacement);
+
+  MsgHandle *mh = (MsgHandle *)safe_malloc(sizeof(MsgHandle));
+  if (send) {
+    mh->mailbox = get_mailbox(rank, peer, displacement, ndim);
+  } else {
+    int send_displacement[QUDA_MAX_DIM];
+    for (int i=0; i<ndim; i++) send_displacement[i] = -displacement[i];
+    mh->mailbox = get_mailbox(peer, rank, send_displacement, ndim);
+  }
+  mh->buffer = static_cast<char*>(buffer);
+  mh->blksize = blksize;
+  mh->nblocks = nblocks;
+  mh->stride = stride;
+  mh->send = send;
+  mh->pending = false;
+
+  return mh;
+}
+
+MsgHandle *comm_declare_send_displaced(void *buffer, const int displacement[], size_t nbytes)
+{ return declare(buffer, displacement, nbytes, 1, nbytes, true); }
+
+MsgHandle *comm_declare_receive_displaced(void *buffer, const int displacement[], size_t nbytes)
+{ return declare(buffer, displacement, nbytes, 1, nbytes, false); }
+
+MsgHandle *comm_declare_strided_send_displaced(void *buffer, const int displacement[],
+					       size_t blksize, int nblocks, size_t stride)
+{ return declare(buffer, displacement, blksize, nblocks, stride, true); }
+
+MsgHandle *comm_declare_strided_receive_displaced(void *buffer, const int displacement[],
+						  size_t blksize, int nblocks, size_t stride)
+{ return declare(buffer, displacement, blksize, nblocks, stride, false); }
+
+void comm_free(MsgHandle *mh)
+{
+  host_free(mh);
+}
+
+/**
+   Take the next message out of the mailbox and unpack it into the
+   receive buffer
+ */
+static void receive(MsgHandle *mh)
+{
+  Mailbox &box = *mh->mailbox;
+  uint64_t head = box.head.load(std::memory_order_relaxed);
+  const char *payload = box.pop_slot(head).data();
+  for (int i=0; i<mh->nblocks; i++) memcpy(mh->buffer + i*mh->stride, payload + i*mh->blksize, mh->blksize);
+  box.head.store(head + 1, std::memory_order_release);
+  mh->pending = false;
+}
+
+static inline bool available(const MsgHandle *mh)
+{
+  return mh->mailbox->tail.load(std::memory_order_acquire) > mh->mailbox->head.load(std::memory_order_relaxed);
+}
+
+void comm_start(MsgHandle *mh)
+{
+  if (!mh->send) {
+    mh->pending = true;
+    return;
+  }
+
+  // the send is eager: pack the payload into a new slot and publish it
+  Mailbox &box = *mh->mailbox;
+  uint64_t tail = box.tail.load(std::memory_order_relaxed);
+
+  std::vector<char> &slot = box.push_slot(tail);
+  slot.resize(mh->blksize * mh->nblocks);
+  for (int i=0; i<mh->nblocks; i++) memcpy(slot.data() + i*mh->blksize, mh->buffer + i*mh->stride, mh->blksize);
+  box.tail.store(tail + 1, std::memory_order_release);
+
+  stats.messages++;
+  stats.bytes += mh->blksize * mh->nblocks;
+}
+
+void comm_wait(MsgHandle *mh)
+{
+  if (!mh->pending) return;
+  spin_wait([&]() { return available(mh); });
+  receive(mh);
+}
+
+int comm_query(MsgHandle *mh)
+{
+  if (!mh->pending) return 1;
+  if (!available(mh)) return 0;
+  receive(mh);
+  return 1;
+}
+
+void comm_allreduce(double* data) { allreduce_sum(data, 1); }
+
+void comm_allreduce_max(double* data)
+{ tree_collective(data, 1, [](double a, double b) { return a > b ? a : b; }, true); }
+
+void comm_allreduce_min(double* data)
+{ tree_collective(data, 1, [](double a, double b) { return a < b ? a : b; }, true); }
+
+void comm_allreduce_array(double* data, size_t size) { allreduce_sum(data, size); }
+
+void comm_allreduce_max_array(double* data, size_t size)
+{ tree_collective(data, size, [](double a, double b) { return a > b ? a : b; }, true); }
+
+void comm_allreduce_int(int* data) { allreduce_sum(data, 1); }
+
+void comm_allreduce_xor(uint64_t *data)
+{ tree_collective(data, 1, [](uint64_t a, uint64_t b) { return a ^ b; }, true); }
+
+// the tree collectives are blocking, so the reduction is completed
+// when it is started and the wait just returns the result
+ReduceHandle *comm_iallreduce_array(const double *data, size_t size)
+{
+  ReduceHandle *rh = (ReduceHandle *)safe_malloc(sizeof(ReduceHandle));
+  rh->buffer = (double *)safe_malloc(size*sizeof(double));
+  rh->size = size;
+  memcpy(rh->buffer, data, size*sizeof(double));
+  allreduce_sum(rh->buffer, size);
+  return rh;
+}
+
+ReduceHandle *comm_iallreduce(const double *data)
+{
+  return comm_iallreduce_array(data, 1);
+}
+
+int comm_query_reduce(ReduceHandle *rh)
+{
+  return 1;
+}
+
+void comm_wait_reduce(ReduceHandle *rh, double *data)
+{
+  memcpy(data, rh->buffer, rh->size*sizeof(double));
+  host_free(rh->buffer);
+  host_free(rh);
+}
+
+/**  broadcast from rank 0 */
+void comm_broadcast(void *data, size_t nbytes)
+{
+  tree_collective(static_cast<char*>(data), nbytes, [](char a, char b) { return a; }, false);
+}
+
+void comm_barrier(void)
+{
+  char dummy = 0;
+  tree_collective(&dummy, 0, [](char a, char b) { return a; }, false);
+}
+
+void comm_abort(int status)
+{
+#ifdef HOST_DEBUG
+  raise(SIGINT);
+#endif
+  exit(status);
+}
+
+const char* comm_dim_partitioned_string() {
+  return partition_string;
+}
+
+const char* comm_dim_topology_string() {
+  return topology_string;
+}
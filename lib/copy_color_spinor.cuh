@@ -118,18 +118,33 @@ namespace quda {
     }
   };
 
-  /** CPU function to reorder spinor fields.  */
+  /**
+     CPU function to reorder spinor fields.  The checkerboard of each
+     parity is split into tiles of consecutive sites that are
+     distributed over the OpenMP threads, so each thread streams
+     through a contiguous range of the output for the site-major
+     orders used by the applications and the staging buffers.
+     @param[in] arg Kernel argument
+     @param[in] basis Basis transformation applied at each site
+     @param[in] tile Number of consecutive sites assigned to each work item
+  */
   template <typename FloatOut, typename FloatIn, int Ns, int Nc, typename Arg, typename Basis>
-  void copyColorSpinor(Arg &arg, const Basis &basis) {
+  void copyColorSpinor(Arg &arg, const Basis &basis, int tile = 1) {
     typedef typename mapper<FloatIn>::type RegTypeIn;
     typedef typename mapper<FloatOut>::type RegTypeOut;
 
+    const int n_tile = (arg.volumeCB + tile - 1) / tile;
+
+#pragma omp parallel for collapse(2) schedule(runtime)
     for (int parity = 0; parity<arg.nParity; parity++) {
-      for (int x=0; x<arg.volumeCB; x++) {
-	ColorSpinor<RegTypeIn, Nc, Ns> in = arg.in(x, (parity+arg.inParity)&1);
-	ColorSpinor<RegTypeOut, Nc, Ns> out;
-	basis(out.data, in.data);
-	arg.out(x, (parity+arg.outParity)&1) = out;
+      for (int t = 0; t < n_tile; t++) {
+        const int x_end = (t + 1) * tile < arg.volumeCB ? (t + 1) * tile : arg.volumeCB;
+        for (int x = t * tile; x < x_end; x++) {
+          ColorSpinor<RegTypeIn, Nc, Ns> in = arg.in(x, (parity+arg.inParity)&1);
+          ColorSpinor<RegTypeOut, Nc, Ns> out;
+          basis(out.data, in.data);
+          arg.out(x, (parity+arg.outParity)&1) = out;
+        }
       }
     }
   }
@@ -163,18 +178,27 @@ namespace quda {
     bool tuneGridDim() const { return false; } // Don't tune the grid dimensions.
     unsigned int minThreads() const { return meta.VolumeCB(); }
 
+    // the CPU variant threads over tiles of the checkerboard of each parity
+    bool hostKernel() const { return location == QUDA_CPU_FIELD_LOCATION; }
+    bool tuneHostTile() const { return true; }
+    unsigned int hostWorkItems() const { return arg.nParity * meta.VolumeCB(); }
+
   public:
     CopyColorSpinor(Arg &arg, const ColorSpinorField &out, const ColorSpinorField &in,
 		    QudaFieldLocation location)
       : TunableVectorY(arg.nParity), arg(arg), meta(in), location(location) {
       if (out.GammaBasis()!=in.GammaBasis()) errorQuda("Cannot change gamma basis for nSpin=%d\n", Ns);
       writeAuxString("out_stride=%d,in_stride=%d", arg.out.stride, arg.in.stride);
+      if (location == QUDA_CPU_FIELD_LOCATION) strcat(aux, getOmpThreadStr());
     }
     virtual ~CopyColorSpinor() { ; }
   
     void apply(const cudaStream_t &stream) {
       if (location == QUDA_CPU_FIELD_LOCATION) {
-	copyColorSpinor<FloatOut, FloatIn, Ns, Nc>(arg, PreserveBasis<Ns,Nc>());
+	TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+	HostLaunch launch(tp);
+	if (!activeTuning()) host_touch_param(tp); // host_zero() first touches new fields the same way
+	copyColorSpinor<FloatOut, FloatIn, Ns, Nc>(arg, PreserveBasis<Ns,Nc>(), tp.block.z);
       } else {
 	TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
 	copyColorSpinorKernel<FloatOut, FloatIn, Ns, Nc>
@@ -202,6 +226,11 @@ namespace quda {
     bool tuneGridDim() const { return false; } // Don't tune the grid dimensions.
     unsigned int minThreads() const { return in.VolumeCB(); }
 
+    // the CPU variant threads over tiles of the checkerboard of each parity
+    bool hostKernel() const { return location == QUDA_CPU_FIELD_LOCATION; }
+    bool tuneHostTile() const { return true; }
+    unsigned int hostWorkItems() const { return arg.nParity * in.VolumeCB(); }
+
   public:
     CopyColorSpinor(Arg &arg, const ColorSpinorField &out, const ColorSpinorField &in,
 		    QudaFieldLocation location)
@@ -220,21 +249,25 @@ namespace quda {
       } else {
 	errorQuda("Basis change from %d to %d not supported", in.GammaBasis(), out.GammaBasis());
       }
+      if (location == QUDA_CPU_FIELD_LOCATION) strcat(aux, getOmpThreadStr());
     }
     virtual ~CopyColorSpinor() { ; }
 
     void apply(const cudaStream_t &stream) {
       if (location == QUDA_CPU_FIELD_LOCATION) {
+	TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+	HostLaunch launch(tp);
+	if (!activeTuning()) host_touch_param(tp); // host_zero() first touches new fields the same way
 	if (out.GammaBasis()==in.GammaBasis()) {
-	  copyColorSpinor<FloatOut, FloatIn, Ns, Nc>(arg, PreserveBasis<Ns,Nc>());
+	  copyColorSpinor<FloatOut, FloatIn, Ns, Nc>(arg, PreserveBasis<Ns,Nc>(), tp.block.z);
 	} else if (out.GammaBasis() == QUDA_UKQCD_GAMMA_BASIS && in.GammaBasis() == QUDA_DEGRAND_ROSSI_GAMMA_BASIS) {
-	  copyColorSpinor<FloatOut, FloatIn, Ns, Nc>(arg, NonRelBasis<Ns,Nc>());
+	  copyColorSpinor<FloatOut, FloatIn, Ns, Nc>(arg, NonRelBasis<Ns,Nc>(), tp.block.z);
 	} else if (in.GammaBasis() == QUDA_UKQCD_GAMMA_BASIS && out.GammaBasis() == QUDA_DEGRAND_ROSSI_GAMMA_BASIS) {
-	  copyColorSpinor<FloatOut, FloatIn, Ns, Nc>(arg, RelBasis<Ns,Nc>());
+	  copyColorSpinor<FloatOut, FloatIn, Ns, Nc>(arg, RelBasis<Ns,Nc>(), tp.block.z);
 	} else if (out.GammaBasis() == QUDA_UKQCD_GAMMA_BASIS && in.GammaBasis() == QUDA_CHIRAL_GAMMA_BASIS) {
-	  copyColorSpinor<FloatOut, FloatIn, Ns, Nc>(arg, ChiralToNonRelBasis<Ns,Nc>());
+	  copyColorSpinor<FloatOut, FloatIn, Ns, Nc>(arg, ChiralToNonRelBasis<Ns,Nc>(), tp.block.z);
 	} else if (in.GammaBasis() == QUDA_UKQCD_GAMMA_BASIS && out.GammaBasis() == QUDA_CHIRAL_GAMMA_BASIS) {
-	  copyColorSpinor<FloatOut, FloatIn, Ns, Nc>(arg, NonRelToChiralBasis<Ns,Nc>());
+	  copyColorSpinor<FloatOut, FloatIn, Ns, Nc>(arg, NonRelToChiralBasis<Ns,Nc>(), tp.block.z);
 	}
       } else {
 	TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
@@ -23,10 +23,15 @@ namespace quda {
     unsigned int minThreads() const { return size; }
 
     bool advanceTuneParam(TuneParam &param) const {
-      // only do autotuning if we are doing the copy on the GPU
+      // host copies are tuned through advanceHostTuneParam
       return location == QUDA_CUDA_FIELD_LOCATION ? TunableVectorYZ::advanceTuneParam(param) : false;
     }
 
+    // the CPU variant threads over tiles of the checkerboard of each parity and direction
+    bool hostKernel() const { return location == QUDA_CPU_FIELD_LOCATION; }
+    bool tuneHostTile() const { return true; }
+    unsigned int hostWorkItems() const { return 2 * (is_ghost ? size : meta.Geometry() * size); }
+
 public:
     CopyGauge(Arg &arg, const GaugeField &out, const GaugeField &in, QudaFieldLocation location)
 #ifndef FINE_GRAINED_ACCESS
@@ -43,6 +48,7 @@ public:
       strcat(aux, out.AuxString());
       strcat(aux, ",in:");
       strcat(aux, in.AuxString());
+      if (location == QUDA_CPU_FIELD_LOCATION) strcat(aux, getOmpThreadStr());
 
 #ifdef FINE_GRAINED_ACCESS
       strcat(aux,",fine-grained");
@@ -82,10 +88,12 @@ public:
     void apply(const cudaStream_t &stream) {
       TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
       if (location == QUDA_CPU_FIELD_LOCATION) {
+        HostLaunch launch(tp);
+        if (!activeTuning()) host_touch_param(tp); // host_zero() first touches new fields the same way
         if (!is_ghost) {
-          copyGauge<FloatOut, FloatIn, length>(arg);
+          copyGauge<FloatOut, FloatIn, length>(arg, tp.block.z);
         } else {
-          copyGhost<FloatOut, FloatIn, length>(arg);
+          copyGhost<FloatOut, FloatIn, length>(arg, tp.block.z);
         }
       } else if (location == QUDA_CUDA_FIELD_LOCATION) {
 #ifdef JITIFY
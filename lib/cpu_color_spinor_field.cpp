@@ -27,10 +27,10 @@ namespace quda {
 
     create(param.create);
 
-    if (param.create == QUDA_NULL_FIELD_CREATE || param.create == QUDA_REFERENCE_FIELD_CREATE) {
+    if (param.create == QUDA_REFERENCE_FIELD_CREATE) {
       // do nothing
-    } else if (param.create == QUDA_ZERO_FIELD_CREATE) {
-      zero();
+    } else if (param.create == QUDA_NULL_FIELD_CREATE || param.create == QUDA_ZERO_FIELD_CREATE) {
+      zero(); // also first touches the pages of new fields as the reorder kernels visit them
     } else {
       errorQuda("Creation type %d not supported", param.create);
     }
@@ -239,8 +239,14 @@ namespace quda {
   }
 
   void cpuColorSpinorField::zero() {
-    if (fieldOrder != QUDA_QOP_DOMAIN_WALL_FIELD_ORDER) memset(v, '\0', bytes);
-    else for (int i=0; i<x[nDim-1]; i++) memset(((void**)v)[i], '\0', bytes/x[nDim-1]);
+    const int nParity = siteSubset == QUDA_FULL_SITE_SUBSET ? 2 : 1;
+    if (fieldOrder != QUDA_QOP_DOMAIN_WALL_FIELD_ORDER) {
+      void *row[] = {v, static_cast<char*>(v) + bytes / nParity};
+      host_zero(row, nParity, bytes / nParity, volumeCB);
+    } else {
+      const int Ls = x[nDim-1];
+      host_zero(static_cast<void**>(v), Ls, bytes / Ls, (size_t)nParity * volumeCB / Ls);
+    }
   }
 
   void cpuColorSpinorField::Source(QudaSourceType source_type, int x, int s, int c) {
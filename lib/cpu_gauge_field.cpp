@@ -3,6 +3,7 @@
 #include <assert.h>
 #include <string.h>
 #include <typeinfo>
+#include <vector>
 
 namespace quda {
 
@@ -48,13 +49,21 @@ namespace quda {
 	size_t nbytes = volume * nInternal * precision;
 	if (create == QUDA_NULL_FIELD_CREATE || create == QUDA_ZERO_FIELD_CREATE) {
 	  gauge[d] = safe_malloc(nbytes);
-	  if (create == QUDA_ZERO_FIELD_CREATE) memset(gauge[d], 0, nbytes);
 	} else if (create == QUDA_REFERENCE_FIELD_CREATE) {
 	  gauge[d] = ((void**)param.gauge)[d];
 	} else {
 	  errorQuda("Unsupported creation type %d", create);
 	}
       }
+
+      // first touch new fields as the reorder kernels visit them: by parity, then direction
+      if (create == QUDA_NULL_FIELD_CREATE || create == QUDA_ZERO_FIELD_CREATE) {
+	size_t nbytes = volume * nInternal * precision;
+	std::vector<void*> row(2 * siteDim);
+	for (int parity=0; parity<2; parity++)
+	  for (int d=0; d<siteDim; d++) row[parity*siteDim + d] = static_cast<char*>(gauge[d]) + parity * (nbytes / 2);
+	host_zero(row.data(), 2 * siteDim, nbytes / 2, volumeCB);
+      }
     
     } else if (order == QUDA_CPS_WILSON_GAUGE_ORDER || order == QUDA_MILC_GAUGE_ORDER  ||
 	       order == QUDA_BQCD_GAUGE_ORDER || order == QUDA_TIFR_GAUGE_ORDER ||
@@ -66,7 +75,9 @@ namespace quda {
 
       if (create == QUDA_NULL_FIELD_CREATE || create == QUDA_ZERO_FIELD_CREATE) {
 	gauge = (void **) safe_malloc(bytes);
-	if(create == QUDA_ZERO_FIELD_CREATE) memset(gauge, 0, bytes);
+	// first touch new fields by parity, as the reorder kernels visit them
+	void *row[] = {gauge, static_cast<char*>((void*)gauge) + bytes / 2};
+	host_zero(row, 2, bytes / 2, volumeCB);
       } else if (create == QUDA_REFERENCE_FIELD_CREATE) {
 	gauge = (void**) param.gauge;
       } else {
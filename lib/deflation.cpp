@@ -432,7 +432,7 @@ namespace quda {
       const int Nvec = B.size();
       printfQuda("Start saving %d vectors to %s\n", Nvec, vec_outfile.c_str());
 
-      void **V = static_cast<void**>(safe_malloc(Nvec*sizeof(void*)));
+      void **V = static_cast<void**>(arena_malloc(Nvec*sizeof(void*)));
       for (int i=0; i<Nvec; i++) {
 	V[i] = B[i]->V();
 	if (V[i] == NULL) {
@@ -50,6 +50,11 @@ namespace quda {
     bool tuneAuxDim() const { return true; } // Do tune the aux dimensions
     unsigned int minThreads() const { return color_col_stride * X.VolumeCB(); } // 4-d volume since this x threads only
 
+    // the CPU variant threads over tiles of the 4-d checkerboard of each parity
+    bool hostKernel() const { return out.Location() == QUDA_CPU_FIELD_LOCATION; }
+    bool tuneHostTile() const { return true; }
+    unsigned int hostWorkItems() const { return nParity * X.VolumeCB(); }
+
     bool advanceBlockDim(TuneParam &param) const
     {
       dim3 grid = param.grid;
@@ -194,6 +199,7 @@ namespace quda {
       strcat(aux, compile_type_str(out));
       strcat(aux, out.AuxString());
       strcat(aux, comm_dim_partitioned_string());
+      if (out.Location() == QUDA_CPU_FIELD_LOCATION) strcat(aux, getOmpThreadStr());
 
       // record the location of where each pack buffer is in [2*dim+dir] ordering
       // 0 - no packing
@@ -226,8 +232,11 @@ namespace quda {
 	if (out.FieldOrder() != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER || Y.FieldOrder() != QUDA_QDP_GAUGE_ORDER)
 	  errorQuda("Unsupported field order colorspinor=%d gauge=%d combination\n", inA.FieldOrder(), Y.FieldOrder());
 
+        const TuneParam &tp = tuneLaunch(*this, getTuning(), getVerbosity());
+        HostLaunch launch(tp);
+
 	DslashCoarseArg<Float,yFloat,ghostFloat,Ns,Nc,QUDA_SPACE_SPIN_COLOR_FIELD_ORDER,QUDA_QDP_GAUGE_ORDER> arg(out, inA, inB, Y, X, (Float)kappa, parity);
-	coarseDslash<Float,nDim,Ns,Nc,Mc,dslash,clover,dagger,type>(arg);
+	coarseDslash<Float,nDim,Ns,Nc,Mc,dslash,clover,dagger,type>(arg, tp.block.z);
       } else {
 
         const TuneParam &tp = tuneLaunch(*this, getTuning(), getVerbosity());
@@ -318,12 +327,14 @@ namespace quda {
 
     void preTune() {
       saveOut = new char[out.Bytes()];
-      cudaMemcpy(saveOut, out.V(), out.Bytes(), cudaMemcpyDeviceToHost);
+      if (out.Location() == QUDA_CPU_FIELD_LOCATION) memcpy(saveOut, out.V(), out.Bytes());
+      else cudaMemcpy(saveOut, out.V(), out.Bytes(), cudaMemcpyDeviceToHost);
     }
 
     void postTune()
     {
-      cudaMemcpy(out.V(), saveOut, out.Bytes(), cudaMemcpyHostToDevice);
+      if (out.Location() == QUDA_CPU_FIELD_LOCATION) memcpy(out.V(), saveOut, out.Bytes());
+      else cudaMemcpy(out.V(), saveOut, out.Bytes(), cudaMemcpyHostToDevice);
       delete[] saveOut;
     }
 
@@ -589,9 +600,6 @@ namespace quda {
   };
 
   // hooks into tune.cpp variables for policy tuning
-  typedef std::map<TuneKey, TuneParam> map;
-  const map& getTuneCache();
-
   void disableProfileCount();
   void enableProfileCount();
   void setPolicyTuning(bool);
@@ -770,8 +778,13 @@ namespace quda {
 
     DslashCoarseLaunch Dslash(out, inA, inB, Y, X, kappa, parity, dslash, clover, dagger, commDim, halo_precision);
 
-    DslashCoarsePolicyTune policy(Dslash);
-    policy.apply(0);
+    if (out.Location() == QUDA_CPU_FIELD_LOCATION) {
+      // the communication policies only concern device fields
+      Dslash(DslashCoarsePolicy::DSLASH_COARSE_BASIC);
+    } else {
+      DslashCoarsePolicyTune policy(Dslash);
+      policy.apply(0);
+    }
 
   }//ApplyCoarse
 
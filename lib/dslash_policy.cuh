@@ -1,9 +1,6 @@
 static cudaColorSpinorField *inSpinor;
 
 // hooks into tune.cpp variables for policy tuning
-typedef std::map<TuneKey, TuneParam> map;
-const map& getTuneCache();
-
 void disableProfileCount();
 void enableProfileCount();
 
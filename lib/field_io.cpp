@@ -0,0 +1,469 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <math.h>
+#include <chrono>
+
+#include <quda_internal.h>
+#include <comm_quda.h>
+#include <malloc_quda.h>
+#include <field_io.h>
+
+/**
+   Layout of a native field file:
+
+     [0, 512)               FileHeader
+     [512, data_offset)     BlockIndex of each rank, in rank order
+     [data_offset, ...)     one block per rank, block_stride apart
+
+   A block holds the nField fields of a rank one after another, each
+   the raw local host array at the file precision, so a block is
+   written and read with a single contiguous transfer and the per-site
+   conversion is a flat loop.  data_offset and block_stride are
+   multiples of io_align so that each block can be mapped on its own.
+
+   Spinor fields may also be stored compressed at half or quarter
+   precision, with the block-float scheme of the half-precision device
+   fields: a field is then a float norm per site, the largest absolute
+   value of its components, followed by the components as 16- or 8-bit
+   fixed-point numbers scaled by that norm, padded to a whole word.
+ */
+
+namespace quda {
+
+  namespace {
+
+    constexpr char magic[8] = {'Q', 'U', 'D', 'A', 'F', 'L', 'D', '\0'};
+    constexpr int32_t version = 1;
+    constexpr size_t header_bytes = 512;
+    constexpr size_t io_align = 1 << 16; // covers any host page size
+
+    enum FieldKind : int32_t { GAUGE_FIELD = 0, SPINOR_FIELD = 1 };
+
+    struct FileHeader {
+      char magic[8];
+      int32_t version;
+      int32_t kind;         // FieldKind
+      int32_t X[4];         // local lattice dimensions
+      int32_t grid[4];      // process grid
+      int32_t nRank;
+      int32_t nField;       // number of fields per rank
+      int32_t nColor;
+      int32_t nSpin;
+      int32_t site_reals;   // reals per site of each field
+      int32_t precision;    // bytes per real in the file, < 4 if compressed
+      uint64_t field_bytes; // bytes of each field
+      uint64_t block_bytes; // bytes of each block
+      uint64_t block_stride;
+      uint64_t data_offset;
+    };
+    static_assert(sizeof(FileHeader) <= header_bytes, "FileHeader does not fit");
+
+    struct BlockIndex {
+      uint64_t offset;
+      uint64_t bytes;
+      uint64_t checksum;
+    };
+
+    size_t round_up(size_t n, size_t align) { return ((n + align - 1) / align) * align; }
+
+    const char *precision_name(QudaPrecision prec)
+    {
+      switch (prec) {
+      case QUDA_DOUBLE_PRECISION: return "double";
+      case QUDA_SINGLE_PRECISION: return "single";
+      case QUDA_HALF_PRECISION: return "half";
+      case QUDA_QUARTER_PRECISION: return "quarter";
+      default: return "invalid";
+      }
+    }
+
+    size_t volume(const FileHeader &header)
+    {
+      size_t volume = 1;
+      for (int d = 0; d < 4; d++) volume *= header.X[d];
+      return volume;
+    }
+
+    /**
+       @brief splitmix64 finalizer (as used by the gauge checksum)
+    */
+    inline uint64_t mix64(uint64_t z)
+    {
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+      return z ^ (z >> 31);
+    }
+
+    /**
+       @brief Checksum of bytes words of data that start at word
+       position offset of the block.  Each word is mixed with its
+       position and the results XORed, so the checksums of consecutive
+       pieces of a block XOR to the checksum of the block.
+    */
+    uint64_t checksum(const void *data, size_t bytes, uint64_t offset)
+    {
+      const uint64_t *word = static_cast<const uint64_t *>(data);
+      const long n = bytes / sizeof(uint64_t);
+      uint64_t sum = 0;
+#pragma omp parallel for reduction(^:sum)
+      for (long i = 0; i < n; i++) sum ^= mix64(word[i] ^ mix64(offset + i));
+      return sum;
+    }
+
+    template <typename out_t, typename in_t> void convert(out_t *out, const in_t *in, size_t n)
+    {
+#pragma omp parallel for
+      for (long i = 0; i < static_cast<long>(n); i++) out[i] = static_cast<out_t>(in[i]);
+    }
+
+    /**
+       @brief Compress a field into the block-float file layout,
+       accumulating the squared error of the compression and the
+       squared norm of the field
+    */
+    template <typename storeFloat, typename Float>
+    void compress(void *out, const Float *in, size_t volume, int site_reals, double &err2, double &norm2)
+    {
+      float *norm = static_cast<float *>(out);
+      storeFloat *v = reinterpret_cast<storeFloat *>(norm + volume);
+      const Float max = fixedMaxValue<storeFloat>::value;
+      double err2_ = 0.0, norm2_ = 0.0;
+#pragma omp parallel for reduction(+:err2_, norm2_)
+      for (long x = 0; x < static_cast<long>(volume); x++) {
+        const Float *in_x = in + x * site_reals;
+        storeFloat *v_x = v + x * site_reals;
+        Float m = 0.0;
+        for (int i = 0; i < site_reals; i++) m = fabs(in_x[i]) > m ? fabs(in_x[i]) : m;
+        norm[x] = m;
+        const Float scale = norm[x] > 0 ? max / norm[x] : 0.0;
+        const Float scale_inv = norm[x] / max;
+        for (int i = 0; i < site_reals; i++) {
+          v_x[i] = static_cast<storeFloat>(round(scale * in_x[i]));
+          const double e = scale_inv * v_x[i] - in_x[i];
+          err2_ += e * e;
+          norm2_ += static_cast<double>(in_x[i]) * in_x[i];
+        }
+      }
+      err2 += err2_;
+      norm2 += norm2_;
+    }
+
+    template <typename Float, typename storeFloat>
+    void decompress(Float *out, const void *in, size_t volume, int site_reals)
+    {
+      const float *norm = static_cast<const float *>(in);
+      const storeFloat *v = reinterpret_cast<const storeFloat *>(norm + volume);
+      const Float max_inv = 1.0 / fixedMaxValue<storeFloat>::value;
+#pragma omp parallel for
+      for (long x = 0; x < static_cast<long>(volume); x++) {
+        const Float scale_inv = norm[x] * max_inv;
+        for (int i = 0; i < site_reals; i++) out[x * site_reals + i] = scale_inv * v[x * site_reals + i];
+      }
+    }
+
+    /**
+       @brief Convert a host field of precision prec into the file
+       layout of precision file_prec
+    */
+    template <typename Float>
+    void pack(void *out, QudaPrecision file_prec, const Float *in, const FileHeader &header, double &err2, double &norm2)
+    {
+      const size_t n = volume(header) * header.site_reals;
+      switch (file_prec) {
+      case QUDA_DOUBLE_PRECISION: convert(static_cast<double *>(out), in, n); break;
+      case QUDA_SINGLE_PRECISION: convert(static_cast<float *>(out), in, n); break;
+      case QUDA_HALF_PRECISION: compress<short>(out, in, volume(header), header.site_reals, err2, norm2); break;
+      case QUDA_QUARTER_PRECISION: compress<char>(out, in, volume(header), header.site_reals, err2, norm2); break;
+      default: errorQuda("Unsupported file precision %d", file_prec);
+      }
+    }
+
+    void pack(void *out, QudaPrecision file_prec, const void *in, QudaPrecision prec, const FileHeader &header,
+              double &err2, double &norm2)
+    {
+      if (prec == QUDA_DOUBLE_PRECISION) pack(out, file_prec, static_cast<const double *>(in), header, err2, norm2);
+      else pack(out, file_prec, static_cast<const float *>(in), header, err2, norm2);
+    }
+
+    /**
+       @brief Convert a field in the file layout of precision file_prec
+       into a host field of precision prec
+    */
+    template <typename Float>
+    void unpack(Float *out, const void *in, QudaPrecision file_prec, const FileHeader &header)
+    {
+      const size_t n = volume(header) * header.site_reals;
+      switch (file_prec) {
+      case QUDA_DOUBLE_PRECISION: convert(out, static_cast<const double *>(in), n); break;
+      case QUDA_SINGLE_PRECISION: convert(out, static_cast<const float *>(in), n); break;
+      case QUDA_HALF_PRECISION: decompress<Float, short>(out, in, volume(header), header.site_reals); break;
+      case QUDA_QUARTER_PRECISION: decompress<Float, char>(out, in, volume(header), header.site_reals); break;
+      default: errorQuda("Unsupported file precision %d", file_prec);
+      }
+    }
+
+    void unpack(void *out, QudaPrecision prec, const void *in, QudaPrecision file_prec, const FileHeader &header)
+    {
+      if (prec == file_prec) memcpy(out, in, header.field_bytes);
+      else if (prec == QUDA_DOUBLE_PRECISION) unpack(static_cast<double *>(out), in, file_prec, header);
+      else unpack(static_cast<float *>(out), in, file_prec, header);
+    }
+
+    void check_precision(QudaPrecision prec, bool compressed = false)
+    {
+      if (prec == QUDA_DOUBLE_PRECISION || prec == QUDA_SINGLE_PRECISION) return;
+      if (compressed && (prec == QUDA_HALF_PRECISION || prec == QUDA_QUARTER_PRECISION)) return;
+      errorQuda("Precision %d not supported by native field I/O", prec);
+    }
+
+    void write_all(int fd, const void *buf, size_t bytes, size_t offset, const char *filename)
+    {
+      const char *p = static_cast<const char *>(buf);
+      while (bytes > 0) {
+        ssize_t n = pwrite(fd, p, bytes, offset);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) errorQuda("pwrite to %s failed: %s", filename, strerror(errno));
+        p += n;
+        bytes -= n;
+        offset += n;
+      }
+    }
+
+    void read_all(int fd, void *buf, size_t bytes, size_t offset, const char *filename)
+    {
+      char *p = static_cast<char *>(buf);
+      while (bytes > 0) {
+        ssize_t n = pread(fd, p, bytes, offset);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) errorQuda("pread from %s failed: %s", filename, n < 0 ? strerror(errno) : "unexpected end of file");
+        p += n;
+        bytes -= n;
+        offset += n;
+      }
+    }
+
+    FileHeader make_header(FieldKind kind, const int *X, int nField, int nColor, int nSpin, int site_reals,
+                           QudaPrecision file_prec)
+    {
+      FileHeader header;
+      memset(&header, 0, sizeof(header));
+      memcpy(header.magic, magic, sizeof(magic));
+      header.version = version;
+      header.kind = kind;
+      size_t volume = 1;
+      for (int d = 0; d < 4; d++) {
+        header.X[d] = X[d];
+        header.grid[d] = comm_dim(d);
+        volume *= X[d];
+      }
+      header.nRank = comm_size();
+      header.nField = nField;
+      header.nColor = nColor;
+      header.nSpin = nSpin;
+      header.site_reals = site_reals;
+      header.precision = file_prec;
+      header.field_bytes = file_prec >= QUDA_SINGLE_PRECISION ?
+        volume * site_reals * file_prec :
+        round_up(volume * (sizeof(float) + site_reals * file_prec), sizeof(uint64_t));
+      header.block_bytes = header.field_bytes * nField;
+      header.block_stride = round_up(header.block_bytes, io_align);
+      header.data_offset = round_up(header_bytes + header.nRank * sizeof(BlockIndex), io_align);
+      return header;
+    }
+
+    /**
+       @brief Write nField host fields of this rank.  Rank 0 creates
+       the file and writes the header; after a barrier every rank
+       writes its block and its index entry with pwrite.
+    */
+    void write_fields(const char *filename, const FileHeader &header, void *field[], QudaPrecision prec)
+    {
+      auto start = std::chrono::steady_clock::now();
+      const QudaPrecision file_prec = static_cast<QudaPrecision>(header.precision);
+      if (header.field_bytes % sizeof(uint64_t)) errorQuda("Field of %lu bytes is not a whole number of words", header.field_bytes);
+
+      if (comm_rank() == 0) {
+        int fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) errorQuda("Cannot create %s: %s", filename, strerror(errno));
+        char buf[header_bytes] = {};
+        memcpy(buf, &header, sizeof(header));
+        write_all(fd, buf, header_bytes, 0, filename);
+        if (ftruncate(fd, header.data_offset + header.nRank * header.block_stride) != 0)
+          errorQuda("Cannot size %s: %s", filename, strerror(errno));
+        close(fd);
+      }
+      comm_barrier();
+
+      int fd = open(filename, O_WRONLY);
+      if (fd < 0) errorQuda("Cannot open %s: %s", filename, strerror(errno));
+
+      BlockIndex index;
+      index.offset = header.data_offset + comm_rank() * header.block_stride;
+      index.bytes = header.block_bytes;
+      index.checksum = 0;
+
+      void *buffer = nullptr;
+      if (file_prec != prec) {
+        buffer = arena_malloc(header.field_bytes);
+        memset(buffer, 0, header.field_bytes); // zero any padding of a compressed field
+      }
+      double err[2] = {0.0, 0.0}; // squared compression error and squared norm
+      for (int i = 0; i < header.nField; i++) {
+        const void *data = field[i];
+        if (buffer) {
+          pack(buffer, file_prec, field[i], prec, header, err[0], err[1]);
+          data = buffer;
+        }
+        index.checksum ^= checksum(data, header.field_bytes, i * header.field_bytes / sizeof(uint64_t));
+        write_all(fd, data, header.field_bytes, index.offset + i * header.field_bytes, filename);
+      }
+      if (buffer) host_free(buffer);
+
+      write_all(fd, &index, sizeof(index), header_bytes + comm_rank() * sizeof(BlockIndex), filename);
+      if (close(fd) != 0) errorQuda("Error closing %s: %s", filename, strerror(errno));
+      comm_barrier();
+
+      double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      if (getVerbosity() >= QUDA_SUMMARIZE)
+        printfQuda("Wrote %d fields to %s at %s precision (%.3g GB/s per rank)\n", header.nField, filename,
+                   precision_name(file_prec), 1e-9 * header.block_bytes / secs);
+
+      if (file_prec < QUDA_SINGLE_PRECISION) {
+        comm_allreduce_array(err, 2);
+        if (getVerbosity() >= QUDA_SUMMARIZE)
+          printfQuda("Compressed %s by %.3g with relative L2 error %e\n", filename,
+                     static_cast<double>(volume(header) * header.site_reals * prec) / header.field_bytes,
+                     err[1] > 0.0 ? sqrt(err[0] / err[1]) : 0.0);
+      }
+    }
+
+    /**
+       @brief Read the first nField fields of the block of this rank,
+       after validating the header against the expected one.  The
+       block is mapped into memory, its checksum verified and the
+       fields converted straight from the mapping into the host arrays.
+    */
+    void read_fields(const char *filename, const FileHeader &expected, int nField, void *field[], QudaPrecision prec)
+    {
+      auto start = std::chrono::steady_clock::now();
+
+      int fd = open(filename, O_RDONLY);
+      if (fd < 0) errorQuda("Cannot open %s: %s", filename, strerror(errno));
+
+      FileHeader header;
+      read_all(fd, &header, sizeof(header), 0, filename);
+      if (memcmp(header.magic, magic, sizeof(magic)) != 0) errorQuda("%s is not a native field file", filename);
+      if (header.version != version) errorQuda("%s has version %d, expected %d", filename, header.version, version);
+      if (header.kind != expected.kind) errorQuda("%s holds a different kind of field", filename);
+      for (int d = 0; d < 4; d++) {
+        if (header.X[d] != expected.X[d] || header.grid[d] != expected.grid[d])
+          errorQuda("%s was written with local lattice %dx%dx%dx%d on grid %dx%dx%dx%d, expected %dx%dx%dx%d on %dx%dx%dx%d",
+                    filename, header.X[0], header.X[1], header.X[2], header.X[3], header.grid[0], header.grid[1],
+                    header.grid[2], header.grid[3], expected.X[0], expected.X[1], expected.X[2], expected.X[3],
+                    expected.grid[0], expected.grid[1], expected.grid[2], expected.grid[3]);
+      }
+      if (header.nColor != expected.nColor || header.nSpin != expected.nSpin || header.site_reals != expected.site_reals)
+        errorQuda("%s has nColor=%d nSpin=%d, expected nColor=%d nSpin=%d", filename, header.nColor, header.nSpin,
+                  expected.nColor, expected.nSpin);
+      if (header.nRank != expected.nRank) errorQuda("%s was written by %d ranks, expected %d", filename, header.nRank, expected.nRank);
+      if (header.nField < nField) errorQuda("%s holds %d fields, requested %d", filename, header.nField, nField);
+      const QudaPrecision file_prec = static_cast<QudaPrecision>(header.precision);
+      check_precision(file_prec, header.kind == SPINOR_FIELD);
+
+      BlockIndex index;
+      read_all(fd, &index, sizeof(index), header_bytes + comm_rank() * sizeof(BlockIndex), filename);
+      if (index.bytes != header.block_bytes || index.offset % io_align)
+        errorQuda("%s has a corrupt index entry for rank %d", filename, comm_rank());
+
+      void *block = mmap(nullptr, index.bytes, PROT_READ, MAP_PRIVATE, fd, index.offset);
+      if (block == MAP_FAILED) errorQuda("Cannot map %s: %s", filename, strerror(errno));
+      madvise(block, index.bytes, MADV_WILLNEED);
+      madvise(block, index.bytes, MADV_SEQUENTIAL);
+      close(fd);
+
+      uint64_t sum = checksum(block, index.bytes, 0);
+      if (sum != index.checksum)
+        errorQuda("Checksum mismatch on rank %d of %s: computed %#016lx, expected %#016lx", comm_rank(), filename, sum,
+                  index.checksum);
+
+      for (int i = 0; i < nField; i++)
+        unpack(field[i], prec, static_cast<const char *>(block) + i * header.field_bytes, file_prec, header);
+      munmap(block, index.bytes);
+      comm_barrier();
+
+      double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      if (getVerbosity() >= QUDA_SUMMARIZE)
+        printfQuda("Read %d fields from %s (%.3g GB/s per rank)\n", nField, filename,
+                   1e-9 * nField * header.field_bytes / secs);
+      if (file_prec < QUDA_SINGLE_PRECISION && getVerbosity() >= QUDA_VERBOSE)
+        printfQuda("Decompressed %s from %s precision\n", filename, precision_name(file_prec));
+    }
+
+  } // anonymous namespace
+
+  bool is_native_field_file(const char *filename)
+  {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) return false;
+    char buf[sizeof(magic)];
+    bool native = pread(fd, buf, sizeof(buf), 0) == sizeof(buf) && memcmp(buf, magic, sizeof(magic)) == 0;
+    close(fd);
+    return native;
+  }
+
+  QudaPrecision native_field_io_precision(QudaPrecision prec, bool compress)
+  {
+    const char *io_prec = getenv("QUDA_FIELD_IO_PRECISION");
+    if (!io_prec) return prec;
+
+    QudaPrecision file_prec = QUDA_INVALID_PRECISION;
+    if (strcmp(io_prec, "double") == 0) file_prec = QUDA_DOUBLE_PRECISION;
+    else if (strcmp(io_prec, "single") == 0) file_prec = QUDA_SINGLE_PRECISION;
+    else if (strcmp(io_prec, "half") == 0) file_prec = QUDA_HALF_PRECISION;
+    else if (strcmp(io_prec, "quarter") == 0) file_prec = QUDA_QUARTER_PRECISION;
+    else errorQuda("QUDA_FIELD_IO_PRECISION=%s not recognized", io_prec);
+
+    if (!compress && file_prec < QUDA_SINGLE_PRECISION) file_prec = QUDA_SINGLE_PRECISION;
+    return file_prec < prec ? file_prec : prec;
+  }
+
+  void read_gauge_field_native(const char *filename, void *gauge[], QudaPrecision prec, const int *X)
+  {
+    check_precision(prec);
+    FileHeader expected = make_header(GAUGE_FIELD, X, 4, 3, 1, 18, prec);
+    read_fields(filename, expected, 4, gauge, prec);
+  }
+
+  void write_gauge_field_native(const char *filename, void *gauge[], QudaPrecision prec, const int *X,
+                                QudaPrecision file_prec)
+  {
+    check_precision(prec);
+    check_precision(file_prec);
+    FileHeader header = make_header(GAUGE_FIELD, X, 4, 3, 1, 18, file_prec);
+    write_fields(filename, header, gauge, prec);
+  }
+
+  void read_spinor_field_native(const char *filename, void *V[], QudaPrecision prec, const int *X, int nColor,
+                                int nSpin, int Nvec)
+  {
+    check_precision(prec);
+    FileHeader expected = make_header(SPINOR_FIELD, X, Nvec, nColor, nSpin, 2 * nSpin * nColor, prec);
+    read_fields(filename, expected, Nvec, V, prec);
+  }
+
+  void write_spinor_field_native(const char *filename, void *V[], QudaPrecision prec, const int *X, int nColor,
+                                 int nSpin, int Nvec, QudaPrecision file_prec)
+  {
+    check_precision(prec);
+    check_precision(file_prec, true);
+    FileHeader header = make_header(SPINOR_FIELD, X, Nvec, nColor, nSpin, 2 * nSpin * nColor, file_prec);
+    write_fields(filename, header, V, prec);
+  }
+
+} // namespace quda
@@ -27,12 +27,14 @@ namespace quda {
   };
 
   template <int mu, int nu, typename Float, typename Arg>
-  __device__ __forceinline__ void computeFmunuCore(Arg &arg, int idx, int parity) {
+  __host__ __device__ __forceinline__ void computeFmunuCore(Arg &arg, int idx, int parity) {
 
       typedef Matrix<complex<Float>,3> Link;
 
+      // local copy since the host threads share arg
       int x[4];
-      auto &X = arg.X;
+      int X[4];
+      for (int dir=0; dir<4; ++dir) X[dir] = arg.X[dir];
 
       getCoords(x, idx, X, parity);
       for (int dir=0; dir<4; ++dir) {
@@ -186,6 +188,7 @@ namespace quda {
   
   template<typename Float, typename Arg>
   void computeFmunuCPU(Arg &arg) {
+#pragma omp parallel for collapse(2) schedule(runtime)
     for (int parity=0; parity<2; parity++) {
       for (int x_cb=0; x_cb<arg.threads; x_cb++) {
 	for (int mu=0; mu<4; mu++) {
@@ -216,18 +219,24 @@ namespace quda {
       unsigned int minThreads() const { return arg.threads; }
       bool tuneGridDim() const { return false; }
 
+      // the CPU variant threads over the sites of both parities
+      bool hostKernel() const { return location == QUDA_CPU_FIELD_LOCATION; }
+      unsigned int hostWorkItems() const { return 2 * arg.threads; }
+
     public:
       FmunuCompute(Arg &arg, const GaugeField &meta, QudaFieldLocation location)
         : TunableVectorYZ(2,6), arg(arg), meta(meta), location(location) {
 	writeAuxString("threads=%d,stride=%d,prec=%lu",arg.threads,meta.Stride(),sizeof(Float));
+	if (location == QUDA_CPU_FIELD_LOCATION) strcat(aux, getOmpThreadStr());
       }
       virtual ~FmunuCompute() {}
 
       void apply(const cudaStream_t &stream){
+        TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
         if (location == QUDA_CUDA_FIELD_LOCATION) {
-          TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
           computeFmunuKernel<Float><<<tp.grid,tp.block,tp.shared_bytes>>>(arg);
         } else {
+          HostLaunch launch(tp);
           computeFmunuCPU<Float>(arg);
         }
       }
@@ -247,13 +256,27 @@ namespace quda {
     FmunuArg<Float,Fmunu,Gauge> arg(f_munu, gauge, meta, meta_ex);
     FmunuCompute<Float,FmunuArg<Float,Fmunu,Gauge> > fmunuCompute(arg, meta, location);
     fmunuCompute.apply(0);
-    qudaDeviceSynchronize();
+    if (location == QUDA_CUDA_FIELD_LOCATION) qudaDeviceSynchronize();
     checkCudaError();
   }
 
   template<typename Float>
   void computeFmunu(GaugeField &Fmunu, const GaugeField &gauge, QudaFieldLocation location) {
-    if (Fmunu.Order() == QUDA_FLOAT2_GAUGE_ORDER) {
+    if (location == QUDA_CPU_FIELD_LOCATION) {
+      // host fields are only supported in the legacy no-reconstruct orders
+      if (Fmunu.Order() != gauge.Order())
+	errorQuda("Fmunu order %d and gauge order %d must match on the host", Fmunu.Order(), gauge.Order());
+
+      if (gauge.Order() == QUDA_QDP_GAUGE_ORDER) {
+	typedef gauge::QDPOrder<Float,18> G;
+	computeFmunu<Float>(G(Fmunu), G(gauge), Fmunu, gauge, location);
+      } else if (gauge.Order() == QUDA_MILC_GAUGE_ORDER) {
+	typedef gauge::MILCOrder<Float,18> G;
+	computeFmunu<Float>(G(Fmunu), G(gauge), Fmunu, gauge, location);
+      } else {
+	errorQuda("Order %d not supported on the host", gauge.Order());
+      }
+    } else if (Fmunu.Order() == QUDA_FLOAT2_GAUGE_ORDER) {
       if (gauge.isNative()) {
 	typedef gauge::FloatNOrder<Float, 18, 2, 18> F;
 
@@ -286,6 +309,10 @@ namespace quda {
     if (Fmunu.Precision() != gauge.Precision()) {
       errorQuda("Fmunu precision %d must match gauge precision %d", Fmunu.Precision(), gauge.Precision());
     }
+
+    if (Fmunu.Location() != location || gauge.Location() != location) {
+      errorQuda("Fmunu location %d and gauge location %d must match location %d", Fmunu.Location(), gauge.Location(), location);
+    }
     
     if (gauge.Precision() == QUDA_DOUBLE_PRECISION){
       computeFmunu<double>(Fmunu, gauge, location);
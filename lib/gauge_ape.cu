@@ -99,13 +99,8 @@ namespace quda {
   }
     
   template<typename Float, typename GaugeOr, typename GaugeDs>
-  __global__ void computeAPEStep(GaugeAPEArg<Float,GaugeOr,GaugeDs> arg){
-      
-    int idx = threadIdx.x + blockIdx.x*blockDim.x;
-    int parity = threadIdx.y + blockIdx.y*blockDim.y;
-    int dir = threadIdx.z + blockIdx.z*blockDim.z;
-    if (idx >= arg.threads) return;
-    if (dir >= 3) return;
+  __host__ __device__ inline void computeAPEStepSite(GaugeAPEArg<Float,GaugeOr,GaugeDs> &arg, int idx, int parity, int dir){
+
     typedef complex<Float> Complex;
     typedef Matrix<complex<Float>,3> Link;
     
@@ -139,6 +134,27 @@ namespace quda {
       arg.dest(dir, linkIndexShift(x,dx,X), parity) = U;
     }
   }
+
+  template<typename Float, typename GaugeOr, typename GaugeDs>
+  __global__ void computeAPEStep(GaugeAPEArg<Float,GaugeOr,GaugeDs> arg){
+
+    int idx = threadIdx.x + blockIdx.x*blockDim.x;
+    int parity = threadIdx.y + blockIdx.y*blockDim.y;
+    int dir = threadIdx.z + blockIdx.z*blockDim.z;
+    if (idx >= arg.threads) return;
+    if (dir >= 3) return;
+    computeAPEStepSite(arg, idx, parity, dir);
+  }
+
+  template<typename Float, typename GaugeOr, typename GaugeDs>
+  void computeAPEStepCPU(GaugeAPEArg<Float,GaugeOr,GaugeDs> &arg){
+#pragma omp parallel for collapse(2) schedule(runtime)
+    for (int parity=0; parity<2; parity++) {
+      for (int idx=0; idx<arg.threads; idx++) {
+	for (int dir=0; dir<3; dir++) computeAPEStepSite(arg, idx, parity, dir);
+      }
+    }
+  }
   
   template<typename Float, typename GaugeOr, typename GaugeDs>
   class GaugeAPE : TunableVectorYZ {
@@ -148,6 +164,10 @@ namespace quda {
     private:
     bool tuneGridDim() const { return false; } // Don't tune the grid dimensions.
     unsigned int minThreads() const { return arg.threads; }
+
+    // the CPU variant threads over the sites of both parities
+    bool hostKernel() const { return meta.Location() == QUDA_CPU_FIELD_LOCATION; }
+    unsigned int hostWorkItems() const { return 2 * arg.threads; }
     
     public:
   // (2,3) --- 2 for parity in the y thread dim, 3 corresponds to mapping direction to the z thread dim
@@ -156,18 +176,19 @@ namespace quda {
     virtual ~GaugeAPE () {}
     
     void apply(const cudaStream_t &stream){
+      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
       if (meta.Location() == QUDA_CUDA_FIELD_LOCATION) {
-	TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
 	computeAPEStep<<<tp.grid,tp.block,tp.shared_bytes>>>(arg);
       } else {
-	errorQuda("CPU not supported yet\n");
-	//computeAPEStepCPU(arg);
+	HostLaunch launch(tp);
+	computeAPEStepCPU(arg);
       }
     }
     
     TuneKey tuneKey() const {
       std::stringstream aux;
       aux << "threads=" << arg.threads << ",prec="  << sizeof(Float);
+      if (meta.Location() == QUDA_CPU_FIELD_LOCATION) aux << getOmpThreadStr();
       return TuneKey(meta.VolString(), typeid(*this).name(), aux.str().c_str());
     }
 
@@ -180,13 +201,27 @@ namespace quda {
     GaugeAPEArg<Float,GaugeOr,GaugeDs> arg(origin, dest, dataOr, alpha, dataOr.Precision() == QUDA_DOUBLE_PRECISION ? DOUBLE_TOL : SINGLE_TOL);
     GaugeAPE<Float,GaugeOr,GaugeDs> gaugeAPE(arg,dataOr);
     gaugeAPE.apply(0);
-    qudaDeviceSynchronize();
+    if (dataOr.Location() == QUDA_CUDA_FIELD_LOCATION) qudaDeviceSynchronize();
   }
 
   template<typename Float>
     void APEStep(GaugeField &dataDs, const GaugeField& dataOr, Float alpha) {
-    
-    if(dataDs.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+
+    if (dataDs.Location() == QUDA_CPU_FIELD_LOCATION) {
+      // host fields are only smeared in the legacy no-reconstruct orders
+      if (dataDs.Order() != dataOr.Order())
+	errorQuda("Origin order %d and destination order %d must match on the host", dataOr.Order(), dataDs.Order());
+
+      if (dataDs.Order() == QUDA_QDP_GAUGE_ORDER) {
+	typedef typename gauge::QDPOrder<Float,18> G;
+	APEStep(G(dataOr), G(dataDs), dataOr, alpha);
+      } else if (dataDs.Order() == QUDA_MILC_GAUGE_ORDER) {
+	typedef typename gauge::MILCOrder<Float,18> G;
+	APEStep(G(dataOr), G(dataDs), dataOr, alpha);
+      } else {
+	errorQuda("Order %d not supported on the host", dataDs.Order());
+      }
+    } else if(dataDs.Reconstruct() == QUDA_RECONSTRUCT_NO) {
       typedef typename gauge_mapper<Float,QUDA_RECONSTRUCT_NO>::type GDs;
 
       if(dataOr.Reconstruct() == QUDA_RECONSTRUCT_NO) {
@@ -249,11 +284,17 @@ namespace quda {
       errorQuda("Half precision not supported\n");
     }
 
-    if (!dataOr.isNative())
-      errorQuda("Order %d with %d reconstruct not supported", dataOr.Order(), dataOr.Reconstruct());
+    if (dataOr.Location() != dataDs.Location()) {
+      errorQuda("Origin and destination fields must have the same location\n");
+    }
+
+    if (dataDs.Location() == QUDA_CUDA_FIELD_LOCATION) {
+      if (!dataOr.isNative())
+	errorQuda("Order %d with %d reconstruct not supported", dataOr.Order(), dataOr.Reconstruct());
 
-    if (!dataDs.isNative())
-      errorQuda("Order %d with %d reconstruct not supported", dataDs.Order(), dataDs.Reconstruct());
+      if (!dataDs.isNative())
+	errorQuda("Order %d with %d reconstruct not supported", dataDs.Order(), dataDs.Reconstruct());
+    }
 
     if (dataDs.Precision() == QUDA_SINGLE_PRECISION){
       APEStep<float>(dataDs, dataOr, (float) alpha);
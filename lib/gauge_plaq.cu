@@ -1,6 +1,7 @@
 #include <tune_quda.h>
 #include <gauge_field.h>
 #include <jitify_helper.cuh>
+#include <blas_helper.cuh>
 #include <kernels/gauge_plaq.cuh>
 
 namespace quda {
@@ -14,6 +15,10 @@ namespace quda {
   private:
     bool tuneGridDim() const { return true; }
 
+    // the CPU variant threads over fixed-size blocks of sites
+    bool hostKernel() const { return meta.Location() == QUDA_CPU_FIELD_LOCATION; }
+    unsigned int hostWorkItems() const { return blas::hostReduceBlocks(arg.threads, 2); }
+
   public:
     GaugePlaq(GaugePlaqArg<Gauge> &arg, const GaugeField &meta)
       : TunableLocalParity(), arg(arg), meta(meta) {
@@ -21,14 +26,15 @@ namespace quda {
       create_jitify_program("kernels/gauge_plaq.cuh");
 #endif
       strcpy(aux,compile_type_str(meta));
+      if (meta.Location() == QUDA_CPU_FIELD_LOCATION) strcat(aux, getOmpThreadStr());
     }
 
     ~GaugePlaq () { }
 
     void apply(const cudaStream_t &stream){
+      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
       if (meta.Location() == QUDA_CUDA_FIELD_LOCATION){
 	for (int i=0; i<2; i++) ((double*)arg.result_h)[i] = 0.0;
-	TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
 #ifdef JITIFY
         using namespace jitify::reflection;
         jitify_error = program->kernel("quda::computePlaq")
@@ -38,7 +44,9 @@ namespace quda {
 	LAUNCH_KERNEL_LOCAL_PARITY(computePlaq, tp, stream, arg, Float, Gauge);
 #endif
       } else {
-	errorQuda("CPU not supported yet\n");
+	HostLaunch launch(tp);
+	arg.result_h[0] = blas::hostReduce<double2>([&](int parity, int idx) { return plaquetteSite<Float>(arg, idx, parity); },
+						    arg.threads);
       }
     }
 
@@ -52,14 +60,25 @@ namespace quda {
     GaugePlaqArg<Gauge> arg(dataOr, data);
     GaugePlaq<Float,Gauge> gaugePlaq(arg, data);
     gaugePlaq.apply(0);
-    qudaDeviceSynchronize();
+    if (data.Location() == QUDA_CUDA_FIELD_LOCATION) qudaDeviceSynchronize();
     comm_allreduce_array((double*)arg.result_h, 2);
     for (int i=0; i<2; i++) ((double*)&plq)[i] = ((double*)arg.result_h)[i] / (9.*2*arg.threads*comm_size());
   }
 
   template<typename Float>
   void plaquette(const GaugeField& data, double2 &plq, QudaFieldLocation location) {
-    INSTANTIATE_RECONSTRUCT(plaquette<Float>, data, plq, location);
+    if (data.Location() == QUDA_CPU_FIELD_LOCATION) {
+      // host fields are measured in the legacy no-reconstruct orders
+      if (data.Order() == QUDA_QDP_GAUGE_ORDER) {
+	plaquette<Float>(gauge::QDPOrder<Float,18>(data), data, plq, location);
+      } else if (data.Order() == QUDA_MILC_GAUGE_ORDER) {
+	plaquette<Float>(gauge::MILCOrder<Float,18>(data), data, plq, location);
+      } else {
+	errorQuda("Order %d not supported on the host", data.Order());
+      }
+    } else {
+      INSTANTIATE_RECONSTRUCT(plaquette<Float>, data, plq, location);
+    }
   }
 
   double3 plaquette(const GaugeField& data, QudaFieldLocation location) {
@@ -33,12 +33,14 @@ namespace quda {
 	R += border[dir];
       }
       threads = X[0]*X[1]*X[2]*X[3]/2;
+      if (rngstate.VolumeCB() != threads)
+        errorQuda("RNG volume %d does not match gauge field volume %d", rngstate.VolumeCB(), threads);
     }
   };
 
 
   template<typename Float>
-  __device__ __host__  Matrix<complex<Float>,3> genGaussSU3(cuRNGState &localState){
+  __device__ __host__  Matrix<complex<Float>,3> genGaussSU3(PhiloxState &localState){
        Matrix<complex<Float>, 3> ret;
 	       //ret(i,j) = 0.0;
 	       //ret(i,j) = complex<Float>( (Float)(Random<Float>(localState) - 0.5), (Float)(Random<Float>(localState) - 0.5) );
@@ -75,30 +77,42 @@ namespace quda {
   }
 
 
+  /**
+     Generate the links of a site.  Each link draws from its own
+     Philox stream, keyed on the global site and the direction, so
+     the field is independent of the partitioning.
+  */
   template<typename Float, typename Gauge>
-  __global__ void computeGenGauss(GaugeGaussArg<Gauge> arg){
+  __device__ __host__ inline void genGaussSite(GaugeGaussArg<Gauge> &arg, int idx, int parity){
     typedef Matrix<complex<Float>,3> Link;
-    int idx = threadIdx.x + blockIdx.x*blockDim.x;
-    int parity = threadIdx.y + blockIdx.y*blockDim.y;
 
-    typedef Matrix<complex<Float>,3> Link;
+    int x[4];
+    getCoords(x, idx, arg.X, parity);
 
+    for(int mu = 0; mu < 4; mu++){
+      PhiloxState localState = arg.rngstate.State(x, mu, 4);
+      Link U = genGaussSU3<Float>(localState);
 
-    if(idx < arg.threads) {
-	int x[4];
-	getCoords(x, idx, arg.X, parity);
-	for (int dr=0; dr<4; ++dr) x[dr] += arg.border[dr]; // extended grid coordinates
+      int xe[4];
+      for (int dr=0; dr<4; ++dr) xe[dr] = x[dr] + arg.border[dr]; // extended grid coordinates
+      arg.dataDs.save((Float*)(U.data), linkIndex(xe,arg.E), mu, parity);
+    }
+  }
 
-	int dx[4] = {0, 0, 0, 0};
-	for(int mu = 0; mu < 4; mu++){
-	    cuRNGState localState = arg.rngstate.State()[idx + parity*arg.threads];
 
-	    Link U = genGaussSU3<Float>(localState);
+  template<typename Float, typename Gauge>
+  __global__ void computeGenGauss(GaugeGaussArg<Gauge> arg){
+    int idx = threadIdx.x + blockIdx.x*blockDim.x;
+    int parity = threadIdx.y + blockIdx.y*blockDim.y;
 
-	    arg.rngstate.State()[ idx + parity*arg.threads ] = localState;
-	    arg.dataDs(mu, linkIndexShift(x,dx,arg.X), parity) = U;
-	}
+    if(idx < arg.threads) genGaussSite<Float>(arg, idx, parity);
+  }
 
+  template<typename Float, typename Gauge>
+  void computeGenGaussCPU(GaugeGaussArg<Gauge> &arg){
+#pragma omp parallel for collapse(2) schedule(runtime)
+    for (int parity=0; parity<2; parity++) {
+      for (int idx=0; idx<arg.threads; idx++) genGaussSite<Float>(arg, idx, parity);
     }
   }
 
@@ -111,19 +125,23 @@ namespace quda {
       unsigned int minThreads() const { return arg.threads; }
       bool tuneGridDim() const { return false; } // Don't tune the grid dimensions.
 
+      // the CPU variant threads over the sites of both parities
+      bool hostKernel() const { return gf.Location() == QUDA_CPU_FIELD_LOCATION; }
+      unsigned int hostWorkItems() const { return 2 * arg.threads; }
+
       public:
       GaugeGauss(GaugeGaussArg<Gauge> &arg, GaugeField &gf)
         : TunableVectorY(2), arg(arg), gf(gf){}
       ~GaugeGauss () { }
 
       void apply(const cudaStream_t &stream){
+        TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
         if(gf.Location() == QUDA_CUDA_FIELD_LOCATION){
-          TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
-
           computeGenGauss<Float><<<tp.grid,tp.block,tp.shared_bytes>>>(arg);
 	  qudaDeviceSynchronize();
         } else {
-          errorQuda("Randomize GaugeFields on CPU not supported yet\n");
+          HostLaunch launch(tp);
+          computeGenGaussCPU<Float>(arg);
         }
       }
 
@@ -131,21 +149,14 @@ namespace quda {
         std::stringstream vol, aux;
         vol << arg.X[0] << "x" << arg.X[1] << "x" << arg.X[2] << "x" << arg.X[3];
 	aux << "threads=" << arg.threads << ",prec="  << sizeof(Float);
+        if (gf.Location() == QUDA_CPU_FIELD_LOCATION) aux << getOmpThreadStr();
         return TuneKey(vol.str().c_str(), typeid(*this).name(), aux.str().c_str());
       }
 
-      long long flops() const { return 0; }
-      long long bytes() const { return 0; } 
-
-
-      void preTune(){
-	  //gf.backup();
-	  arg.rngstate.backup();
-      }
-      void postTune(){
-	  //gf.restore();
-	  arg.rngstate.restore();
-      }
+      // per link: 8 uniforms through Box-Muller (about 9 flops each counting each transcendental as one) and the
+      // assembly of the algebra element, not counting the integer Philox rounds
+      long long flops() const { return 2ll * arg.threads * 4 * (8 * 9 + 12); }
+      long long bytes() const { return 2ll * arg.threads * 4 * arg.dataDs.Bytes(); }
 
     }; 
 
@@ -154,7 +165,7 @@ namespace quda {
       GaugeGaussArg<Gauge> arg(dataDs, data, rngstate);
       GaugeGauss<Float,Gauge> gaugeGauss(arg, data);
       gaugeGauss.apply(0);
-
+      rngstate.advance(); // the next call draws a fresh field
     }
 
 
@@ -162,7 +173,15 @@ namespace quda {
   template<typename Float>
   void gaugeGauss(GaugeField &dataDs, RNG &rngstate) {
 
-      if(dataDs.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+      if (dataDs.Location() == QUDA_CPU_FIELD_LOCATION) {
+	  if (dataDs.Order() == QUDA_QDP_GAUGE_ORDER) {
+	      genGauss<Float>(gauge::QDPOrder<Float,18>(dataDs), dataDs, rngstate);
+	  } else if (dataDs.Order() == QUDA_MILC_GAUGE_ORDER) {
+	      genGauss<Float>(gauge::MILCOrder<Float,18>(dataDs), dataDs, rngstate);
+	  } else {
+	      errorQuda("Gauge field order %d not supported on the host", dataDs.Order());
+	  }
+      } else if(dataDs.Reconstruct() == QUDA_RECONSTRUCT_NO) {
 	  typedef typename gauge_mapper<Float,QUDA_RECONSTRUCT_NO>::type Gauge;
 	  genGauss<Float>(Gauge(dataDs), dataDs, rngstate);
       }else if(dataDs.Reconstruct() == QUDA_RECONSTRUCT_12){
@@ -187,7 +206,7 @@ namespace quda {
 	  errorQuda("Half precision not supported\n");
       }
 
-      if (!dataDs.isNative())
+      if (dataDs.Location() == QUDA_CUDA_FIELD_LOCATION && !dataDs.isNative())
 	  errorQuda("Order %d with %d reconstruct not supported", dataDs.Order(), dataDs.Reconstruct());
 
       if (dataDs.Precision() == QUDA_SINGLE_PRECISION){
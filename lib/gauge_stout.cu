@@ -13,6 +13,18 @@ namespace quda {
 
 #ifdef GPU_GAUGE_TOOLS
 
+  /**
+     Backup and restore of the destination while tuning.  The legacy
+     host orders are not backed up: the origin and destination fields
+     never alias there, so repeated host launches are idempotent.
+  */
+  template <typename G> void saveDest(G &dest) { dest.save(); }
+  template <typename G> void loadDest(G &dest) { dest.load(); }
+  template <typename Float, int length> void saveDest(gauge::QDPOrder<Float,length> &) { }
+  template <typename Float, int length> void loadDest(gauge::QDPOrder<Float,length> &) { }
+  template <typename Float, int length> void saveDest(gauge::MILCOrder<Float,length> &) { }
+  template <typename Float, int length> void loadDest(gauge::MILCOrder<Float,length> &) { }
+
   template <typename Float, typename GaugeOr, typename GaugeDs>
   struct GaugeSTOUTArg {
     int threads; // number of active threads required
@@ -99,13 +111,8 @@ namespace quda {
   }
   
   template<typename Float, typename GaugeOr, typename GaugeDs>
-    __global__ void computeSTOUTStep(GaugeSTOUTArg<Float,GaugeOr,GaugeDs> arg){
+    __host__ __device__ inline void computeSTOUTStepSite(GaugeSTOUTArg<Float,GaugeOr,GaugeDs> &arg, int idx, int parity, int dir){
 
-      int idx = threadIdx.x + blockIdx.x*blockDim.x;
-      int parity = threadIdx.y + blockIdx.y*blockDim.y;
-      int dir = threadIdx.z + blockIdx.z*blockDim.z;
-      if (idx >= arg.threads) return;
-      if (dir >= 3) return;
       typedef complex<Float> Complex;
       typedef Matrix<complex<Float>,3> Link;
 
@@ -200,6 +207,28 @@ namespace quda {
     }
   }
 
+  template<typename Float, typename GaugeOr, typename GaugeDs>
+    __global__ void computeSTOUTStep(GaugeSTOUTArg<Float,GaugeOr,GaugeDs> arg){
+
+      int idx = threadIdx.x + blockIdx.x*blockDim.x;
+      int parity = threadIdx.y + blockIdx.y*blockDim.y;
+      int dir = threadIdx.z + blockIdx.z*blockDim.z;
+      if (idx >= arg.threads) return;
+      if (dir >= 3) return;
+      computeSTOUTStepSite(arg, idx, parity, dir);
+  }
+
+  // as on the device, only the spatial links are smeared
+  template<typename Float, typename GaugeOr, typename GaugeDs>
+    void computeSTOUTStepCPU(GaugeSTOUTArg<Float,GaugeOr,GaugeDs> &arg){
+#pragma omp parallel for collapse(2) schedule(runtime)
+      for (int parity=0; parity<2; parity++) {
+	for (int idx=0; idx<arg.threads; idx++) {
+	  for (int dir=0; dir<3; dir++) computeSTOUTStepSite(arg, idx, parity, dir);
+	}
+      }
+  }
+
   template<typename Float, typename GaugeOr, typename GaugeDs>
   class GaugeSTOUT : TunableVectorYZ {
       GaugeSTOUTArg<Float,GaugeOr,GaugeDs> arg;
@@ -209,6 +238,10 @@ namespace quda {
       bool tuneGridDim() const { return false; } // Don't tune the grid dimensions.
       unsigned int minThreads() const { return arg.threads; }
 
+      // the CPU variant threads over the sites of both parities
+      bool hostKernel() const { return meta.Location() == QUDA_CPU_FIELD_LOCATION; }
+      unsigned int hostWorkItems() const { return 2 * arg.threads; }
+
       public:
     // (2,3) --- 2 for parity in the y thread dim, 3 corresponds to mapping direction to the z thread dim
     GaugeSTOUT(GaugeSTOUTArg<Float,GaugeOr,GaugeDs> &arg, const GaugeField &meta)
@@ -216,23 +249,24 @@ namespace quda {
       virtual ~GaugeSTOUT () {}
 
       void apply(const cudaStream_t &stream){
+        TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
         if (meta.Location() == QUDA_CUDA_FIELD_LOCATION) {
-          TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
           computeSTOUTStep<<<tp.grid,tp.block,tp.shared_bytes>>>(arg);
         } else {
-          errorQuda("CPU not supported yet\n");
-          //computeSTOUTStepCPU(arg);
+          HostLaunch launch(tp);
+          computeSTOUTStepCPU(arg);
         }
       }
 
       TuneKey tuneKey() const {
         std::stringstream aux;
         aux << "threads=" << arg.threads << ",prec="  << sizeof(Float);
+        if (meta.Location() == QUDA_CPU_FIELD_LOCATION) aux << getOmpThreadStr();
         return TuneKey(meta.VolString(), typeid(*this).name(), aux.str().c_str());
       }
 
-      void preTune() { arg.dest.save(); } // defensive measure in case they alias
-      void postTune() { arg.dest.load(); }
+      void preTune() { saveDest(arg.dest); } // defensive measure in case they alias
+      void postTune() { loadDest(arg.dest); }
 
       long long flops() const { return 3*(2+2*4)*198ll*arg.threads; } // just counts matrix multiplication
       long long bytes() const { return 3*((1+2*6)*arg.origin.Bytes()+arg.dest.Bytes())*arg.threads; }
@@ -243,13 +277,27 @@ namespace quda {
     GaugeSTOUTArg<Float,GaugeOr,GaugeDs> arg(origin, dest, dataOr, rho, dataOr.Precision() == QUDA_DOUBLE_PRECISION ? DOUBLE_TOL : SINGLE_TOL);
     GaugeSTOUT<Float,GaugeOr,GaugeDs> gaugeSTOUT(arg,dataOr);
     gaugeSTOUT.apply(0);
-    qudaDeviceSynchronize();
+    if (dataOr.Location() == QUDA_CUDA_FIELD_LOCATION) qudaDeviceSynchronize();
   }
 
   template<typename Float>
   void STOUTStep(GaugeField &dataDs, const GaugeField& dataOr, Float rho) {
 
-    if(dataDs.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+    if (dataDs.Location() == QUDA_CPU_FIELD_LOCATION) {
+      // host fields are only smeared in the legacy no-reconstruct orders
+      if (dataDs.Order() != dataOr.Order())
+	errorQuda("Origin order %d and destination order %d must match on the host", dataOr.Order(), dataDs.Order());
+
+      if (dataDs.Order() == QUDA_QDP_GAUGE_ORDER) {
+	typedef typename gauge::QDPOrder<Float,18> G;
+	STOUTStep(G(dataOr), G(dataDs), dataOr, rho);
+      } else if (dataDs.Order() == QUDA_MILC_GAUGE_ORDER) {
+	typedef typename gauge::MILCOrder<Float,18> G;
+	STOUTStep(G(dataOr), G(dataDs), dataOr, rho);
+      } else {
+	errorQuda("Order %d not supported on the host", dataDs.Order());
+      }
+    } else if(dataDs.Reconstruct() == QUDA_RECONSTRUCT_NO) {
       typedef typename gauge_mapper<Float,QUDA_RECONSTRUCT_NO>::type GDs;
 
       if(dataOr.Reconstruct() == QUDA_RECONSTRUCT_NO) {
@@ -312,11 +360,17 @@ namespace quda {
       errorQuda("Half precision not supported\n");
     }
 
-    if (!dataOr.isNative())
-      errorQuda("Order %d with %d reconstruct not supported", dataOr.Order(), dataOr.Reconstruct());
+    if (dataOr.Location() != dataDs.Location()) {
+      errorQuda("Origin and destination fields must have the same location\n");
+    }
+
+    if (dataDs.Location() == QUDA_CUDA_FIELD_LOCATION) {
+      if (!dataOr.isNative())
+	errorQuda("Order %d with %d reconstruct not supported", dataOr.Order(), dataOr.Reconstruct());
 
-    if (!dataDs.isNative())
-      errorQuda("Order %d with %d reconstruct not supported", dataDs.Order(), dataDs.Reconstruct());
+      if (!dataDs.isNative())
+	errorQuda("Order %d with %d reconstruct not supported", dataDs.Order(), dataDs.Reconstruct());
+    }
 
     if (dataDs.Precision() == QUDA_SINGLE_PRECISION){
       STOUTStep<float>(dataDs, dataOr, (float) rho);
@@ -598,13 +652,8 @@ namespace quda {
   }
   
   template<typename Float, typename GaugeOr, typename GaugeDs>
-    __global__ void computeOvrImpSTOUTStep(GaugeOvrImpSTOUTArg<Float,GaugeOr,GaugeDs> arg){
+    __host__ __device__ inline void computeOvrImpSTOUTStepSite(GaugeOvrImpSTOUTArg<Float,GaugeOr,GaugeDs> &arg, int idx, int parity, int dir){
 
-      int idx = threadIdx.x + blockIdx.x*blockDim.x;
-      int parity = threadIdx.y + blockIdx.y*blockDim.y;
-      int dir = threadIdx.z + blockIdx.z*blockDim.z;
-      if (idx >= arg.threads) return;
-      //if (dir >= 3) return;
       typedef complex<Float> Complex;
       typedef Matrix<complex<Float>,3> Link;
 
@@ -702,6 +751,28 @@ namespace quda {
     }
   }
 
+  template<typename Float, typename GaugeOr, typename GaugeDs>
+    __global__ void computeOvrImpSTOUTStep(GaugeOvrImpSTOUTArg<Float,GaugeOr,GaugeDs> arg){
+
+      int idx = threadIdx.x + blockIdx.x*blockDim.x;
+      int parity = threadIdx.y + blockIdx.y*blockDim.y;
+      int dir = threadIdx.z + blockIdx.z*blockDim.z;
+      if (idx >= arg.threads) return;
+      //if (dir >= 3) return;
+      computeOvrImpSTOUTStepSite(arg, idx, parity, dir);
+  }
+
+  // the host variant covers the same three directions as the (2,3) device launch
+  template<typename Float, typename GaugeOr, typename GaugeDs>
+    void computeOvrImpSTOUTStepCPU(GaugeOvrImpSTOUTArg<Float,GaugeOr,GaugeDs> &arg){
+#pragma omp parallel for collapse(2) schedule(runtime)
+      for (int parity=0; parity<2; parity++) {
+	for (int idx=0; idx<arg.threads; idx++) {
+	  for (int dir=0; dir<3; dir++) computeOvrImpSTOUTStepSite(arg, idx, parity, dir);
+	}
+      }
+  }
+
   
   template<typename Float, typename GaugeOr, typename GaugeDs>
     class GaugeOvrImpSTOUT : TunableVectorYZ {
@@ -712,6 +783,10 @@ namespace quda {
       bool tuneGridDim() const { return false; } // Don't tune the grid dimensions.
       unsigned int minThreads() const { return arg.threads; }
 
+      // the CPU variant threads over the sites of both parities
+      bool hostKernel() const { return meta.Location() == QUDA_CPU_FIELD_LOCATION; }
+      unsigned int hostWorkItems() const { return 2 * arg.threads; }
+
       public:
     // (2,3) --- 2 for parity in the y thread dim, 3 corresponds to mapping direction to the z thread dim
     GaugeOvrImpSTOUT(GaugeOvrImpSTOUTArg<Float,GaugeOr,GaugeDs> &arg, const GaugeField &meta)
@@ -719,23 +794,24 @@ namespace quda {
       virtual ~GaugeOvrImpSTOUT () {}
 
       void apply(const cudaStream_t &stream){
+        TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
         if (meta.Location() == QUDA_CUDA_FIELD_LOCATION) {
-          TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
           computeOvrImpSTOUTStep<<<tp.grid,tp.block,tp.shared_bytes>>>(arg);
         } else {
-          errorQuda("CPU not supported yet\n");
-          //computeOvrImpSTOUTStepCPU(arg);
+          HostLaunch launch(tp);
+          computeOvrImpSTOUTStepCPU(arg);
         }
       }
 
       TuneKey tuneKey() const {
         std::stringstream aux;
         aux << "threads=" << arg.threads << ",prec="  << sizeof(Float);
+        if (meta.Location() == QUDA_CPU_FIELD_LOCATION) aux << getOmpThreadStr();
         return TuneKey(meta.VolString(), typeid(*this).name(), aux.str().c_str());
       }
 
-    void preTune() { arg.dest.save(); } // defensive measure in case they alias
-    void postTune() { arg.dest.load(); }
+    void preTune() { saveDest(arg.dest); } // defensive measure in case they alias
+    void postTune() { loadDest(arg.dest); }
 
     long long flops() const { return 4*(18+2+2*4)*198ll*arg.threads; } // just counts matrix multiplication
     long long bytes() const { return 4*((1+2*12)*arg.origin.Bytes()+arg.dest.Bytes())*arg.threads; }
@@ -748,13 +824,27 @@ namespace quda {
 						   dataOr.Precision() == QUDA_DOUBLE_PRECISION ? DOUBLE_TOL : SINGLE_TOL);
     GaugeOvrImpSTOUT<Float,GaugeOr,GaugeDs> gaugeOvrImpSTOUT(arg,dataOr);
     gaugeOvrImpSTOUT.apply(0);
-    qudaDeviceSynchronize();
+    if (dataOr.Location() == QUDA_CUDA_FIELD_LOCATION) qudaDeviceSynchronize();
   }
 
   template<typename Float>
   void OvrImpSTOUTStep(GaugeField &dataDs, const GaugeField& dataOr, Float rho, Float epsilon) {
     
-    if(dataDs.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+    if (dataDs.Location() == QUDA_CPU_FIELD_LOCATION) {
+      // host fields are only smeared in the legacy no-reconstruct orders
+      if (dataDs.Order() != dataOr.Order())
+	errorQuda("Origin order %d and destination order %d must match on the host", dataOr.Order(), dataDs.Order());
+
+      if (dataDs.Order() == QUDA_QDP_GAUGE_ORDER) {
+	typedef typename gauge::QDPOrder<Float,18> G;
+	OvrImpSTOUTStep(G(dataOr), G(dataDs), dataOr, rho, epsilon);
+      } else if (dataDs.Order() == QUDA_MILC_GAUGE_ORDER) {
+	typedef typename gauge::MILCOrder<Float,18> G;
+	OvrImpSTOUTStep(G(dataOr), G(dataDs), dataOr, rho, epsilon);
+      } else {
+	errorQuda("Order %d not supported on the host", dataDs.Order());
+      }
+    } else if(dataDs.Reconstruct() == QUDA_RECONSTRUCT_NO) {
       typedef typename gauge_mapper<Float,QUDA_RECONSTRUCT_NO>::type GDs;
 
       if(dataOr.Reconstruct() == QUDA_RECONSTRUCT_NO) {
@@ -816,11 +906,17 @@ namespace quda {
       errorQuda("Half precision not supported\n");
     }
 
-    if (!dataOr.isNative())
-      errorQuda("Order %d with %d reconstruct not supported", dataOr.Order(), dataOr.Reconstruct());
+    if (dataOr.Location() != dataDs.Location()) {
+      errorQuda("Origin and destination fields must have the same location\n");
+    }
+
+    if (dataDs.Location() == QUDA_CUDA_FIELD_LOCATION) {
+      if (!dataOr.isNative())
+	errorQuda("Order %d with %d reconstruct not supported", dataOr.Order(), dataOr.Reconstruct());
 
-    if (!dataDs.isNative())
-      errorQuda("Order %d with %d reconstruct not supported", dataDs.Order(), dataDs.Reconstruct());
+      if (!dataDs.isNative())
+	errorQuda("Order %d with %d reconstruct not supported", dataDs.Order(), dataDs.Reconstruct());
+    }
 
     if (dataDs.Precision() == QUDA_SINGLE_PRECISION){
       OvrImpSTOUTStep<float>(dataDs, dataOr, (float) rho, epsilon);
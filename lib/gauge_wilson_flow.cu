@@ -0,0 +1,636 @@
+#include <quda_internal.h>
+#include <quda_matrix.h>
+#include <tune_quda.h>
+#include <gauge_field.h>
+#include <gauge_field_order.h>
+#include <launch_kernel.cuh>
+#include <cub_helper.cuh>
+#include <index_helper.cuh>
+#include <blas_helper.cuh>
+
+#ifndef Pi2
+#define Pi2 6.2831853071795864769252867665590
+#endif
+
+namespace quda {
+
+#ifdef GPU_GAUGE_TOOLS
+
+  /**
+     Load the link U_mu(x+dx), where x is given in extended
+     coordinates.  Shifts by an odd number of sites flip the parity.
+  */
+  template <typename Float, typename Gauge>
+  __host__ __device__ inline Matrix<complex<Float>,3> getLink(Gauge &U, int mu, const int x[], const int dx[],
+                                                             const int X[], int parity) {
+    return U(mu, linkIndexShift(x,dx,X), (parity + dx[0] + dx[1] + dx[2] + dx[3]) & 1);
+  }
+
+  template <typename Float, typename Gauge, typename Mom>
+  struct GaugeWFlowArg {
+    int threads; // number of active threads required
+    int X[4]; // grid dimensions
+    int border[4];
+    Gauge in;
+    Gauge out;
+    Mom z; // Runge-Kutta accumulator, one traceless anti-hermitian matrix per link
+    const QudaWFlowType wflow_type;
+    Float epsilon; // flow-time step size
+    Float a; // z = a * epsilon * Z(in) + b * z
+    Float b;
+    Float c; // out = exp(c * z) * in
+
+    /**
+       @param stage Stage 0, 1 or 2 of Luscher's low-storage
+       third-order Runge-Kutta integrator (arXiv:1006.4518, appendix C)
+    */
+    GaugeWFlowArg(Gauge &in, Gauge &out, Mom &z, const GaugeField &data, QudaWFlowType wflow_type, Float epsilon, int stage)
+      : threads(1), in(in), out(out), z(z), wflow_type(wflow_type), epsilon(epsilon),
+        a(stage == 0 ? 1.0 : stage == 1 ? 8.0/9.0 : 0.75),
+        b(stage == 0 ? 0.0 : stage == 1 ? -17.0/36.0 : -1.0),
+        c(stage == 0 ? 0.25 : 1.0) {
+      for ( int dir = 0; dir < 4; ++dir ) {
+        border[dir] = data.R()[dir];
+        X[dir] = data.X()[dir] - border[dir] * 2;
+	threads *= X[dir];
+      }
+      threads /= 2;
+    }
+  };
+
+  /**
+     Compute the sum of staples C_nu(x) of the link U_nu(x), such that
+     C_nu(x) U^dag_nu(x) is a sum of closed loops.  Unlike the STOUT
+     staples all four directions contribute.  The Symanzik flow adds
+     the 1x2 and 2x1 rectangles with the tree-level Luscher-Weisz
+     weights c0 = 5/3 and c1 = -1/12.
+  */
+  template <typename Float, typename Arg>
+  __host__ __device__ inline void computeFlowStaple(Arg &arg, const int x[], const int X[], int parity, int nu,
+                                                    Matrix<complex<Float>,3> &staple) {
+    typedef Matrix<complex<Float>,3> Link;
+    const bool symanzik = arg.wflow_type == QUDA_WFLOW_TYPE_SYMANZIK;
+
+    Link S, R;
+    setZero(&S);
+    setZero(&R);
+
+    for (int mu=0; mu<4; mu++) {
+      if (mu == nu) continue;
+
+      int dx[4] = {0, 0, 0, 0};
+
+      // U_mu(x) U_nu(x+mu) U^dag_mu(x+nu)
+      Link U1 = getLink<Float>(arg.in, mu, x, dx, X, parity);
+      dx[mu]++;
+      Link U2 = getLink<Float>(arg.in, nu, x, dx, X, parity);
+      dx[mu]--;
+      dx[nu]++;
+      Link U3 = getLink<Float>(arg.in, mu, x, dx, X, parity);
+      dx[nu]--;
+      S = S + U1 * U2 * conj(U3);
+
+      // U^dag_mu(x-mu) U_nu(x-mu) U_mu(x-mu+nu)
+      dx[mu]--;
+      Link D1 = getLink<Float>(arg.in, mu, x, dx, X, parity);
+      Link D2 = getLink<Float>(arg.in, nu, x, dx, X, parity);
+      dx[nu]++;
+      Link D3 = getLink<Float>(arg.in, mu, x, dx, X, parity);
+      dx[nu]--;
+      dx[mu]++;
+      S = S + conj(D1) * D2 * D3;
+
+      if (symanzik) {
+	Link V1, V2, V3;
+
+	// 2x1 forward: U_mu(x) U_mu(x+mu) U_nu(x+2mu) U^dag_mu(x+mu+nu) U^dag_mu(x+nu)
+	dx[mu]++;
+	V1 = getLink<Float>(arg.in, mu, x, dx, X, parity);
+	dx[mu]++;
+	V2 = getLink<Float>(arg.in, nu, x, dx, X, parity);
+	dx[mu]--;
+	dx[nu]++;
+	V3 = getLink<Float>(arg.in, mu, x, dx, X, parity);
+	dx[nu]--;
+	dx[mu]--;
+	R = R + U1 * V1 * V2 * conj(V3) * conj(U3);
+
+	// 2x1 backward: U^dag_mu(x-mu) U^dag_mu(x-2mu) U_nu(x-2mu) U_mu(x-2mu+nu) U_mu(x-mu+nu)
+	dx[mu] -= 2;
+	V1 = getLink<Float>(arg.in, mu, x, dx, X, parity);
+	V2 = getLink<Float>(arg.in, nu, x, dx, X, parity);
+	dx[nu]++;
+	V3 = getLink<Float>(arg.in, mu, x, dx, X, parity);
+	dx[nu]--;
+	dx[mu] += 2;
+	R = R + conj(D1) * conj(V1) * V2 * V3 * D3;
+
+	// 1x2 upper: U_mu(x) U_nu(x+mu) U_nu(x+mu+nu) U^dag_mu(x+2nu) U^dag_nu(x+nu)
+	Link N1, N2;
+	dx[nu]++;
+	N1 = getLink<Float>(arg.in, nu, x, dx, X, parity);
+	dx[mu]++;
+	V1 = getLink<Float>(arg.in, nu, x, dx, X, parity);
+	dx[mu]--;
+	dx[nu]++;
+	V2 = getLink<Float>(arg.in, mu, x, dx, X, parity);
+	dx[nu] -= 2;
+	R = R + U1 * U2 * V1 * conj(V2) * conj(N1);
+
+	// 1x2 lower: U^dag_nu(x-nu) U_mu(x-nu) U_nu(x-nu+mu) U_nu(x+mu) U^dag_mu(x+nu)
+	dx[nu]--;
+	N2 = getLink<Float>(arg.in, nu, x, dx, X, parity);
+	V1 = getLink<Float>(arg.in, mu, x, dx, X, parity);
+	dx[mu]++;
+	V2 = getLink<Float>(arg.in, nu, x, dx, X, parity);
+	dx[mu]--;
+	dx[nu]++;
+	R = R + conj(N2) * V1 * V2 * U2 * conj(U3);
+
+	// 1x2 upper, -mu side: U^dag_mu(x-mu) U_nu(x-mu) U_nu(x-mu+nu) U_mu(x-mu+2nu) U^dag_nu(x+nu)
+	dx[mu]--;
+	dx[nu]++;
+	V1 = getLink<Float>(arg.in, nu, x, dx, X, parity);
+	dx[nu]++;
+	V2 = getLink<Float>(arg.in, mu, x, dx, X, parity);
+	dx[nu] -= 2;
+	dx[mu]++;
+	R = R + conj(D1) * D2 * V1 * V2 * conj(N1);
+
+	// 1x2 lower, -mu side: U^dag_nu(x-nu) U^dag_mu(x-mu-nu) U_nu(x-mu-nu) U_nu(x-mu) U_mu(x-mu+nu)
+	dx[mu]--;
+	dx[nu]--;
+	V1 = getLink<Float>(arg.in, mu, x, dx, X, parity);
+	V2 = getLink<Float>(arg.in, nu, x, dx, X, parity);
+	R = R + conj(N2) * conj(V1) * V2 * D2 * D3;
+      }
+    }
+
+    if (symanzik) {
+      staple = static_cast<Float>(5.0/3.0) * S - static_cast<Float>(1.0/12.0) * R;
+    } else {
+      staple = S;
+    }
+  }
+
+  /**
+     Apply one Runge-Kutta stage to the link U_dir(x):
+       z   <- a * epsilon * Z(in) + b * z
+       out <- exp(c * z) * in
+     where Z(U) = P_TA(C U^dag) is the traceless anti-hermitian
+     projection of the force.
+  */
+  template <typename Float, typename Arg>
+  __host__ __device__ inline void computeWFlowStepLink(Arg &arg, int idx, int parity, int dir) {
+    typedef complex<Float> Complex;
+    typedef Matrix<complex<Float>,3> Link;
+
+    int X[4];
+    for (int dr=0; dr<4; ++dr) X[dr] = arg.X[dr];
+
+    int x[4];
+    getCoords(x, idx, X, parity);
+    for (int dr=0; dr<4; ++dr) {
+      x[dr] += arg.border[dr];
+      X[dr] += 2*arg.border[dr];
+    }
+
+    int dx[4] = {0, 0, 0, 0};
+    Link U = arg.in(dir, linkIndexShift(x,dx,X), parity);
+
+    Link C;
+    computeFlowStaple<Float>(arg, x, X, parity, dir, C);
+
+    Link Omega = C * conj(U);
+    Link Z = static_cast<Float>(0.5) * (Omega - conj(Omega));
+    Link I;
+    setIdentity(&I);
+    Complex trace = getTrace(Z);
+    Z = Z - (static_cast<Float>(1.0/3.0) * trace) * I;
+
+    Link acc = (arg.a * arg.epsilon) * Z;
+    if (arg.b != static_cast<Float>(0.0)) {
+      Link z = arg.z(dir, linkIndexShift(x,dx,X), parity);
+      acc = acc + arg.b * z;
+    }
+    arg.z(dir, linkIndexShift(x,dx,X), parity) = acc;
+
+    // exp(A) = exp(iQ) with the hermitian Q = -iA
+    Link Q = Complex(0.0, -arg.c) * acc;
+    Link expiQ;
+    exponentiate_iQ(Q, &expiQ);
+
+    arg.out(dir, linkIndexShift(x,dx,X), parity) = expiQ * U;
+  }
+
+  template <typename Float, typename Arg>
+  __global__ void computeWFlowStep(Arg arg) {
+    int idx = threadIdx.x + blockIdx.x*blockDim.x;
+    int parity = threadIdx.y + blockIdx.y*blockDim.y;
+    int dir = threadIdx.z + blockIdx.z*blockDim.z;
+    if (idx >= arg.threads) return;
+    if (dir >= 4) return;
+    computeWFlowStepLink<Float>(arg, idx, parity, dir);
+  }
+
+  template <typename Float, typename Arg>
+  void computeWFlowStepCPU(Arg &arg) {
+#pragma omp parallel for collapse(2) schedule(runtime)
+    for (int parity=0; parity<2; parity++) {
+      for (int idx=0; idx<arg.threads; idx++) {
+	for (int dir=0; dir<4; dir++) computeWFlowStepLink<Float>(arg, idx, parity, dir);
+      }
+    }
+  }
+
+  template <typename Float, typename Arg>
+  class GaugeWFlowStep : TunableVectorYZ {
+    Arg &arg;
+    const GaugeField &meta;
+    GaugeField &zField;
+
+  private:
+    bool tuneGridDim() const { return false; } // Don't tune the grid dimensions.
+    unsigned int minThreads() const { return arg.threads; }
+
+    // the CPU variant threads over the sites of both parities
+    bool hostKernel() const { return meta.Location() == QUDA_CPU_FIELD_LOCATION; }
+    unsigned int hostWorkItems() const { return 2 * arg.threads; }
+
+  public:
+    // (2,4) --- 2 for parity in the y thread dim, 4 corresponds to mapping direction to the z thread dim
+    GaugeWFlowStep(Arg &arg, const GaugeField &meta, GaugeField &zField)
+      : TunableVectorYZ(2,4), arg(arg), meta(meta), zField(zField) { }
+    virtual ~GaugeWFlowStep() { }
+
+    void apply(const cudaStream_t &stream) {
+      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+      if (meta.Location() == QUDA_CUDA_FIELD_LOCATION) {
+	computeWFlowStep<Float><<<tp.grid,tp.block,tp.shared_bytes>>>(arg);
+      } else {
+	HostLaunch launch(tp);
+	computeWFlowStepCPU<Float>(arg);
+      }
+    }
+
+    TuneKey tuneKey() const {
+      std::stringstream aux;
+      aux << "threads=" << arg.threads << ",prec=" << sizeof(Float)
+	  << (arg.wflow_type == QUDA_WFLOW_TYPE_SYMANZIK ? ",symanzik" : ",wilson");
+      if (meta.Location() == QUDA_CPU_FIELD_LOCATION) aux << getOmpThreadStr();
+      return TuneKey(meta.VolString(), typeid(*this).name(), aux.str().c_str());
+    }
+
+    // the accumulator is read and written in place, so restore it after tuning
+    void preTune() { zField.backup(); }
+    void postTune() { zField.restore(); }
+
+    long long flops() const {
+      // staples (and rectangles), projection, exponentiation and the final product
+      long long mat_mul = arg.wflow_type == QUDA_WFLOW_TYPE_SYMANZIK ? 3*(4+4*6) + 2 : 3*4 + 2;
+      return 4*2*(mat_mul*198ll + 400)*arg.threads;
+    }
+    long long bytes() const {
+      long long links = arg.wflow_type == QUDA_WFLOW_TYPE_SYMANZIK ? 1+3*(6+12) : 1+3*6;
+      return 4*2*(links*arg.in.Bytes() + arg.out.Bytes() + 2*arg.z.Bytes())*arg.threads;
+    }
+  }; // GaugeWFlowStep
+
+  // fill the halo of an extended field after each stage, locally too if R is non-zero
+  static void exchangeExtendedGhost(GaugeField &u) {
+    if (u.Location() == QUDA_CUDA_FIELD_LOCATION) {
+      static_cast<cudaGaugeField&>(u).exchangeExtendedGhost(u.R(), true);
+    } else {
+      static_cast<cpuGaugeField&>(u).exchangeExtendedGhost(u.R(), true);
+    }
+  }
+
+  template <typename Float, typename Gauge, typename Mom>
+  void WFlowStep(Gauge out, Gauge in, Mom z, GaugeField &dataOut, GaugeField &dataIn, GaugeField &dataZ,
+                 QudaWFlowType wflow_type, Float epsilon) {
+    // the stages ping-pong between the two gauge fields so no copies are needed
+    for (int stage=0; stage<3; stage++) {
+      const bool odd = stage == 1;
+      GaugeWFlowArg<Float,Gauge,Mom> arg(odd ? out : in, odd ? in : out, z, dataIn, wflow_type, epsilon, stage);
+      GaugeWFlowStep<Float,GaugeWFlowArg<Float,Gauge,Mom> > wflow(arg, odd ? dataOut : dataIn, dataZ);
+      wflow.apply(0);
+      if (dataIn.Location() == QUDA_CUDA_FIELD_LOCATION) qudaDeviceSynchronize();
+      exchangeExtendedGhost(odd ? dataIn : dataOut);
+    }
+  }
+
+  template <typename Float, typename Gauge>
+  void WFlowStep(GaugeField &out, GaugeField &temp, GaugeField &in, QudaWFlowType wflow_type, Float epsilon) {
+    typedef typename gauge_mapper<Float,QUDA_RECONSTRUCT_NO>::type Mom;
+    WFlowStep<Float>(Gauge(out), Gauge(in), Mom(temp), out, in, temp, wflow_type, epsilon);
+  }
+
+  template <typename Float>
+  void WFlowStep(GaugeField &out, GaugeField &temp, GaugeField &in, QudaWFlowType wflow_type, Float epsilon) {
+
+    if (in.Location() == QUDA_CPU_FIELD_LOCATION) {
+      // host fields are only flowed in the legacy no-reconstruct orders, the accumulator included
+      if (out.Order() != in.Order() || temp.Order() != in.Order())
+	errorQuda("Orders %d %d %d must match on the host", out.Order(), temp.Order(), in.Order());
+
+      if (in.Order() == QUDA_QDP_GAUGE_ORDER) {
+	typedef typename gauge::QDPOrder<Float,18> G;
+	WFlowStep<Float>(G(out), G(in), G(temp), out, in, temp, wflow_type, epsilon);
+      } else if (in.Order() == QUDA_MILC_GAUGE_ORDER) {
+	typedef typename gauge::MILCOrder<Float,18> G;
+	WFlowStep<Float>(G(out), G(in), G(temp), out, in, temp, wflow_type, epsilon);
+      } else {
+	errorQuda("Order %d not supported on the host", in.Order());
+      }
+    } else {
+      if (out.Reconstruct() != in.Reconstruct())
+	errorQuda("Reconstruction types %d and %d must match", out.Reconstruct(), in.Reconstruct());
+      if (temp.Reconstruct() != QUDA_RECONSTRUCT_NO)
+	errorQuda("Runge-Kutta accumulator requires reconstruction type %d", QUDA_RECONSTRUCT_NO);
+
+      if (in.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+	WFlowStep<Float, typename gauge_mapper<Float,QUDA_RECONSTRUCT_NO>::type>(out, temp, in, wflow_type, epsilon);
+      } else if (in.Reconstruct() == QUDA_RECONSTRUCT_12) {
+	WFlowStep<Float, typename gauge_mapper<Float,QUDA_RECONSTRUCT_12>::type>(out, temp, in, wflow_type, epsilon);
+      } else if (in.Reconstruct() == QUDA_RECONSTRUCT_8) {
+	WFlowStep<Float, typename gauge_mapper<Float,QUDA_RECONSTRUCT_8>::type>(out, temp, in, wflow_type, epsilon);
+      } else {
+	errorQuda("Reconstruction type %d of gauge field not supported", in.Reconstruct());
+      }
+    }
+  }
+
+  template <typename Gauge>
+  struct WFlowObsArg : public ReduceArg<double3> {
+    int threads; // number of active threads required
+    int X[4]; // true grid dimensions
+    int border[4];
+    Gauge u;
+
+    WFlowObsArg(const Gauge &u, const GaugeField &data)
+      : ReduceArg<double3>(), threads(1), u(u) {
+      for (int dir=0; dir<4; ++dir) {
+	border[dir] = data.R()[dir];
+	X[dir] = data.X()[dir] - border[dir]*2;
+	threads *= X[dir];
+      }
+      threads /= 2;
+    }
+  };
+
+  /**
+     Measure the flow observables at one site in a single pass over
+     its clover leaves:
+       x: plaquette energy density 2 sum_{mu<nu} Re tr(1 - P_munu)
+       y: clover energy density -sum_{mu<nu} tr(F_munu F_munu)
+       z: topological charge density, normalized as in computeQCharge
+     with F_munu the traceless anti-hermitian clover field strength.
+  */
+  template <typename Float, typename Arg>
+  __host__ __device__ inline double3 computeWFlowObsSite(Arg &arg, int idx, int parity) {
+    typedef Matrix<complex<Float>,3> Link;
+
+    int X[4];
+    for (int dr=0; dr<4; ++dr) X[dr] = arg.X[dr];
+
+    int x[4];
+    getCoords(x, idx, X, parity);
+    for (int dr=0; dr<4; ++dr) {
+      x[dr] += arg.border[dr];
+      X[dr] += 2*arg.border[dr];
+    }
+
+    double plaq = 0.0;
+    double energy = 0.0;
+    Link F[6]; // F[1,0], F[2,0], F[2,1], F[3,0], F[3,1], F[3,2]
+
+    for (int mu=1; mu<4; mu++) {
+      for (int nu=0; nu<mu; nu++) {
+	int dx[4] = {0, 0, 0, 0};
+	Link L;
+
+	{ // U(x,mu) U(x+mu,nu) U[dagger](x+nu,mu) U[dagger](x,nu)
+	  Link U1 = getLink<Float>(arg.u, mu, x, dx, X, parity);
+	  dx[mu]++;
+	  Link U2 = getLink<Float>(arg.u, nu, x, dx, X, parity);
+	  dx[mu]--;
+	  dx[nu]++;
+	  Link U3 = getLink<Float>(arg.u, mu, x, dx, X, parity);
+	  dx[nu]--;
+	  Link U4 = getLink<Float>(arg.u, nu, x, dx, X, parity);
+	  L = U1 * U2 * conj(U3) * conj(U4);
+	  plaq += getTrace(L).real();
+	}
+
+	{ // U(x,nu) U[dagger](x+nu-mu,mu) U[dagger](x-mu,nu) U(x-mu, mu)
+	  Link U1 = getLink<Float>(arg.u, nu, x, dx, X, parity);
+	  dx[nu]++;
+	  dx[mu]--;
+	  Link U2 = getLink<Float>(arg.u, mu, x, dx, X, parity);
+	  dx[nu]--;
+	  Link U3 = getLink<Float>(arg.u, nu, x, dx, X, parity);
+	  Link U4 = getLink<Float>(arg.u, mu, x, dx, X, parity);
+	  dx[mu]++;
+	  L += U1 * conj(U2) * conj(U3) * U4;
+	}
+
+	{ // U[dagger](x-nu,nu) U(x-nu,mu) U(x+mu-nu,nu) U[dagger](x,mu)
+	  dx[nu]--;
+	  Link U1 = getLink<Float>(arg.u, nu, x, dx, X, parity);
+	  Link U2 = getLink<Float>(arg.u, mu, x, dx, X, parity);
+	  dx[mu]++;
+	  Link U3 = getLink<Float>(arg.u, nu, x, dx, X, parity);
+	  dx[mu]--;
+	  dx[nu]++;
+	  Link U4 = getLink<Float>(arg.u, mu, x, dx, X, parity);
+	  L += conj(U1) * U2 * U3 * conj(U4);
+	}
+
+	{ // U[dagger](x-mu,mu) U[dagger](x-mu-nu,nu) U(x-mu-nu,mu) U(x-nu,nu)
+	  dx[mu]--;
+	  Link U1 = getLink<Float>(arg.u, mu, x, dx, X, parity);
+	  dx[nu]--;
+	  Link U2 = getLink<Float>(arg.u, nu, x, dx, X, parity);
+	  Link U3 = getLink<Float>(arg.u, mu, x, dx, X, parity);
+	  dx[mu]++;
+	  Link U4 = getLink<Float>(arg.u, nu, x, dx, X, parity);
+	  dx[nu]++;
+	  L += conj(U1) * conj(U2) * U3 * U4;
+	}
+
+	Link I;
+	setIdentity(&I);
+	Link G = static_cast<Float>(0.125) * (L - conj(L));
+	G = G - (static_cast<Float>(1.0/3.0) * getTrace(G)) * I;
+
+	energy -= getTrace(G * G).real();
+	F[(mu*(mu-1))/2 + nu] = G;
+      }
+    }
+
+    double Q1 = getTrace(F[0]*F[5]).real();
+    double Q2 = getTrace(F[1]*F[4]).real();
+    double Q3 = getTrace(F[3]*F[2]).real();
+
+    return make_double3(2.0*(18.0 - plaq), energy, (Q1 + Q3 - Q2) / (Pi2*Pi2));
+  }
+
+  template <int blockSize, typename Float, typename Arg>
+  __global__ void computeWFlowObs(Arg arg) {
+    int idx = threadIdx.x + blockIdx.x*blockDim.x;
+    int parity = threadIdx.y;
+
+    double3 obs = make_double3(0.0, 0.0, 0.0);
+
+    while (idx < arg.threads) {
+      obs += computeWFlowObsSite<Float>(arg, idx, parity);
+      idx += blockDim.x*gridDim.x;
+    }
+
+    // perform final inter-block reduction and write out result
+    reduce2d<blockSize,2>(arg, obs);
+  }
+
+  template <typename Float, typename Arg>
+  void computeWFlowObsCPU(Arg &arg) {
+    arg.result_h[0] = blas::hostReduce<double3>([&](int parity, int idx) { return computeWFlowObsSite<Float>(arg, idx, parity); },
+						arg.threads);
+  }
+
+  template <typename Float, typename Arg>
+  class WFlowObs : TunableLocalParity {
+    Arg &arg;
+    const GaugeField &meta;
+
+  private:
+    bool tuneGridDim() const { return true; }
+
+    bool hostKernel() const { return meta.Location() == QUDA_CPU_FIELD_LOCATION; }
+    unsigned int hostWorkItems() const { return blas::hostReduceBlocks(arg.threads, 2); }
+
+  public:
+    WFlowObs(Arg &arg, const GaugeField &meta) : TunableLocalParity(), arg(arg), meta(meta) {
+      writeAuxString("threads=%d,prec=%lu", arg.threads, sizeof(Float));
+      if (meta.Location() == QUDA_CPU_FIELD_LOCATION) strcat(aux, getOmpThreadStr());
+    }
+    virtual ~WFlowObs() { }
+
+    void apply(const cudaStream_t &stream) {
+      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+      if (meta.Location() == QUDA_CUDA_FIELD_LOCATION) {
+	arg.result_h[0] = make_double3(0.0, 0.0, 0.0);
+	LAUNCH_KERNEL_LOCAL_PARITY(computeWFlowObs, tp, stream, arg, Float, Arg);
+	qudaDeviceSynchronize();
+      } else {
+	HostLaunch launch(tp);
+	computeWFlowObsCPU<Float>(arg);
+      }
+    }
+
+    TuneKey tuneKey() const { return TuneKey(meta.VolString(), typeid(*this).name(), aux); }
+
+    long long flops() const { return 2ll*arg.threads*(6*(16*198 + 4*18 + 2*198 + 60) + 3*198); }
+    long long bytes() const { return 2ll*arg.threads*6*16*arg.u.Bytes(); }
+  };
+
+  template <typename Float, typename Gauge>
+  void computeWFlowObservables(const Gauge u, const GaugeField &data, double3 &obs) {
+    WFlowObsArg<Gauge> arg(u, data);
+    WFlowObs<Float, WFlowObsArg<Gauge> > wflowObs(arg, data);
+    wflowObs.apply(0);
+    checkCudaError();
+    comm_allreduce_array((double*)arg.result_h, 3);
+    obs = arg.result_h[0];
+    // energy densities are site averages, the charge is the global sum
+    obs.x /= 2.0*arg.threads*comm_size();
+    obs.y /= 2.0*arg.threads*comm_size();
+  }
+
+  template <typename Float>
+  void computeWFlowObservables(const GaugeField &u, double3 &obs) {
+    if (u.Location() == QUDA_CPU_FIELD_LOCATION) {
+      if (u.Order() == QUDA_QDP_GAUGE_ORDER) {
+	computeWFlowObservables<Float>(gauge::QDPOrder<Float,18>(u), u, obs);
+      } else if (u.Order() == QUDA_MILC_GAUGE_ORDER) {
+	computeWFlowObservables<Float>(gauge::MILCOrder<Float,18>(u), u, obs);
+      } else {
+	errorQuda("Order %d not supported on the host", u.Order());
+      }
+    } else {
+      if (!u.isNative()) errorQuda("Order %d with %d reconstruct not supported", u.Order(), u.Reconstruct());
+
+      if (u.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+	typedef typename gauge_mapper<Float,QUDA_RECONSTRUCT_NO>::type G;
+	computeWFlowObservables<Float>(G(u), u, obs);
+      } else if (u.Reconstruct() == QUDA_RECONSTRUCT_12) {
+	typedef typename gauge_mapper<Float,QUDA_RECONSTRUCT_12>::type G;
+	computeWFlowObservables<Float>(G(u), u, obs);
+      } else if (u.Reconstruct() == QUDA_RECONSTRUCT_8) {
+	typedef typename gauge_mapper<Float,QUDA_RECONSTRUCT_8>::type G;
+	computeWFlowObservables<Float>(G(u), u, obs);
+      } else {
+	errorQuda("Reconstruction type %d of gauge field not supported", u.Reconstruct());
+      }
+    }
+  }
+
+#endif // GPU_GAUGE_TOOLS
+
+  void WFlowStep(GaugeField &out, GaugeField &temp, GaugeField &in, double epsilon, QudaWFlowType wflow_type) {
+
+#ifdef GPU_GAUGE_TOOLS
+
+    if (out.Precision() != in.Precision() || temp.Precision() != in.Precision()) {
+      errorQuda("Flow fields must have the same precision\n");
+    }
+
+    if (in.Precision() == QUDA_HALF_PRECISION) {
+      errorQuda("Half precision not supported\n");
+    }
+
+    if (out.Location() != in.Location() || temp.Location() != in.Location()) {
+      errorQuda("Flow fields must have the same location\n");
+    }
+
+    if (in.Location() == QUDA_CUDA_FIELD_LOCATION) {
+      if (!in.isNative())
+	errorQuda("Order %d with %d reconstruct not supported", in.Order(), in.Reconstruct());
+
+      if (!out.isNative())
+	errorQuda("Order %d with %d reconstruct not supported", out.Order(), out.Reconstruct());
+    }
+
+    if (wflow_type != QUDA_WFLOW_TYPE_WILSON && wflow_type != QUDA_WFLOW_TYPE_SYMANZIK) {
+      errorQuda("Flow type %d not supported", wflow_type);
+    }
+
+    if (in.Precision() == QUDA_SINGLE_PRECISION) {
+      WFlowStep<float>(out, temp, in, wflow_type, (float) epsilon);
+    } else if (in.Precision() == QUDA_DOUBLE_PRECISION) {
+      WFlowStep<double>(out, temp, in, wflow_type, epsilon);
+    } else {
+      errorQuda("Precision %d not supported", in.Precision());
+    }
+    return;
+#else
+    errorQuda("Gauge tools are not build");
+#endif
+  }
+
+  double3 computeWFlowObservables(const GaugeField &u) {
+    double3 obs = make_double3(0.0, 0.0, 0.0);
+#ifdef GPU_GAUGE_TOOLS
+    if (u.Precision() == QUDA_SINGLE_PRECISION) {
+      computeWFlowObservables<float>(u, obs);
+    } else if (u.Precision() == QUDA_DOUBLE_PRECISION) {
+      computeWFlowObservables<double>(u, obs);
+    } else {
+      errorQuda("Precision %d not supported", u.Precision());
+    }
+#else
+    errorQuda("Gauge tools are not build");
+#endif
+    return obs;
+  }
+
+} // namespace quda
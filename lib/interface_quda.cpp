@@ -23,6 +23,7 @@
 #include <llfat_quda.h>
 #include <unitarization_links.h>
 #include <algorithm>
+#include <list>
 #include <staggered_oprod.h>
 #include <ks_improved_force.h>
 #include <ks_force_quda.h>
@@ -224,6 +225,9 @@ static TimeProfile profileSTOUT("STOUTQuda");
 //!< Profiler for OvrImpSTOUTQuda
 static TimeProfile profileOvrImpSTOUT("OvrImpSTOUTQuda");
 
+//!< Profiler for WFlowQuda
+static TimeProfile profileWFlow("WFlowQuda");
+
 //!< Profiler for projectSU3Quda
 static TimeProfile profileProject("projectSU3Quda");
 
@@ -361,7 +365,7 @@ static int qmp_rank_from_coords(const int *coords, void *fdata)
 #endif
 
 
-static bool comms_initialized = false;
+static COMM_RANK_LOCAL bool comms_initialized = false;
 
 void initCommsGridQuda(int nDim, const int *dims, QudaCommsMap func, void *fdata)
 {
@@ -421,6 +425,8 @@ static void init_default_comms()
   }
 #elif defined(MPI_COMMS)
   errorQuda("When using MPI for communications, initCommsGridQuda() must be called before initQuda()");
+#elif defined(THREADS_COMMS)
+  errorQuda("When using threaded communications, initCommsGridQuda() must be called before initQuda()");
 #else // single-GPU
   const int dims[4] = {1, 1, 1, 1};
   initCommsGridQuda(4, dims, nullptr, nullptr);
@@ -697,6 +703,141 @@ static cudaGaugeField* createExtendedGauge(cudaGaugeField &in, const int *R, Tim
 // possible flag to indicate we need to recompute the clover field
 static bool invalidate_clover = true;
 
+/**
+   Residency cache for the device gauge fields created by
+   loadGaugeQuda.  Each set of precise, sloppy, preconditioner and
+   refinement copies is keyed by a checksum of the host field together
+   with the parameters that determine the device copies, so reloading
+   the resident configuration costs only the checksum.  Setting
+   QUDA_RESIDENT_GAUGE_CACHE=n with n > 1 additionally keeps up to n-1
+   previously loaded sets on the device, least-recently used first to
+   be evicted, which are restored without a host-to-device transfer.
+   Wilson and fat links share the same resident fields so share slot
+   0, while long links use slot 1.
+*/
+struct ResidentGauge {
+  uint64_t key;
+  cudaGaugeField *precise;
+  cudaGaugeField *sloppy;
+  cudaGaugeField *precondition;
+  cudaGaugeField *refinement;
+};
+
+static bool resident_gauge_valid[2] = {false, false};
+static uint64_t resident_gauge_key[2] = {0, 0};
+static std::list<ResidentGauge> gauge_cache[2]; // most recently used at the front
+
+static int gaugeCacheSize()
+{
+  static int size = 0;
+  if (size == 0) {
+    char *cache_size_env = getenv("QUDA_RESIDENT_GAUGE_CACHE");
+    size = cache_size_env ? atoi(cache_size_env) : 1;
+    if (size < 1) errorQuda("Invalid QUDA_RESIDENT_GAUGE_CACHE=%s", cache_size_env);
+  }
+  return size;
+}
+
+static inline int gaugeCacheSlot(QudaLinkType type) { return type == QUDA_ASQTAD_LONG_LINKS ? 1 : 0; }
+
+static inline void hashCombine(uint64_t &key, uint64_t value)
+{
+  key ^= value + 0x9e3779b97f4a7c15ull + (key << 6) + (key >> 2);
+}
+
+static uint64_t gaugeCacheKey(const GaugeField &in, const QudaGaugeParam &param)
+{
+  uint64_t key = in.checksum();
+  const int ints[] = { param.type, param.cuda_prec, param.reconstruct, param.cuda_prec_sloppy, param.reconstruct_sloppy,
+                       param.cuda_prec_precondition, param.reconstruct_precondition, param.cuda_prec_refinement_sloppy,
+                       param.reconstruct_refinement_sloppy, param.ga_pad, param.t_boundary, param.gauge_fix,
+                       param.staggered_phase_type, param.staggered_phase_applied };
+  for (auto i : ints) hashCombine(key, static_cast<uint64_t>(i));
+  const double doubles[] = { param.anisotropy, param.tadpole_coeff, param.scale };
+  for (auto d : doubles) { uint64_t bits; memcpy(&bits, &d, sizeof(bits)); hashCombine(key, bits); }
+  return key;
+}
+
+static ResidentGauge getResidentGauge(int slot)
+{
+  return slot == 0 ?
+    ResidentGauge{resident_gauge_key[0], gaugePrecise, gaugeSloppy, gaugePrecondition, gaugeRefinement} :
+    ResidentGauge{resident_gauge_key[1], gaugeLongPrecise, gaugeLongSloppy, gaugeLongPrecondition, gaugeLongRefinement};
+}
+
+static void setResidentGauge(int slot, const ResidentGauge &gauge)
+{
+  if (slot == 0) {
+    gaugePrecise = gauge.precise;
+    gaugeSloppy = gauge.sloppy;
+    gaugePrecondition = gauge.precondition;
+    gaugeRefinement = gauge.refinement;
+  } else {
+    gaugeLongPrecise = gauge.precise;
+    gaugeLongSloppy = gauge.sloppy;
+    gaugeLongPrecondition = gauge.precondition;
+    gaugeLongRefinement = gauge.refinement;
+  }
+}
+
+static void freeGaugeSet(ResidentGauge &gauge)
+{
+  if (gauge.precondition != gauge.refinement && gauge.refinement) delete gauge.refinement;
+  if (gauge.sloppy != gauge.precondition && gauge.precondition) delete gauge.precondition;
+  if (gauge.precise != gauge.sloppy && gauge.sloppy) delete gauge.sloppy;
+  if (gauge.precise) delete gauge.precise;
+  gauge.precise = gauge.sloppy = gauge.precondition = gauge.refinement = nullptr;
+}
+
+/**
+   Move the resident gauge fields of a slot into the residency cache,
+   if they are keyed and the cache is enabled, evicting the least
+   recently used set if the cache is full.
+*/
+static void cacheResidentGauge(int slot)
+{
+  if (resident_gauge_valid[slot] && gaugeCacheSize() > 1) {
+    gauge_cache[slot].push_front(getResidentGauge(slot));
+    setResidentGauge(slot, ResidentGauge{0, nullptr, nullptr, nullptr, nullptr});
+    while (static_cast<int>(gauge_cache[slot].size()) > gaugeCacheSize() - 1) {
+      freeGaugeSet(gauge_cache[slot].back());
+      gauge_cache[slot].pop_back();
+    }
+  }
+  resident_gauge_valid[slot] = false;
+}
+
+/**
+   Called whenever the resident gauge fields are modified or replaced
+   outside of loadGaugeQuda, so they no longer match their key.
+*/
+static void residentGaugeModified()
+{
+  for (int slot=0; slot<2; slot++) resident_gauge_valid[slot] = false;
+}
+
+static void freeGaugeCache()
+{
+  for (int slot=0; slot<2; slot++) {
+    for (auto &gauge : gauge_cache[slot]) freeGaugeSet(gauge);
+    gauge_cache[slot].clear();
+  }
+  residentGaugeModified();
+}
+
+// update the extended resident gauge field if needed
+static void updateExtendedGaugeResident()
+{
+  if (extendedGaugeResident) {
+    const int *R_ = extendedGaugeResident->R();
+    const int R[] = { R_[0], R_[1], R_[2], R_[3] };
+    QudaReconstructType recon = extendedGaugeResident->Reconstruct();
+    delete extendedGaugeResident;
+
+    extendedGaugeResident = createExtendedGauge(*gaugePrecise, R, profileGauge, false, recon);
+  }
+}
+
 void loadGaugeQuda(void *h_gauge, QudaGaugeParam *param)
 {
   profileGauge.TPSTART(QUDA_PROFILE_TOTAL);
@@ -721,20 +862,39 @@ void loadGaugeQuda(void *h_gauge, QudaGaugeParam *param)
     static_cast<GaugeField*>(new cpuGaugeField(gauge_param)) :
     static_cast<GaugeField*>(new cudaGaugeField(gauge_param));
 
-  if (in->Order() == QUDA_BQCD_GAUGE_ORDER) {
-    static size_t checksum = SIZE_MAX;
-    size_t in_checksum = in->checksum(true);
-    if (in_checksum == checksum) {
-      if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Gauge field unchanged - using cached gauge field %lu\n", checksum);
+  // look up the host field in the residency cache
+  const int slot = gaugeCacheSlot(param->type);
+  const bool cacheable = param->location == QUDA_CPU_FIELD_LOCATION && !param->use_resident_gauge &&
+    !param->overlap && param->type != QUDA_SMEARED_LINKS;
+  uint64_t key = 0;
+  bool cached = false;
+  ResidentGauge cached_gauge;
+
+  if (cacheable) {
+    key = gaugeCacheKey(*in, *param);
+    if (resident_gauge_valid[slot] && resident_gauge_key[slot] == key) {
+      if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Gauge field unchanged - using resident gauge field %lu\n", key);
       profileGauge.TPSTOP(QUDA_PROFILE_INIT);
       profileGauge.TPSTOP(QUDA_PROFILE_TOTAL);
       delete in;
       invalidate_clover = false;
       return;
     }
-    checksum = in_checksum;
-    invalidate_clover = true;
+
+    for (auto it = gauge_cache[slot].begin(); it != gauge_cache[slot].end(); ++it) {
+      if (it->key == key) {
+        cached_gauge = *it;
+        gauge_cache[slot].erase(it);
+        cached = true;
+        break;
+      }
+    }
   }
+  invalidate_clover = true;
+
+  // retire the resident gauge field to the cache, or free it below
+  if (param->type != QUDA_SMEARED_LINKS && !param->use_resident_gauge) cacheResidentGauge(slot);
+  if (param->type != QUDA_SMEARED_LINKS) resident_gauge_valid[slot] = false;
 
   // free any current gauge field before new allocations to reduce memory overhead
   switch (param->type) {
@@ -763,6 +923,23 @@ void loadGaugeQuda(void *h_gauge, QudaGaugeParam *param)
       errorQuda("Invalid gauge type %d", param->type);
   }
 
+  if (cached) {
+    if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Restoring cached gauge field %lu\n", key);
+    setResidentGauge(slot, cached_gauge);
+    resident_gauge_valid[slot] = true;
+    resident_gauge_key[slot] = key;
+    profileGauge.TPSTOP(QUDA_PROFILE_INIT);
+
+    profileGauge.TPSTART(QUDA_PROFILE_FREE);
+    delete in;
+    profileGauge.TPSTOP(QUDA_PROFILE_FREE);
+
+    updateExtendedGaugeResident();
+
+    profileGauge.TPSTOP(QUDA_PROFILE_TOTAL);
+    return;
+  }
+
   // if not preserving then copy the gauge field passed in
   cudaGaugeField *precise = nullptr;
 
@@ -887,19 +1064,16 @@ void loadGaugeQuda(void *h_gauge, QudaGaugeParam *param)
       errorQuda("Invalid gauge type %d", param->type);
   }
 
+  if (cacheable) {
+    resident_gauge_valid[slot] = true;
+    resident_gauge_key[slot] = key;
+  }
+
   profileGauge.TPSTART(QUDA_PROFILE_FREE);
   delete in;
   profileGauge.TPSTOP(QUDA_PROFILE_FREE);
 
-  if (extendedGaugeResident) {
-    // updated the resident gauge field if needed
-    const int *R_ = extendedGaugeResident->R();
-    const int R[] = { R_[0], R_[1], R_[2], R_[3] };
-    QudaReconstructType recon = extendedGaugeResident->Reconstruct();
-    delete extendedGaugeResident;
-
-    extendedGaugeResident = createExtendedGauge(*gaugePrecise, R, profileGauge, false, recon);
-  }
+  updateExtendedGaugeResident();
 
   profileGauge.TPSTOP(QUDA_PROFILE_TOTAL);
 }
@@ -1202,6 +1376,7 @@ void loadSloppyCloverQuda(QudaPrecision prec_sloppy, QudaPrecision prec_precondi
 void freeSloppyGaugeQuda()
 {
   if (!initialized) errorQuda("QUDA not initialized");
+  residentGaugeModified();
   if (gaugePrecondition != gaugeRefinement && gaugeRefinement) delete gaugeRefinement;
   if (gaugeSloppy != gaugePrecondition && gaugePrecondition) delete gaugePrecondition;
   if (gaugePrecise != gaugeSloppy && gaugeSloppy) delete gaugeSloppy;
@@ -1232,6 +1407,7 @@ void freeGaugeQuda(void)
   if (!initialized) errorQuda("QUDA not initialized");
 
   freeSloppyGaugeQuda();
+  freeGaugeCache();
 
   if (gaugePrecise) delete gaugePrecise;
   if (gaugeExtended) delete gaugeExtended;
@@ -1425,6 +1601,7 @@ void endQuda(void)
 
   pool::flush_pinned();
   pool::flush_device();
+  flush_host_arena();
 
   host_free(num_failures_h);
   num_failures_h = nullptr;
@@ -1472,6 +1649,7 @@ void endQuda(void)
     profileQCharge.Print();
     profileAPE.Print();
     profileSTOUT.Print();
+    profileWFlow.Print();
     profileProject.Print();
     profilePhase.Print();
     profileMomAction.Print();
@@ -2540,6 +2718,7 @@ multigrid_solver::multigrid_solver(QudaMultigridParam &mg_param, TimeProfile &pr
 
 void* newMultigridQuda(QudaMultigridParam *mg_param) {
   profilerStart(__func__);
+  HostArenaScope arena(__func__);
 
   pushVerbosity(mg_param->invert_param->verbosity);
 
@@ -2562,6 +2741,7 @@ void destroyMultigridQuda(void *mg) {
 void updateMultigridQuda(void *mg_, QudaMultigridParam *mg_param)
 {
   profilerStart(__func__);
+  HostArenaScope arena(__func__);
 
   pushVerbosity(mg_param->invert_param->verbosity);
 
@@ -2643,6 +2823,7 @@ void updateMultigridQuda(void *mg_, QudaMultigridParam *mg_param)
 void dumpMultigridQuda(void *mg_, QudaMultigridParam *mg_param)
 {
   profilerStart(__func__);
+  HostArenaScope arena(__func__);
   pushVerbosity(mg_param->invert_param->verbosity);
   profileInvert.TPSTART(QUDA_PROFILE_TOTAL);
 
@@ -2746,6 +2927,7 @@ void destroyDeflationQuda(void *df) {
 void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
 {
   profilerStart(__func__);
+  HostArenaScope arena(__func__);
 
   if (param->dslash_type == QUDA_DOMAIN_WALL_DSLASH ||
       param->dslash_type == QUDA_DOMAIN_WALL_4D_DSLASH ||
@@ -3505,6 +3687,7 @@ for(int i=0; i < param->num_src; i++) {
 void invertMultiShiftQuda(void **_hp_x, void *_hp_b, QudaInvertParam *param)
 {
   profilerStart(__func__);
+  HostArenaScope arena(__func__);
 
   profileMulti.TPSTART(QUDA_PROFILE_TOTAL);
   profileMulti.TPSTART(QUDA_PROFILE_INIT);
@@ -4096,6 +4279,7 @@ int computeGaugeForceQuda(void* mom, void* siteLink,  int*** input_path_buf, int
   if (qudaGaugeParam->make_resident_gauge) {
     if (gaugePrecise && gaugePrecise != cudaSiteLink) delete gaugePrecise;
     gaugePrecise = cudaSiteLink;
+    residentGaugeModified();
   } else {
     delete cudaSiteLink;
   }
@@ -4855,6 +5039,7 @@ void updateGaugeFieldQuda(void* gauge,
     if (!gaugePrecise) errorQuda("No resident gauge field allocated");
     cudaInGauge = gaugePrecise;
     gaugePrecise = nullptr;
+    residentGaugeModified();
   }
 
   if (!param->use_resident_mom) {
@@ -4884,6 +5069,7 @@ void updateGaugeFieldQuda(void* gauge,
   if (param->make_resident_gauge) {
     if (gaugePrecise != nullptr) delete gaugePrecise;
     gaugePrecise = cudaOutGauge;
+    residentGaugeModified();
   } else {
     delete cudaOutGauge;
   }
@@ -4929,6 +5115,7 @@ void updateGaugeFieldQuda(void* gauge,
    if (param->use_resident_gauge) {
      if (!gaugePrecise) errorQuda("No resident gauge field to use");
      cudaGauge = gaugePrecise;
+     residentGaugeModified(); // updated in place
    } else {
      profileProject.TPSTART(QUDA_PROFILE_H2D);
      cudaGauge->loadCPUField(*cpuGauge);
@@ -4953,6 +5140,7 @@ void updateGaugeFieldQuda(void* gauge,
    if (param->make_resident_gauge) {
      if (gaugePrecise != nullptr && cudaGauge != gaugePrecise) delete gaugePrecise;
      gaugePrecise = cudaGauge;
+     residentGaugeModified();
    } else {
      delete cudaGauge;
    }
@@ -4985,6 +5173,7 @@ void updateGaugeFieldQuda(void* gauge,
    if (param->use_resident_gauge) {
      if (!gaugePrecise) errorQuda("No resident gauge field to use");
      cudaGauge = gaugePrecise;
+     residentGaugeModified(); // updated in place
    } else {
      profilePhase.TPSTART(QUDA_PROFILE_H2D);
      cudaGauge->loadCPUField(*cpuGauge);
@@ -5007,6 +5196,7 @@ void updateGaugeFieldQuda(void* gauge,
    if (param->make_resident_gauge) {
      if (gaugePrecise != nullptr && cudaGauge != gaugePrecise) delete gaugePrecise;
      gaugePrecise = cudaGauge;
+     residentGaugeModified();
    } else {
      delete cudaGauge;
    }
@@ -5267,6 +5457,7 @@ void apply_staggered_phase_quda_() {
   if (getVerbosity() >= QUDA_VERBOSE) printfQuda("applying staggered phase\n");
   if (gaugePrecise) {
     gaugePrecise->applyStaggeredPhase();
+    residentGaugeModified();
   } else {
     errorQuda("No persistent gauge field");
   }
@@ -5277,6 +5468,7 @@ void remove_staggered_phase_quda_() {
   if (getVerbosity() >= QUDA_VERBOSE) printfQuda("removing staggered phase\n");
   if (gaugePrecise) {
     gaugePrecise->removeStaggeredPhase();
+    residentGaugeModified();
   } else {
     errorQuda("No persistent gauge field");
   }
@@ -5338,11 +5530,9 @@ void gaussGaugeQuda(long seed)
   profileGauss.TPSTOP(QUDA_PROFILE_INIT);
 
   profileGauss.TPSTART(QUDA_PROFILE_COMPUTE);
-  RNG* randstates = new RNG(data->Volume(), seed, data->X());
-  randstates->Init();
-  quda::gaugeGauss(*data, *randstates);
-  randstates->Release();
-  delete randstates;
+  residentGaugeModified();
+  RNG randstates(seed, data->X());
+  quda::gaugeGauss(*data, randstates);
   profileGauss.TPSTOP(QUDA_PROFILE_COMPUTE);
 
   profileGauss.TPSTOP(QUDA_PROFILE_TOTAL);
@@ -5584,6 +5774,61 @@ void performSTOUTnStep(unsigned int nSteps, double rho)
 }
 
 
+void performWFlownStep(unsigned int nSteps, double step_size, unsigned int meas_interval,
+                       QudaWFlowType wflow_type, double *obs)
+{
+  profileWFlow.TPSTART(QUDA_PROFILE_TOTAL);
+
+  if (gaugePrecise == nullptr) errorQuda("Gauge field must be loaded");
+
+  if (gaugeSmeared != nullptr) delete gaugeSmeared;
+  gaugeSmeared = createExtendedGauge(*gaugePrecise, R, profileWFlow);
+
+  profileWFlow.TPSTART(QUDA_PROFILE_INIT);
+  // the flow ping-pongs between gaugeSmeared and gaugeTemp, and the
+  // Runge-Kutta accumulator holds non-unitary matrices so cannot be compressed
+  GaugeFieldParam gParam(*gaugeSmeared);
+  auto *gaugeTemp = new cudaGaugeField(gParam);
+  gParam.reconstruct = QUDA_RECONSTRUCT_NO;
+  gParam.setPrecision(gParam.precision, true);
+  auto *gaugeZ = new cudaGaugeField(gParam);
+  profileWFlow.TPSTOP(QUDA_PROFILE_INIT);
+
+  int n_meas = 0;
+  for (unsigned int i=0; i<=nSteps; i++) {
+    if (i > 0) {
+      profileWFlow.TPSTART(QUDA_PROFILE_COMPUTE);
+      WFlowStep(*gaugeTemp, *gaugeZ, *gaugeSmeared, step_size, wflow_type);
+      std::swap(gaugeSmeared, gaugeTemp);
+      profileWFlow.TPSTOP(QUDA_PROFILE_COMPUTE);
+    }
+
+    if (meas_interval > 0 && i % meas_interval == 0) {
+      profileWFlow.TPSTART(QUDA_PROFILE_COMPUTE);
+      double3 wobs = computeWFlowObservables(*gaugeSmeared);
+      profileWFlow.TPSTOP(QUDA_PROFILE_COMPUTE);
+
+      double t = i * step_size;
+      if (getVerbosity() >= QUDA_SUMMARIZE) {
+        printfQuda("Flow step %u t = %e E_plaq = %e E = %e t^2 E = %e Q = %e\n",
+                   i, t, wobs.x, wobs.y, t*t*wobs.y, wobs.z);
+      }
+      if (obs) {
+        obs[4*n_meas+0] = t;
+        obs[4*n_meas+1] = wobs.y;
+        obs[4*n_meas+2] = t*t*wobs.y;
+        obs[4*n_meas+3] = wobs.z;
+      }
+      n_meas++;
+    }
+  }
+
+  delete gaugeZ;
+  delete gaugeTemp;
+
+  profileWFlow.TPSTOP(QUDA_PROFILE_TOTAL);
+}
+
 int computeGaugeFixingOVRQuda(void* gauge, const unsigned int gauge_dir,  const unsigned int Nsteps, \
   const unsigned int verbose_interval, const double relax_boost, const double tolerance, const unsigned int reunit_interval, \
   const unsigned int  stopWtheta, QudaGaugeParam* param , double* timeinfo)
@@ -5652,6 +5897,7 @@ int computeGaugeFixingOVRQuda(void* gauge, const unsigned int gauge_dir,  const
   if (param->make_resident_gauge) {
     if (gaugePrecise != nullptr) delete gaugePrecise;
     gaugePrecise = cudaInGauge;
+    residentGaugeModified();
   } else {
     delete cudaInGauge;
   }
@@ -5729,6 +5975,7 @@ int computeGaugeFixingFFTQuda(void* gauge, const unsigned int gauge_dir,  const
   if (param->make_resident_gauge) {
     if (gaugePrecise != nullptr) delete gaugePrecise;
     gaugePrecise = cudaInGauge;
+    residentGaugeModified();
   } else {
     delete cudaInGauge;
   }
@@ -0,0 +1,355 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+
+#include <quda_internal.h>
+#include <color_spinor_field.h>
+#include <blas_quda.h>
+#include <dslash_quda.h>
+#include <invert_quda.h>
+#include <util_quda.h>
+
+/**
+   @file inv_pipelined_cg_quda.cpp
+
+   Pipelined CG of Ghysels and Vanroose (Parallel Computing 40, 224
+   (2014)).  Alongside the residual r and search direction p it
+   carries w = A r, s = A p and z = A s, so that each iteration is
+
+     gamma = (r,r), wr = (w,r)    (global sum in flight)
+     q = A w                      (overlaps the global sum)
+     beta = gamma / gamma_old
+     alpha = gamma / (wr - beta * gamma / alpha_old)
+     p = r + beta * p, x += alpha * p
+     s = w + beta * s, z = q + beta * z
+     r -= alpha * s, w -= alpha * z
+
+   As in CG the x update lags one iteration so that it fuses with the
+   p update, and the remaining vector updates are fused with the inner
+   products needed by the next iteration.
+*/
+
+namespace quda {
+
+  PipelinedCG::PipelinedCG(DiracMatrix &mat, DiracMatrix &matSloppy, SolverParam &param, TimeProfile &profile) :
+    Solver(param, profile), mat(mat), matSloppy(matSloppy), yp(nullptr), rp(nullptr), tmpp(nullptr),
+    tmp2p(nullptr), tmp3p(nullptr), rSloppyp(nullptr), xSloppyp(nullptr), pp(nullptr), sp(nullptr),
+    zp(nullptr), wp(nullptr), qp(nullptr), init(false)
+  {
+
+  }
+
+  PipelinedCG::~PipelinedCG() {
+    profile.TPSTART(QUDA_PROFILE_FREE);
+    if ( init ) {
+      delete rp;
+      delete yp;
+      if (param.precision != param.precision_sloppy) {
+        delete rSloppyp;
+        delete xSloppyp;
+      }
+      delete pp;
+      delete sp;
+      delete zp;
+      delete wp;
+      delete qp;
+      delete tmpp;
+      if (!mat.isStaggered()) {
+        delete tmp2p;
+        if (tmp3p != tmpp) delete tmp3p;
+      }
+
+      init = false;
+    }
+    profile.TPSTOP(QUDA_PROFILE_FREE);
+  }
+
+  void PipelinedCG::operator()(ColorSpinorField &x, ColorSpinorField &b) {
+    if (checkLocation(x, b) != QUDA_CUDA_FIELD_LOCATION)
+      errorQuda("Pipelined CG requires device fields, got location %d", x.Location());
+    if (checkPrecision(x, b) != param.precision)
+      errorQuda("Precision mismatch: expected=%d, received=%d", param.precision, x.Precision());
+    if (param.residual_type & QUDA_HEAVY_QUARK_RESIDUAL)
+      errorQuda("Heavy-quark residual not supported by pipelined CG");
+
+    if (param.maxiter == 0 || param.Nsteps == 0) {
+      if (param.use_init_guess == QUDA_USE_INIT_GUESS_NO) blas::zero(x);
+      return;
+    }
+
+    profile.TPSTART(QUDA_PROFILE_INIT);
+
+    double b2 = blas::norm2(b);
+
+    // Check to see that we're not trying to invert on a zero-field source
+    if (b2 == 0 && param.compute_null_vector == QUDA_COMPUTE_NULL_VECTOR_NO) {
+      profile.TPSTOP(QUDA_PROFILE_INIT);
+      printfQuda("Warning: inverting on zero-field source\n");
+      x = b;
+      param.true_res = 0.0;
+      param.true_res_hq = 0.0;
+      return;
+    }
+
+    const bool mixed_precision = (param.precision != param.precision_sloppy);
+
+    if (!init) {
+      ColorSpinorParam csParam(x);
+      csParam.create = QUDA_NULL_FIELD_CREATE;
+      rp = ColorSpinorField::Create(csParam);
+      yp = ColorSpinorField::Create(csParam);
+
+      // sloppy fields
+      csParam.setPrecision(param.precision_sloppy);
+      if (mixed_precision) {
+        rSloppyp = ColorSpinorField::Create(csParam);
+        xSloppyp = ColorSpinorField::Create(csParam);
+      } else {
+        rSloppyp = rp;
+      }
+      pp = ColorSpinorField::Create(csParam);
+      sp = ColorSpinorField::Create(csParam);
+      zp = ColorSpinorField::Create(csParam);
+      wp = ColorSpinorField::Create(csParam);
+      qp = ColorSpinorField::Create(csParam);
+
+      // temporary fields
+      tmpp = ColorSpinorField::Create(csParam);
+      if (!mat.isStaggered()) {
+        // tmp2 only needed for multi-gpu Wilson-like kernels
+        tmp2p = ColorSpinorField::Create(csParam);
+        // additional high-precision temporary if Wilson and mixed-precision
+        csParam.setPrecision(param.precision);
+        tmp3p = mixed_precision ? ColorSpinorField::Create(csParam) : tmpp;
+      } else {
+        tmp3p = tmp2p = tmpp;
+      }
+
+      init = true;
+    }
+
+    ColorSpinorField &r = *rp;
+    ColorSpinorField &y = *yp;
+    ColorSpinorField &rSloppy = *rSloppyp;
+    ColorSpinorField &xSloppy = mixed_precision ? *xSloppyp : x;
+    ColorSpinorField &p = *pp;
+    ColorSpinorField &s = *sp;
+    ColorSpinorField &z = *zp;
+    ColorSpinorField &w = *wp;
+    ColorSpinorField &q = *qp;
+    ColorSpinorField &tmp = *tmpp;
+    ColorSpinorField &tmp2 = *tmp2p;
+    ColorSpinorField &tmp3 = *tmp3p;
+
+    // compute initial residual
+    double r2 = 0.0;
+    if (param.use_init_guess == QUDA_USE_INIT_GUESS_YES) {
+      mat(r, x, y, tmp3);
+      r2 = blas::xmyNorm(b, r);
+      if (b2 == 0) b2 = r2;
+      blas::copy(y, x);
+    } else {
+      if (&r != &b) blas::copy(r, b);
+      r2 = b2;
+      blas::zero(y);
+    }
+    blas::zero(x);
+    if (&x != &xSloppy) blas::zero(xSloppy);
+    blas::copy(rSloppy, r);
+
+    // p, s and z are scaled by beta = 0 on the first iteration so must be finite
+    blas::zero(p);
+    blas::zero(s);
+    blas::zero(z);
+
+    profile.TPSTOP(QUDA_PROFILE_INIT);
+    profile.TPSTART(QUDA_PROFILE_PREAMBLE);
+
+    double stop = stopping(param.tol, b2, param.residual_type);  // stopping condition of solver
+
+    double rNorm = sqrt(r2);
+    double r0Norm = rNorm;
+    double maxrx = rNorm;
+    double maxrr = rNorm;
+    double delta = param.delta;
+
+    // this parameter determines how many consective reliable update
+    // residual increases we tolerate before terminating the solver,
+    // i.e., how long do we want to keep trying to converge
+    const int maxResIncrease = param.max_res_increase; //  check if we reached the limit of our tolerance
+    const int maxResIncreaseTotal = param.max_res_increase_total;
+
+    int resIncrease = 0;
+    int resIncreaseTotal = 0;
+
+    profile.TPSTOP(QUDA_PROFILE_PREAMBLE);
+    profile.TPSTART(QUDA_PROFILE_COMPUTE);
+    blas::flops = 0;
+
+    matSloppy(w, rSloppy, tmp, tmp2);
+    double gamma = r2;
+    double wr = blas::reDotProduct(w, rSloppy);
+    double gamma_old = 0.0;
+    double alpha = 0.0;
+    double alpha_old = 0.0;
+    double alpha_x = 0.0; // coefficient of the lagged x += alpha * p update
+    double beta = 0.0;
+    bool restart = true; // take a steepest-descent step on the first iteration
+
+    blas::ReduceFuture<double2> reduction; // (r,r) and (w,r) of the next iteration
+
+    int k = 0;
+    int rUpdate = 0;
+
+    PrintStats("PipelinedCG", k, r2, b2, 0.0);
+
+    bool converged = convergence(r2, 0.0, stop, param.tol_hq);
+
+    while ( !converged && k < param.maxiter ) {
+      // q = A w, overlapping the global sum of the inner products in flight
+      matSloppy(q, w, tmp, tmp2);
+
+      if (k > 0) {
+        double2 rr = reduction.get();
+        gamma = rr.x;
+        wr = rr.y;
+        r2 = gamma;
+      }
+
+      // reliable update conditions
+      rNorm = sqrt(r2);
+      if (rNorm > maxrx) maxrx = rNorm;
+      if (rNorm > maxrr) maxrr = rNorm;
+      int updateX = (rNorm < delta*r0Norm && r0Norm <= maxrx) ? 1 : 0;
+      int updateR = ((rNorm < delta*maxrr && r0Norm <= maxrr) || updateX) ? 1 : 0;
+
+      // force a reliable update if we are within target tolerance (only if doing reliable updates)
+      if ( convergence(r2, 0.0, stop, param.tol_hq) && param.delta >= param.tol ) updateX = 1;
+
+      if (updateR || updateX) {
+        blas::axpy(alpha_x, p, xSloppy);
+        alpha_x = 0.0;
+
+        blas::copy(x, xSloppy); // nop when these pointers alias
+        blas::xpy(x, y);
+        mat(r, y, x, tmp3); //  here we can use x as tmp
+        r2 = blas::xmyNorm(b, r);
+
+        blas::copy(rSloppy, r); //nop when these pointers alias
+        blas::zero(xSloppy);
+
+        rNorm = sqrt(r2);
+        maxrr = rNorm;
+        maxrx = rNorm;
+
+        // break-out check if we have reached the limit of the precision
+        if (rNorm > r0Norm && updateX) { // reuse r0Norm for this
+          resIncrease++;
+          resIncreaseTotal++;
+          warningQuda("PipelinedCG: new reliable residual norm %e is greater than previous reliable residual norm %e (total #inc %i)",
+                      rNorm, r0Norm, resIncreaseTotal);
+          if ( resIncrease > maxResIncrease or resIncreaseTotal > maxResIncreaseTotal) {
+            warningQuda("PipelinedCG: solver exiting due to too many true residual norm increases");
+            break;
+          }
+        } else {
+          resIncrease = 0;
+        }
+
+        r0Norm = rNorm;
+        rUpdate++;
+
+        converged = convergence(r2, 0.0, stop, param.tol_hq);
+        PrintStats("PipelinedCG", k, r2, b2, 0.0);
+        if (converged) break;
+
+        // explicitly restore the orthogonality of the search direction
+        // to the new residual, and rebuild the auxiliary vectors for
+        // the new residual and the retained search direction
+        Complex rp = blas::cDotProduct(rSloppy, p) / r2;
+        blas::caxpy(-rp, rSloppy, p);
+
+        matSloppy(w, rSloppy, tmp, tmp2);
+        matSloppy(q, w, tmp, tmp2);
+        matSloppy(s, p, tmp, tmp2);
+        matSloppy(z, s, tmp, tmp2);
+
+        // with p_new = r + beta * p, (p_new, A p_new) = (r,w) + 2 beta (r,s) + beta^2 (p,s)
+        gamma = r2;
+        wr = blas::reDotProduct(w, rSloppy);
+        beta = restart ? 0.0 : gamma / gamma_old;
+        double pAp = wr + beta * (2.0 * blas::reDotProduct(rSloppy, s) + beta * blas::reDotProduct(p, s));
+        alpha = gamma / pAp;
+      } else {
+        if (k > 0) PrintStats("PipelinedCG", k, r2, b2, 0.0);
+        converged = convergence(r2, 0.0, stop, param.tol_hq);
+        if (converged) break;
+
+        if (!restart) {
+          beta = gamma / gamma_old;
+          alpha = gamma / (wr - beta * gamma / alpha_old);
+        }
+
+        // the recurrence for (p, A p) has lost positivity so restart
+        if (restart || !(alpha > 0.0)) {
+          if (!restart && getVerbosity() >= QUDA_VERBOSE)
+            printfQuda("PipelinedCG: restarting at iteration %d due to breakdown\n", k);
+          beta = 0.0;
+          alpha = gamma / wr;
+        }
+      }
+
+      // x += alpha_old * p, p = r + beta * p
+      blas::axpyZpbx(alpha_x, p, xSloppy, rSloppy, beta);
+
+      // s = w + beta * s, z = q + beta * z, r -= alpha * s, w -= alpha * z
+      reduction = blas::pipelinedCGUpdateAsync(alpha, beta, s, z, rSloppy, w, q);
+
+      gamma_old = gamma;
+      alpha_old = alpha;
+      alpha_x = alpha;
+      restart = false;
+      k++;
+    }
+
+    // residual of the final iteration if we ran out of iterations
+    if (!converged && k == param.maxiter) r2 = reduction.get().x;
+
+    blas::axpy(alpha_x, p, xSloppy);
+    blas::copy(x, xSloppy);
+    blas::xpy(y, x);
+
+    profile.TPSTOP(QUDA_PROFILE_COMPUTE);
+    profile.TPSTART(QUDA_PROFILE_EPILOGUE);
+
+    param.secs = profile.Last(QUDA_PROFILE_COMPUTE);
+    double gflops = (blas::flops + mat.flops() + matSloppy.flops())*1e-9;
+    param.gflops = gflops;
+    param.iter += k;
+
+    if (k == param.maxiter)
+      warningQuda("Exceeded maximum iterations %d", param.maxiter);
+
+    if (getVerbosity() >= QUDA_VERBOSE)
+      printfQuda("PipelinedCG: Reliable updates = %d\n", rUpdate);
+
+    if (param.compute_true_res) {
+      // compute the true residuals
+      mat(r, x, y, tmp3);
+      param.true_res = sqrt(blas::xmyNorm(b, r) / b2);
+      param.true_res_hq = sqrt(blas::HeavyQuarkResidualNorm(x, r).z);
+    }
+
+    PrintSummary("PipelinedCG", k, r2, b2, stop, param.tol_hq);
+
+    // reset the flops counters
+    blas::flops = 0;
+    mat.flops();
+    matSloppy.flops();
+
+    profile.TPSTOP(QUDA_PROFILE_EPILOGUE);
+
+    return;
+  }
+
+} // namespace quda
@@ -159,7 +159,8 @@ namespace quda {
       TuneKey tuneKey() const { return TuneKey(meta.VolString(), typeid(*this).name(), aux); }
 
       long long flops() const { return 792*arg.X[0]*arg.X[1]*arg.X[2]*arg.X[3]; } 
-      long long bytes() const { return 0; } // Fix this
+      // per site and direction: load a gauge and an oprod link, store a momentum
+      long long bytes() const { return 4ll * arg.threads * (arg.gauge.Bytes() + arg.oprod.Bytes() + arg.mom.Bytes()); }
     };
 
   template<typename Float, typename Oprod, typename Gauge, typename Mom>
@@ -367,8 +368,9 @@ class KSLongLinkForce : Tunable {
 
   TuneKey tuneKey() const { return TuneKey(meta.VolString(), typeid(*this).name(), aux); }
 
-  long long flops() const { return 0; } // Fix this
-  long long bytes() const { return 0; } // Fix this
+  // the body of computeKSLongLinkForceCore is disabled, so the kernel does no work
+  long long flops() const { return 0; }
+  long long bytes() const { return 0; }
 }; 
 
 
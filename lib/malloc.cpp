@@ -1,10 +1,20 @@
 #include <cstdlib>
 #include <cstdio>
+#include <cstring>
 #include <string>
 #include <map>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
 #include <unistd.h> // for getpagesize()
 #include <execinfo.h> // for backtrace
 #include <quda_internal.h>
+#include <tune_quda.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #ifdef USE_QDPJIT
 #include "qdp_quda.h"
@@ -22,39 +32,106 @@ namespace quda {
     N_ALLOC_TYPE
   };
 
-  class MemAlloc {
-
-  public:
-    std::string func;
-    std::string file;
+  /**
+     Location and size of an allocation.  func and file are the string
+     literals passed by the allocation macros, so only the pointers are
+     kept.
+   */
+  struct MemAlloc {
+    const char *func;
+    const char *file;
     int line;
     size_t size;
     size_t base_size;
 
-    MemAlloc()
-      : line(-1), size(0), base_size(0) { }
-
-    MemAlloc(std::string func, std::string file, int line)
+    MemAlloc(const char *func = "", const char *file = "", int line = -1)
       : func(func), file(file), line(line), size(0), base_size(0) { }
+  };
 
-    MemAlloc& operator=(const MemAlloc &a) {
-      if (&a != this) {
-	func = a.func;
-	file = a.file;
-	line = a.line;
-	size = a.size;
-	base_size = a.base_size;
-      }
-      return *this;
-    }
+  /**
+     Raise an atomic high-water mark to at least value
+   */
+  static inline void atomic_max(std::atomic<long> &max, long value)
+  {
+    long old = max.load(std::memory_order_relaxed);
+    while (value > old && !max.compare_exchange_weak(old, value, std::memory_order_relaxed)) { }
+  }
+
+  /** number of log2 size buckets in the per-call-site histograms */
+  static constexpr int n_size_bucket = 40;
+
+  /**
+     Statistics of a call site that allocates memory.  Call sites are
+     interned on first use into a fixed open-addressing table keyed by
+     the (func, file, line) pointers, and are never removed.
+   */
+  struct CallSite {
+    std::atomic<int> state;          // 0 = empty, 1 = being claimed, 2 = ready
+    const char *func;
+    const char *file;
+    int line;
+    AllocType type;
+    std::atomic<long> count;         // live allocations
+    std::atomic<long> bytes;         // live bytes
+    std::atomic<long> max_bytes;     // high-water of the live bytes
+    std::atomic<long> hist_count[n_size_bucket]; // allocations by log2 size
+    std::atomic<long> hist_bytes[n_size_bucket]; // bytes allocated by log2 size
   };
 
+  static constexpr int max_call_site = 2048;
+  static CallSite call_site[max_call_site];
 
-  static std::map<void *, MemAlloc> alloc[N_ALLOC_TYPE];
-  static long total_bytes[N_ALLOC_TYPE] = {0};
-  static long max_total_bytes[N_ALLOC_TYPE] = {0};
-  static long total_host_bytes, max_total_host_bytes;
-  static long total_pinned_bytes, max_total_pinned_bytes;
+  /**
+     Entry of the table of live allocations, keyed by the pointer with
+     0 marking an empty slot.  Inserts and removals are serialized by
+     live_alloc_mutex, while lookups (is_alloc on every free) take no
+     lock.  An entry's fields are written before its key is published
+     with a release store, so a lookup never sees a half-written entry.
+     Removal shifts the later entries of the probe run back into the
+     hole rather than leaving a tombstone.  Since a shift can move an
+     entry past a concurrent lookup, and growing replaces the table,
+     lookups are validated against live_alloc_seq, which is odd while
+     either is in progress, and retried if it changed.
+   */
+  struct LiveAlloc {
+    std::atomic<uintptr_t> key;
+    std::atomic<int> site;
+    std::atomic<AllocType> type;
+    std::atomic<size_t> base_size;
+  };
+
+  /** Copy of the fields of a live allocation entry */
+  struct AllocInfo {
+    int site;
+    AllocType type;
+    size_t base_size;
+  };
+
+  /**
+     Open-addressing table of live allocations.  The table doubles
+     once it is half full, keeping the probe runs short.  Replaced
+     tables are never freed, since a lookup may still be probing
+     them, which costs at most the size of the current table.
+   */
+  struct LiveTable {
+    size_t size;
+    LiveAlloc *slot;
+  };
+
+  static constexpr uintptr_t empty_key = 0;
+  static constexpr size_t min_live_alloc = 1 << 12;
+  static LiveAlloc live_alloc_initial[min_live_alloc];
+  static LiveTable live_table_initial = {min_live_alloc, live_alloc_initial};
+  static std::atomic<LiveTable *> live_table(&live_table_initial);
+  static size_t n_live_total = 0; // guarded by live_alloc_mutex
+  static std::mutex live_alloc_mutex;
+  static std::atomic<unsigned> live_alloc_seq;
+
+  static std::atomic<long> n_live[N_ALLOC_TYPE];
+  static std::atomic<long> total_bytes[N_ALLOC_TYPE];
+  static std::atomic<long> max_total_bytes[N_ALLOC_TYPE];
+  static std::atomic<long> total_host_bytes, max_total_host_bytes;
+  static std::atomic<long> total_pinned_bytes, max_total_pinned_bytes;
 
   long device_allocated_peak() { return max_total_bytes[DEVICE]; }
 
@@ -64,6 +141,131 @@ namespace quda {
 
   long host_allocated_peak() { return max_total_bytes[HOST]; }
 
+  /**
+     64-bit finalizer of splitmix64, so that every bit of the key
+     reaches the low bits used to index the tables
+   */
+  static inline size_t hash(uint64_t key)
+  {
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ull;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebull;
+    key ^= key >> 31;
+    return key;
+  }
+
+  /**
+     @return Index of the call site, interning it if first seen
+   */
+  static int intern(const MemAlloc &a, AllocType type)
+  {
+    const uintptr_t key = reinterpret_cast<uintptr_t>(a.func) ^ (reinterpret_cast<uintptr_t>(a.file) << 1) ^ a.line;
+    for (size_t i = 0; i < max_call_site; i++) {
+      CallSite &s = call_site[(hash(key) + i) % max_call_site];
+      int state = s.state.load(std::memory_order_acquire);
+      if (state == 0) {
+        if (s.state.compare_exchange_strong(state, 1, std::memory_order_acquire)) {
+          s.func = a.func;
+          s.file = a.file;
+          s.line = a.line;
+          s.type = type;
+          s.state.store(2, std::memory_order_release);
+          return &s - call_site;
+        }
+      }
+      while (state == 1) state = s.state.load(std::memory_order_acquire);
+      if (s.func == a.func && s.file == a.file && s.line == a.line) return &s - call_site;
+    }
+    errorQuda("Allocation call-site table is full (max_call_site = %d)", max_call_site);
+    return -1;
+  }
+
+  /**
+     @return Slot of table t holding key, or t.size if it is not in the table
+   */
+  static size_t find_slot(const LiveTable &t, uintptr_t key)
+  {
+    for (size_t i = 0; i < t.size; i++) {
+      const size_t j = (hash(key) + i) % t.size;
+      const uintptr_t k = t.slot[j].key.load(std::memory_order_acquire);
+      if (k == key) return j;
+      if (k == empty_key) break;
+    }
+    return t.size;
+  }
+
+  /**
+     Insert an entry into table t, which must have a free slot.  Only
+     called with live_alloc_mutex held.
+   */
+  static void insert_slot(LiveTable &t, uintptr_t key, int site, AllocType type, size_t base_size)
+  {
+    for (size_t i = 0;; i++) {
+      LiveAlloc &l = t.slot[(hash(key) + i) % t.size];
+      if (l.key.load(std::memory_order_relaxed) == empty_key) {
+        l.site.store(site, std::memory_order_relaxed);
+        l.type.store(type, std::memory_order_relaxed);
+        l.base_size.store(base_size, std::memory_order_relaxed);
+        l.key.store(key, std::memory_order_release);
+        return;
+      }
+    }
+  }
+
+  /**
+     Replace the table by one of twice the size.  Only called with
+     live_alloc_mutex held.
+   */
+  static void grow_live_table()
+  {
+    const LiveTable &old_table = *live_table.load(std::memory_order_relaxed);
+    LiveTable *t = new LiveTable{2 * old_table.size, new LiveAlloc[2 * old_table.size]()};
+    for (size_t i = 0; i < old_table.size; i++) {
+      const LiveAlloc &l = old_table.slot[i];
+      const uintptr_t k = l.key.load(std::memory_order_relaxed);
+      if (k == empty_key) continue;
+      insert_slot(*t, k, l.site.load(std::memory_order_relaxed), l.type.load(std::memory_order_relaxed),
+                  l.base_size.load(std::memory_order_relaxed));
+    }
+
+    const unsigned seq = live_alloc_seq.load(std::memory_order_relaxed);
+    live_alloc_seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    live_table.store(t, std::memory_order_release);
+    live_alloc_seq.store(seq + 2, std::memory_order_release);
+  }
+
+  /**
+     @return Whether ptr is tracked, in which case its entry is copied to info
+   */
+  static bool find_alloc(const void *ptr, AllocInfo &info)
+  {
+    const uintptr_t key = reinterpret_cast<uintptr_t>(ptr);
+    while (true) {
+      const unsigned seq = live_alloc_seq.load(std::memory_order_acquire);
+      if (seq & 1) continue;
+      const LiveTable &t = *live_table.load(std::memory_order_acquire);
+      const size_t i = find_slot(t, key);
+      const bool found = i < t.size;
+      if (found) {
+        const LiveAlloc &l = t.slot[i];
+        info.site = l.site.load(std::memory_order_relaxed);
+        info.type = l.type.load(std::memory_order_relaxed);
+        info.base_size = l.base_size.load(std::memory_order_relaxed);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (live_alloc_seq.load(std::memory_order_relaxed) == seq) return found;
+    }
+  }
+
+  static inline int size_bucket(size_t size)
+  {
+    int b = 0;
+    while (size > 1 && b < n_size_bucket - 1) { size >>= 1; b++; }
+    return b;
+  }
+
   static void print_trace (void) {
     void *array[10];
     size_t size;
@@ -75,6 +277,8 @@ namespace quda {
     free(strings);
   }
 
+  static const char *type_str[] = {"Device", "Device Pinned", "Host  ", "Pinned", "Mapped"};
+
   static void print_alloc_header()
   {
     printfQuda("Type    Pointer          Size             Location\n");
@@ -84,43 +288,90 @@ namespace quda {
 
   static void print_alloc(AllocType type)
   {
-    const char *type_str[] = {"Device", "Device Pinned", "Host  ", "Pinned", "Mapped"};
-    std::map<void *, MemAlloc>::iterator entry;
-
-    for (entry = alloc[type].begin(); entry != alloc[type].end(); entry++) {
-      void *ptr = entry->first;
-      MemAlloc a = entry->second;
-      printfQuda("%s  %15p  %15lu  %s(), %s:%d\n", type_str[type], ptr, (unsigned long) a.base_size,
-		 a.func.c_str(), a.file.c_str(), a.line);
+    std::lock_guard<std::mutex> lock(live_alloc_mutex);
+    const LiveTable &t = *live_table.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < t.size; i++) {
+      const LiveAlloc &l = t.slot[i];
+      uintptr_t key = l.key.load(std::memory_order_relaxed);
+      if (key == empty_key || l.type != type) continue;
+      const CallSite &s = call_site[l.site];
+      printfQuda("%s  %15p  %15lu  %s(), %s:%d\n", type_str[type], reinterpret_cast<void *>(key),
+		 (unsigned long) l.base_size, s.func, s.file, s.line);
     }
   }
 
 
   static void track_malloc(const AllocType &type, const MemAlloc &a, void *ptr)
   {
-    total_bytes[type] += a.base_size;
-    if (total_bytes[type] > max_total_bytes[type]) {
-      max_total_bytes[type] = total_bytes[type];
-    }
+    const long size = a.base_size;
+    total_bytes[type] += size;
+    atomic_max(max_total_bytes[type], total_bytes[type]);
     if (type != DEVICE && type != DEVICE_PINNED) {
-      total_host_bytes += a.base_size;
-      if (total_host_bytes > max_total_host_bytes) {
-	max_total_host_bytes = total_host_bytes;
-      }
+      atomic_max(max_total_host_bytes, total_host_bytes += size);
     }
     if (type == PINNED || type == MAPPED) {
-      total_pinned_bytes += a.base_size;
-      if (total_pinned_bytes > max_total_pinned_bytes) {
-	max_total_pinned_bytes = total_pinned_bytes;
-      }
+      atomic_max(max_total_pinned_bytes, total_pinned_bytes += size);
     }
-    alloc[type][ptr] = a;
+
+    const int site = intern(a, type);
+    CallSite &s = call_site[site];
+    s.count++;
+    atomic_max(s.max_bytes, s.bytes += size);
+    const int b = size_bucket(a.base_size);
+    s.hist_count[b]++;
+    s.hist_bytes[b] += size;
+
+    const uintptr_t key = reinterpret_cast<uintptr_t>(ptr);
+    std::lock_guard<std::mutex> lock(live_alloc_mutex);
+    if (2 * (n_live_total + 1) > live_table.load(std::memory_order_relaxed)->size) grow_live_table();
+    insert_slot(*live_table.load(std::memory_order_relaxed), key, site, type, a.base_size);
+    n_live_total++;
+    n_live[type]++;
+  }
+
+
+  /**
+     @return Whether ptr is a live allocation of the given type
+   */
+  static bool is_alloc(const AllocType &type, const void *ptr)
+  {
+    AllocInfo info;
+    return find_alloc(ptr, info) && info.type == type;
   }
 
 
   static void track_free(const AllocType &type, void *ptr)
   {
-    size_t size = alloc[type][ptr].base_size;
+    std::unique_lock<std::mutex> lock(live_alloc_mutex);
+    LiveTable &t = *live_table.load(std::memory_order_relaxed);
+    size_t i = find_slot(t, reinterpret_cast<uintptr_t>(ptr));
+    if (i == t.size) errorQuda("Attempt to untrack unknown pointer %p", ptr);
+    const long size = t.slot[i].base_size.load(std::memory_order_relaxed);
+    CallSite &s = call_site[t.slot[i].site.load(std::memory_order_relaxed)];
+
+    // remove the entry by shifting back the later entries of its probe
+    // run whose home slot is not between the hole and themselves
+    const unsigned seq = live_alloc_seq.load(std::memory_order_relaxed);
+    live_alloc_seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t j = (i + 1) % t.size;; j = (j + 1) % t.size) {
+      LiveAlloc &l = t.slot[j];
+      const uintptr_t k = l.key.load(std::memory_order_relaxed);
+      if (k == empty_key) break;
+      const size_t h = hash(k) % t.size;
+      if (i <= j ? (i < h && h <= j) : (i < h || h <= j)) continue;
+      LiveAlloc &hole = t.slot[i];
+      hole.site.store(l.site.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      hole.type.store(l.type.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      hole.base_size.store(l.base_size.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      hole.key.store(k, std::memory_order_relaxed);
+      i = j;
+    }
+    t.slot[i].key.store(empty_key, std::memory_order_relaxed);
+    live_alloc_seq.store(seq + 2, std::memory_order_release);
+    n_live_total--;
+    lock.unlock();
+
     total_bytes[type] -= size;
     if (type != DEVICE && type != DEVICE_PINNED) {
       total_host_bytes -= size;
@@ -128,7 +379,9 @@ namespace quda {
     if (type == PINNED || type == MAPPED) {
       total_pinned_bytes -= size;
     }
-    alloc[type].erase(ptr);
+    s.count--;
+    s.bytes -= size;
+    n_live[type]--;
   }
 
 
@@ -154,7 +407,7 @@ namespace quda {
     int align = posix_memalign(&ptr, page_size, a.base_size);
     if (!ptr || align != 0) {
 #endif
-      printfQuda("ERROR: Failed to allocate aligned host memory of size %zu (%s:%d in %s())\n", size, a.file.c_str(), a.line, a.func.c_str());
+      printfQuda("ERROR: Failed to allocate aligned host memory of size %zu (%s:%d in %s())\n", size, a.file, a.line, a.func);
       errorQuda("Aborting");
     }
     return ptr;
@@ -220,6 +473,202 @@ namespace quda {
   }
 
 
+  /**
+     Bump allocator for short-lived host temporaries.  Allocations
+     made with arena_malloc() while a HostArenaScope is open are carved
+     out of a list of chunks, and are all released when the scope that
+     made them closes, regardless of whether host_free() was called on
+     them.  Chunks are held until the outermost scope closes; if more
+     than one was needed they are then replaced by a single chunk sized
+     for the high-water mark on the next use.  Each thread has its own
+     arena, so scopes opened on different threads never release each
+     other's allocations; an arena allocation must be used and freed
+     on the thread that made it.
+   */
+  class HostArena {
+
+    struct Chunk {
+      char *base;
+      size_t size;
+    };
+
+    /** allocations are aligned to a cache line */
+    static constexpr size_t align = 64;
+
+    std::vector<Chunk> chunks;
+    size_t chunk = 0;         // chunk currently being bumped
+    size_t offset = 0;        // offset into the current chunk
+    size_t used = 0;          // bytes handed out by the open scopes
+    size_t count = 0;         // running number of allocations
+    size_t bytes = 0;         // running number of bytes allocated
+    size_t chunk_size = 4 << 20;
+    size_t max_used = 0;
+    int depth = 0;
+
+#ifdef HOST_DEBUG
+    /** live arena allocations, mirroring the tracking of safe_malloc */
+    std::map<void *, MemAlloc> live;
+#endif
+
+    void free_chunks()
+    {
+      for (auto &c : chunks) {
+        track_free(HOST, c.base);
+        free(c.base);
+      }
+      chunks.clear();
+      chunk = 0;
+      offset = 0;
+    }
+
+  public:
+    ~HostArena() { free_chunks(); }
+
+    struct Mark {
+      size_t chunk, offset, used, count, bytes;
+    };
+
+    bool active() const { return depth > 0; }
+
+    Mark open()
+    {
+      depth++;
+      return Mark{chunk, offset, used, count, bytes};
+    }
+
+    void close(const Mark &mark, const char *name)
+    {
+      if (getVerbosity() >= QUDA_DEBUG_VERBOSE)
+        printfQuda("Host arena scope %s: %zu allocations, %zu bytes\n", name, count - mark.count, bytes - mark.bytes);
+
+#ifdef HOST_DEBUG
+      for (auto it = live.begin(); it != live.end();) {
+        if (contains(it->first, mark.chunk, mark.offset)) it = live.erase(it);
+        else it++;
+      }
+#endif
+
+      chunk = mark.chunk;
+      offset = mark.offset;
+      used = mark.used;
+
+      if (--depth == 0 && chunks.size() > 1) {
+        chunk_size = std::max(chunk_size, max_used);
+        free_chunks();
+      }
+    }
+
+    void *malloc_(const char *func, const char *file, int line, size_t size)
+    {
+      size = ((size + align - 1) / align) * align;
+
+      if (chunks.empty() || offset + size > chunks[chunk].size) {
+        // move on to the next chunk that is large enough, adding one if needed
+        size_t next = chunks.empty() ? 0 : chunk + 1;
+        while (next < chunks.size() && chunks[next].size < size) next++;
+        if (next == chunks.size()) {
+          MemAlloc a("HostArena", file_name(__FILE__), __LINE__);
+          a.size = a.base_size = std::max(size, chunk_size);
+          void *base = nullptr;
+          if (posix_memalign(&base, align, a.base_size) != 0 || !base) {
+            printfQuda("ERROR: Failed to allocate host arena chunk of size %zu (%s:%d in %s())\n", a.base_size, file, line, func);
+            errorQuda("Aborting");
+          }
+          track_malloc(HOST, a, base);
+          chunks.push_back(Chunk{static_cast<char *>(base), a.base_size});
+        }
+        chunk = next;
+        offset = 0;
+      }
+
+      void *ptr = chunks[chunk].base + offset;
+      offset += size;
+      used += size;
+      if (used > max_used) {
+        max_used = used;
+        size_t peak = max_peak.load(std::memory_order_relaxed);
+        while (used > peak && !max_peak.compare_exchange_weak(peak, used, std::memory_order_relaxed)) { }
+      }
+      count++;
+      bytes += size;
+
+#ifdef HOST_DEBUG
+      MemAlloc a(func, file, line);
+      a.size = a.base_size = size;
+      live[ptr] = a;
+      memset(ptr, 0xff, size);
+#endif
+      return ptr;
+    }
+
+    /**
+       @return Whether ptr lies in the part of the arena at or after
+       the position (c, off)
+     */
+    bool contains(const void *ptr, size_t c = 0, size_t off = 0) const
+    {
+      for (size_t i = c; i < chunks.size(); i++) {
+        const char *lo = chunks[i].base + (i == c ? off : 0);
+        if (ptr >= lo && ptr < chunks[i].base + chunks[i].size) return true;
+      }
+      return false;
+    }
+
+    /**
+       Virtual free of an arena allocation: the memory is only
+       reclaimed when its scope closes.
+       @return Whether ptr was an arena allocation
+     */
+    bool free_(const char *func, const char *file, int line, void *ptr)
+    {
+      if (!contains(ptr)) return false;
+#ifdef HOST_DEBUG
+      if (!live.count(ptr)) {
+        printfQuda("ERROR: Attempt to free invalid host arena pointer (%s:%d in %s())\n", file, line, func);
+        errorQuda("Aborting");
+      }
+      live.erase(ptr);
+#endif
+      return true;
+    }
+
+    void flush()
+    {
+      if (depth) errorQuda("Cannot flush the host arena with %d scopes open", depth);
+      free_chunks();
+    }
+
+    /** high-water mark over the arenas of all threads */
+    static std::atomic<size_t> max_peak;
+    static size_t peak() { return max_peak.load(std::memory_order_relaxed); }
+  };
+
+  std::atomic<size_t> HostArena::max_peak(0);
+
+  static thread_local HostArena host_arena;
+
+  HostArenaScope::HostArenaScope(const char *name) : name(name)
+  {
+    HostArena::Mark m = host_arena.open();
+    chunk = m.chunk;
+    offset = m.offset;
+    used = m.used;
+    count = m.count;
+    bytes = m.bytes;
+  }
+
+  HostArenaScope::~HostArenaScope()
+  {
+    host_arena.close(HostArena::Mark{chunk, offset, used, count, bytes}, name);
+  }
+
+  void *arena_malloc_(const char *func, const char *file, int line, size_t size)
+  {
+    return host_arena.active() ? host_arena.malloc_(func, file, line, size) : safe_malloc_(func, file, line, size);
+  }
+
+  void flush_host_arena() { host_arena.flush(); }
+
   /**
    * Perform a standard malloc() with error-checking.  This function
    * should only be called via the safe_malloc() macro, defined in
@@ -315,7 +764,7 @@ namespace quda {
       printfQuda("ERROR: Attempt to free NULL device pointer (%s:%d in %s())\n", file, line, func);
       errorQuda("Aborting");
     }
-    if (!alloc[DEVICE].count(ptr)) {
+    if (!is_alloc(DEVICE, ptr)) {
       printfQuda("ERROR: Attempt to free invalid device pointer (%s:%d in %s())\n", file, line, func);
       errorQuda("Aborting");
     }
@@ -347,7 +796,7 @@ namespace quda {
       printfQuda("ERROR: Attempt to free NULL device pointer (%s:%d in %s())\n", file, line, func);
       errorQuda("Aborting");
     }
-    if (!alloc[DEVICE_PINNED].count(ptr)) {
+    if (!is_alloc(DEVICE_PINNED, ptr)) {
       printfQuda("ERROR: Attempt to free invalid device pointer (%s:%d in %s())\n", file, line, func);
       errorQuda("Aborting");
     }
@@ -371,10 +820,12 @@ namespace quda {
       printfQuda("ERROR: Attempt to free NULL host pointer (%s:%d in %s())\n", file, line, func);
       errorQuda("Aborting");
     }
-    if (alloc[HOST].count(ptr)) {
+    if (host_arena.free_(func, file, line, ptr)) {
+      return; // released when its scope closes
+    } else if (is_alloc(HOST, ptr)) {
       track_free(HOST, ptr);
       free(ptr);
-    } else if (alloc[PINNED].count(ptr)) {
+    } else if (is_alloc(PINNED, ptr)) {
       cudaError_t err = cudaHostUnregister(ptr);
       if (err != cudaSuccess) {
 	printfQuda("ERROR: Failed to unregister pinned memory (%s:%d in %s())\n", file, line, func);
@@ -382,7 +833,7 @@ namespace quda {
       }
       track_free(PINNED, ptr);
       free(ptr);
-    } else if (alloc[MAPPED].count(ptr)) {
+    } else if (is_alloc(MAPPED, ptr)) {
 #ifdef HOST_ALLOC
       cudaError_t err = cudaFreeHost(ptr);
       if (err != cudaSuccess) {
@@ -406,18 +857,52 @@ namespace quda {
   }
 
 
+  /**
+     Print the call sites with the largest high-water marks, and with
+     QUDA_DEBUG_VERBOSE the size histogram of each
+   */
+  static void print_call_sites(int n)
+  {
+    std::vector<int> sites;
+    for (int i = 0; i < max_call_site; i++)
+      if (call_site[i].state.load(std::memory_order_acquire) == 2) sites.push_back(i);
+    std::sort(sites.begin(), sites.end(),
+              [](int a, int b) { return call_site[a].max_bytes > call_site[b].max_bytes; });
+    if (sites.size() > (size_t)n) sites.resize(n);
+
+    printfQuda("Type           Peak MB    Allocations  Location\n");
+    for (int i : sites) {
+      const CallSite &c = call_site[i];
+      long total = 0;
+      for (int b = 0; b < n_size_bucket; b++) total += c.hist_count[b];
+      printfQuda("%-13s %8.1f %14ld  %s(), %s:%d\n", type_str[c.type], c.max_bytes / (double)(1<<20), total,
+                 c.func, c.file, c.line);
+      if (getVerbosity() >= QUDA_DEBUG_VERBOSE) {
+        for (int b = 0; b < n_size_bucket; b++) {
+          if (c.hist_count[b])
+            printfQuda("    [2^%d, 2^%d) bytes: %ld allocations, %.1f MB\n", b, b + 1, c.hist_count[b].load(),
+                       c.hist_bytes[b] / (double)(1<<20));
+        }
+      }
+    }
+  }
+
+
   void printPeakMemUsage()
   {
     printfQuda("Device memory used = %.1f MB\n", max_total_bytes[DEVICE] / (double)(1<<20));
     printfQuda("Pinned device memory used = %.1f MB\n", max_total_bytes[DEVICE_PINNED] / (double)(1<<20));
     printfQuda("Page-locked host memory used = %.1f MB\n", max_total_pinned_bytes / (double)(1<<20));
     printfQuda("Total host memory used >= %.1f MB\n", max_total_host_bytes / (double)(1<<20));
+    if (HostArena::peak()) printfQuda("Host arena memory used = %.1f MB\n", HostArena::peak() / (double)(1<<20));
+    pool::print_stats();
+    if (getVerbosity() >= QUDA_VERBOSE) print_call_sites(16);
   }
 
 
   void assertAllMemFree()
   {
-    if (!alloc[DEVICE].empty() || !alloc[DEVICE_PINNED].empty() || !alloc[HOST].empty() || !alloc[PINNED].empty() || !alloc[MAPPED].empty()) {
+    if (n_live[DEVICE] || n_live[DEVICE_PINNED] || n_live[HOST] || n_live[PINNED] || n_live[MAPPED]) {
       warningQuda("The following internal memory allocations were not freed.");
       printfQuda("\n");
       print_alloc_header();
@@ -430,6 +915,44 @@ namespace quda {
     }
   }
 
+  // launch parameters of the last host reorder kernel, with no threads until one has run
+  static std::atomic<int> touch_threads(0);
+  static std::atomic<int> touch_chunk(0);
+  static std::atomic<int> touch_tile(1);
+
+  void host_touch_param(const TuneParam &param)
+  {
+    touch_threads.store(param.block.x, std::memory_order_relaxed);
+    touch_chunk.store(param.block.y, std::memory_order_relaxed);
+    touch_tile.store(param.block.z, std::memory_order_relaxed);
+  }
+
+  void host_zero(void *const *row, int n_row, size_t row_bytes, size_t row_items)
+  {
+    if (row_items == 0) return;
+
+    TuneParam param;
+    const int threads = touch_threads.load(std::memory_order_relaxed);
+    param.block = dim3(threads ? threads : hostThreads(), touch_chunk.load(std::memory_order_relaxed),
+                       touch_tile.load(std::memory_order_relaxed));
+
+    // the same row and tile iteration space as the reorder kernels
+    const long n_tile = (row_items + param.block.z - 1) / param.block.z;
+    const long tile = param.block.z;
+    const long items = row_items;
+
+    HostLaunch launch(param);
+#pragma omp parallel for collapse(2) schedule(runtime)
+    for (long r = 0; r < n_row; r++) {
+      for (long t = 0; t < n_tile; t++) {
+        const long end = (t + 1) * tile < items ? (t + 1) * tile : items;
+        const size_t begin_byte = row_bytes * (t * tile) / row_items;
+        const size_t end_byte = row_bytes * end / row_items;
+        memset(static_cast<char*>(row[r]) + begin_byte, 0, end_byte - begin_byte);
+      }
+    }
+  }
+
   QudaFieldLocation get_pointer_location(const void *ptr) {
 
     CUpointer_attribute attribute[] = { CU_POINTER_ATTRIBUTE_MEMORY_TYPE };
@@ -460,25 +983,225 @@ namespace quda {
 
   namespace pool {
 
-    /** Cache of inactive pinned-memory allocations.  We cache pinned
-	memory allocations so that fields can reuse these with minimal
-	overhead.*/
-    static std::multimap<size_t, void *> pinnedCache;
+    /**
+       A pool of large allocations ("slabs") obtained from the
+       underlying allocator and carved into blocks.  Requests are
+       rounded up to the granularity, and served from the smallest free
+       block of at least their size class (eight classes per power of
+       two), or else the smallest free block that fits.  New slabs are
+       sized from the rounded request, not the class.  If the block
+       exceeds the request by more than the maximum slack ratio it is
+       split, and the remainder returned to the pool.  Freed blocks are
+       coalesced with free neighbours in the same slab, so a slab whose
+       blocks have all been freed is again a single block.
+     */
+    class MemoryPool {
+
+      struct Block {
+        char *ptr;
+        size_t size;
+        size_t requested; // size requested by the caller while active
+        bool free;
+        Block *prev;      // neighbours in the same slab (address order)
+        Block *next;
+        std::multimap<size_t, Block *>::iterator it; // position in free_blocks while free
+      };
+
+      typedef void *(*malloc_t)(const char *, const char *, int, size_t);
+      typedef void (*free_t)(const char *, const char *, int, void *);
+
+      const char *name;
+      malloc_t slab_malloc;
+      free_t slab_free;
+
+      /** blocks are aligned to, and sized in multiples of, this many bytes */
+      static constexpr size_t granularity = 512;
+
+      /** smallest slab requested from the underlying allocator */
+      size_t min_slab;
+
+      /** blocks exceeding the request by more than this fraction are split */
+      double max_slack;
+
+      std::multimap<size_t, Block *> free_blocks; // free blocks by size
+      std::map<void *, Block *> active;           // active blocks by pointer
+      std::map<void *, Block *> slabs;            // first block of each slab by base pointer
+
+      size_t slab_bytes = 0;     // total held from the underlying allocator
+      size_t requested_bytes = 0; // total requested by active allocations
+      size_t reserved_bytes = 0;  // total size of active blocks
+
+      size_t max_slab_bytes = 0;
+      size_t max_requested_bytes = 0;
+      size_t max_slack_bytes = 0;
+      size_t max_fragmented_bytes = 0;
+      long n_slab_malloc = 0;
+      long n_slab_free = 0;
+
+      static size_t round_up(size_t nbytes)
+      {
+        return ((std::max(nbytes, (size_t)1) + granularity - 1) / granularity) * granularity;
+      }
+
+      static size_t size_class(size_t nbytes)
+      {
+        size_t size = round_up(nbytes);
+        size_t octave = granularity;
+        while (octave * 2 <= size) octave *= 2;
+        size_t step = octave / 8 > granularity ? octave / 8 : granularity;
+        return ((size + step - 1) / step) * step;
+      }
+
+      void insert_free(Block *b)
+      {
+        b->free = true;
+        b->it = free_blocks.insert(std::make_pair(b->size, b));
+      }
+
+      void remove_free(Block *b)
+      {
+        free_blocks.erase(b->it);
+        b->free = false;
+      }
+
+      /** free bytes in slabs that are partially in use */
+      size_t fragmented_bytes() const
+      {
+        size_t bytes = 0;
+        for (auto &f : free_blocks)
+          if (f.second->prev || f.second->next) bytes += f.first;
+        return bytes;
+      }
+
+      /** return every slab that is entirely free to the underlying allocator */
+      void release_idle(const char *func, const char *file, int line)
+      {
+        for (auto it = slabs.begin(); it != slabs.end();) {
+          Block *b = it->second;
+          if (b->free && !b->next) {
+            remove_free(b);
+            slab_bytes -= b->size;
+            n_slab_free++;
+            slab_free(func, file, line, b->ptr);
+            delete b;
+            it = slabs.erase(it);
+          } else {
+            it++;
+          }
+        }
+      }
+
+    public:
+      MemoryPool(const char *name, malloc_t slab_malloc, free_t slab_free) :
+        name(name), slab_malloc(slab_malloc), slab_free(slab_free), min_slab(2 << 20), max_slack(0.25) { }
+
+      void init(const char *slack_env)
+      {
+        char *slack = getenv(slack_env);
+        if (slack) {
+          max_slack = atof(slack);
+          if (max_slack < 0.0) errorQuda("Invalid %s=%s", slack_env, slack);
+        }
+      }
+
+      void *malloc_(const char *func, const char *file, int line, size_t nbytes)
+      {
+        const size_t size = round_up(nbytes);
+
+        auto it = free_blocks.lower_bound(size_class(nbytes));
+        if (it == free_blocks.end()) it = free_blocks.lower_bound(size);
+        if (it == free_blocks.end()) {
+          max_fragmented_bytes = std::max(max_fragmented_bytes, fragmented_bytes());
+
+          // nothing fits: idle slabs are all too small, so give them back before growing
+          release_idle(func, file, line);
+          const size_t slab_size = std::max(size, min_slab);
+          Block *b = new Block;
+          b->ptr = static_cast<char *>(slab_malloc(func, file, line, slab_size));
+          b->size = slab_size;
+          b->prev = b->next = nullptr;
+          slabs[b->ptr] = b;
+          slab_bytes += slab_size;
+          n_slab_malloc++;
+          max_slab_bytes = std::max(max_slab_bytes, slab_bytes);
+          insert_free(b);
+          it = b->it;
+        }
+
+        Block *b = it->second;
+        remove_free(b);
+
+        if (b->size - size >= granularity && b->size > nbytes * (1.0 + max_slack)) {
+          Block *rest = new Block;
+          rest->ptr = b->ptr + size;
+          rest->size = b->size - size;
+          rest->prev = b;
+          rest->next = b->next;
+          if (b->next) b->next->prev = rest;
+          b->next = rest;
+          b->size = size;
+          insert_free(rest);
+        }
+
+        b->requested = nbytes;
+        active[b->ptr] = b;
+        requested_bytes += nbytes;
+        reserved_bytes += b->size;
+        max_requested_bytes = std::max(max_requested_bytes, requested_bytes);
+        max_slack_bytes = std::max(max_slack_bytes, reserved_bytes - requested_bytes);
+
+        return b->ptr;
+      }
+
+      void free_(const char *func, const char *file, int line, void *ptr)
+      {
+        auto it = active.find(ptr);
+        if (it == active.end()) {
+          printfQuda("ERROR: Attempt to free invalid %s pool pointer (%s:%d in %s())\n", name, file, line, func);
+          errorQuda("Aborting");
+        }
+        Block *b = it->second;
+        active.erase(it);
+        requested_bytes -= b->requested;
+        reserved_bytes -= b->size;
+
+        // coalesce with the free neighbours
+        if (b->next && b->next->free) {
+          Block *n = b->next;
+          remove_free(n);
+          b->size += n->size;
+          b->next = n->next;
+          if (n->next) n->next->prev = b;
+          delete n;
+        }
+        if (b->prev && b->prev->free) {
+          Block *p = b->prev;
+          remove_free(p);
+          p->size += b->size;
+          p->next = b->next;
+          if (b->next) b->next->prev = p;
+          delete b;
+          b = p;
+        }
+        insert_free(b);
+      }
+
+      void flush() { release_idle(__func__, __FILE__, __LINE__); }
 
-    /** Sizes of active pinned-memory allocations.  For convenience,
-	we keep track of the sizes of active allocations (i.e., those not
-	in the cache). */
-    static std::map<void *, size_t> pinnedSize;
+      void print_stats() const
+      {
+        if (!n_slab_malloc) return;
+        printfQuda("%s memory pool: peak held = %.1f MB, peak requested = %.1f MB, peak slack = %.1f MB, "
+                   "peak fragmentation = %.1f MB, %ld allocations / %ld frees of slabs\n", name,
+                   max_slab_bytes / (double)(1 << 20), max_requested_bytes / (double)(1 << 20),
+                   max_slack_bytes / (double)(1 << 20), max_fragmented_bytes / (double)(1 << 20), n_slab_malloc,
+                   n_slab_free);
+      }
+    };
 
-    /** Cache of inactive device-memory allocations.  We cache pinned
-	memory allocations so that fields can reuse these with minimal
-	overhead.*/
-    static std::multimap<size_t, void *> deviceCache;
+    static MemoryPool pinnedPool("Pinned", quda::pinned_malloc_, quda::host_free_);
 
-    /** Sizes of active device-memory allocations.  For convenience,
-	we keep track of the sizes of active allocations (i.e., those not
-	in the cache). */
-    static std::map<void *, size_t> deviceSize;
+    static MemoryPool devicePool("Device", quda::device_malloc_, quda::device_free_);
 
     static bool pool_init = false;
 
@@ -509,116 +1232,50 @@ namespace quda {
 	  warningQuda("Not using pinned memory pool allocator");
 	  pinned_memory_pool = false;
 	}
+
+	// maximum fraction by which a pool block may exceed the request
+	devicePool.init("QUDA_DEVICE_MEMORY_POOL_MAX_SLACK");
+	pinnedPool.init("QUDA_PINNED_MEMORY_POOL_MAX_SLACK");
 	pool_init = true;
       }
     }
 
     void* pinned_malloc_(const char *func, const char *file, int line, size_t nbytes)
     {
-      void *ptr = nullptr;
-      if (pinned_memory_pool) {
-	std::multimap<size_t, void *>::iterator it;
-
-	if (pinnedCache.empty()) {
-	  ptr = quda::pinned_malloc_(func, file, line, nbytes);
-	} else {
-	  it = pinnedCache.lower_bound(nbytes);
-	  if (it != pinnedCache.end()) { // sufficiently large allocation found
-	    nbytes = it->first;
-	    ptr = it->second;
-	    pinnedCache.erase(it);
-	  } else { // sacrifice the smallest cached allocation
-	    it = pinnedCache.begin();
-	    ptr = it->second;
-	    pinnedCache.erase(it);
-	    host_free(ptr);
-	    ptr = quda::pinned_malloc_(func, file, line, nbytes);
-	  }
-	}
-	pinnedSize[ptr] = nbytes;
-      } else {
-	ptr = quda::pinned_malloc_(func, file, line, nbytes);
-      }
-      return ptr;
+      return pinned_memory_pool ? pinnedPool.malloc_(func, file, line, nbytes) : quda::pinned_malloc_(func, file, line, nbytes);
     }
 
     void pinned_free_(const char *func, const char *file, int line, void *ptr)
     {
-      if (pinned_memory_pool) {
-	if (!pinnedSize.count(ptr)) {
-	  errorQuda("Attempt to free invalid pointer");
-	}
-	pinnedCache.insert(std::make_pair(pinnedSize[ptr], ptr));
-	pinnedSize.erase(ptr);
-      } else {
-	quda::host_free_(func, file, line, ptr);
-      }
+      if (pinned_memory_pool) pinnedPool.free_(func, file, line, ptr);
+      else quda::host_free_(func, file, line, ptr);
     }
 
     void* device_malloc_(const char *func, const char *file, int line, size_t nbytes)
     {
-      void *ptr = nullptr;
-      if (device_memory_pool) {
-	std::multimap<size_t, void *>::iterator it;
-
-	if (deviceCache.empty()) {
-	  ptr = quda::device_malloc_(func, file, line, nbytes);
-	} else {
-	  it = deviceCache.lower_bound(nbytes);
-	  if (it != deviceCache.end()) { // sufficiently large allocation found
-	    nbytes = it->first;
-	    ptr = it->second;
-	    deviceCache.erase(it);
-	  } else { // sacrifice the smallest cached allocation
-	    it = deviceCache.begin();
-	    ptr = it->second;
-	    deviceCache.erase(it);
-	    quda::device_free_(func, file, line, ptr);
-	    ptr = quda::device_malloc_(func, file, line, nbytes);
-	  }
-	}
-	deviceSize[ptr] = nbytes;
-      } else {
-	ptr = quda::device_malloc_(func, file, line, nbytes);
-      }
-      return ptr;
+      return device_memory_pool ? devicePool.malloc_(func, file, line, nbytes) : quda::device_malloc_(func, file, line, nbytes);
     }
 
     void device_free_(const char *func, const char *file, int line, void *ptr)
     {
-      if (device_memory_pool) {
-	if (!deviceSize.count(ptr)) {
-	  errorQuda("Attempt to free invalid pointer");
-	}
-	deviceCache.insert(std::make_pair(deviceSize[ptr], ptr));
-	deviceSize.erase(ptr);
-      } else {
-	quda::device_free_(func, file, line, ptr);
-      }
+      if (device_memory_pool) devicePool.free_(func, file, line, ptr);
+      else quda::device_free_(func, file, line, ptr);
     }
 
     void flush_pinned()
     {
-      if (pinned_memory_pool) {
-	std::multimap<size_t, void *>::iterator it;
-	for (it = pinnedCache.begin(); it != pinnedCache.end(); it++) {
-	  void *ptr = it->second;
-	  host_free(ptr);
-	}
-	pinnedCache.clear();
-      }
+      if (pinned_memory_pool) pinnedPool.flush();
     }
 
     void flush_device()
     {
-      if (device_memory_pool) {
-	std::multimap<size_t, void *>::iterator it;
-	for (it = deviceCache.begin(); it != deviceCache.end(); it++) {
-	  void *ptr = it->second;
-	  device_free(ptr);
-	}
-	deviceCache.clear();
-      }
+      if (device_memory_pool) devicePool.flush();
+    }
+
+    void print_stats()
+    {
+      if (device_memory_pool) devicePool.print_stats();
+      if (pinned_memory_pool) pinnedPool.print_stats();
     }
 
   } // namespace pool
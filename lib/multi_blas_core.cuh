@@ -44,6 +44,11 @@ static signed char *Amatrix_h;
 static signed char *Bmatrix_h;
 static signed char *Cmatrix_h;
 
+// host copies of the coefficient matrices in the compute precision, used for CPU fields
+static signed char Amatrix_host[MAX_MATRIX_SIZE];
+static signed char Bmatrix_host[MAX_MATRIX_SIZE];
+static signed char Cmatrix_host[MAX_MATRIX_SIZE];
+
 template<int k, int NXZ, typename FloatN, int M, typename Arg>
 __device__ inline void compute(Arg &arg, int idx, int parity) {
 
@@ -340,93 +345,150 @@ void multiblasCuda(const coeff_array<T> &a, const coeff_array<T> &b, const coeff
 
 
 /**
-   Generic blas kernel with four loads and up to four stores.
-   FIXME - this is hacky due to the lack of std::complex support in
-   CUDA.  The functors are defined in terms of FloatN vectors, whereas
-   the operator() accessor returns std::complex<Float>
+   Generic host multi-blas kernel with four loads and up to four
+   stores.  The X and Z sites are loaded once and reused across all
+   NYW outputs; as on the device each functor call gets its own copy
+   of the x and z elements.
   */
-template <typename Float2, typename write,
+template <int NXZ, typename Float2, typename write,
   typename SpinorX, typename SpinorY, typename SpinorZ, typename SpinorW,
   typename Functor>
-void genericMultiBlas(SpinorX &X, SpinorY &Y, SpinorZ &Z, SpinorW &W, Functor f) {
-
-  for (int parity=0; parity<X.Nparity(); parity++) {
-    for (int x=0; x<X.VolumeCB(); x++) {
-      for (int s=0; s<X.Nspin(); s++) {
-	for (int c=0; c<X.Ncolor(); c++) {
-	  Float2 X2 = make_Float2<Float2>( X(parity, x, s, c) );
-	  Float2 Y2 = make_Float2<Float2>( Y(parity, x, s, c) );
-	  Float2 Z2 = make_Float2<Float2>( Z(parity, x, s, c) );
-	  Float2 W2 = make_Float2<Float2>( W(parity, x, s, c) );
-    f(X2, Y2, Z2, W2, 1 , 1);
-    // if (writeX) X(parity, x, s, c) = make_Complex(X2);
-    if (write::X) errorQuda("writeX not supported in multiblas.");
-    if (write::Y) Y(parity, x, s, c) = make_Complex(Y2);
-    if (write::Z) errorQuda("writeZ not supported in multiblas.");
-	  if (write::W) W(parity, x, s, c) = make_Complex(W2);
-	}
+void genericMultiBlas(std::vector<SpinorX> &X, std::vector<SpinorY> &Y, std::vector<SpinorZ> &Z,
+                      std::vector<SpinorW> &W, Functor f, int volumeCB, int nParity) {
+
+  constexpr int length = SpinorX::length;
+  const int NYW = Y.size();
+  f.init();
+
+#pragma omp parallel for collapse(2) firstprivate(f)
+  for (int parity=0; parity<nParity; parity++) {
+    for (int x=0; x<volumeCB; x++) {
+      Float2 X_[NXZ][length], Z_[NXZ][length];
+      for (int l=0; l<NXZ; l++) {
+        X[l].load(X_[l], x, parity);
+        Z[l].load(Z_[l], x, parity);
+      }
+
+      for (int k=0; k<NYW; k++) {
+        Float2 Y_[length], W_[length];
+        Y[k].load(Y_, x, parity);
+        W[k].load(W_, x, parity);
+        for (int l=0; l<NXZ; l++) {
+          for (int i=0; i<length; i++) {
+            Float2 x_ = X_[l][i], z_ = Z_[l][i];
+            f(x_, Y_[i], z_, W_[i], k, l);
+          }
+        }
+        if (write::Y) Y[k].save(Y_, x, parity);
+        if (write::W) W[k].save(W_, x, parity);
       }
     }
   }
 }
 
-template <typename Float, typename yFloat, int nSpin, int nColor, QudaFieldOrder order,
+template <int NXZ, typename Float, typename yFloat, int nSpin, int nColor, QudaFieldOrder order,
   typename write, typename Functor>
-  void genericMultiBlas(ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField &z,
-		   ColorSpinorField &w, Functor f) {
-  colorspinor::FieldOrderCB<Float,nSpin,nColor,1,order> X(x), Z(z), W(w);
-  colorspinor::FieldOrderCB<yFloat,nSpin,nColor,1,order> Y(y);
+  void genericMultiBlas(std::vector<ColorSpinorField*> &x, std::vector<ColorSpinorField*> &y,
+                        std::vector<ColorSpinorField*> &z, std::vector<ColorSpinorField*> &w, Functor f) {
   typedef typename vector<yFloat,2>::type Float2;
-  genericMultiBlas<Float2,write>(X, Y, Z, W, f);
+  std::vector<HostSpinor<Float2,Float,nSpin,nColor,order> > X, Z, W;
+  std::vector<HostSpinor<Float2,yFloat,nSpin,nColor,order> > Y;
+  for (int i=0; i<NXZ; i++) { X.emplace_back(*x[i]); Z.emplace_back(*z[i]); }
+  for (unsigned int i=0; i<y.size(); i++) { Y.emplace_back(*y[i]); W.emplace_back(*w[i]); }
+  genericMultiBlas<NXZ,Float2,write>(X, Y, Z, W, f, x[0]->VolumeCB(), x[0]->SiteSubset());
 }
 
-template <typename Float, typename yFloat, int nSpin, QudaFieldOrder order,
+template <int NXZ, typename Float, typename yFloat, int nSpin, QudaFieldOrder order,
 	  typename write, typename Functor>
-  void genericMultiBlas(ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField &z, ColorSpinorField &w, Functor f) {
-if (x.Ncolor() == 3) {
-    genericMultiBlas<Float,yFloat,nSpin,3,order,write,Functor>(x, y, z, w, f);
-  } else if (x.Ncolor() == 4) {
-    genericMultiBlas<Float,yFloat,nSpin,4,order,write,Functor>(x, y, z, w, f);
-  } else if (x.Ncolor() == 6) { // free field Wilson
-    genericMultiBlas<Float,yFloat,nSpin,6,order,write,Functor>(x, y, z, w, f);
-  } else if (x.Ncolor() == 8) {
-    genericMultiBlas<Float,yFloat,nSpin,8,order,write,Functor>(x, y, z, w, f);
-  } else if (x.Ncolor() == 12) {
-    genericMultiBlas<Float,yFloat,nSpin,12,order,write,Functor>(x, y, z, w, f);
-  } else if (x.Ncolor() == 16) {
-    genericMultiBlas<Float,yFloat,nSpin,16,order,write,Functor>(x, y, z, w, f);
-  } else if (x.Ncolor() == 20) {
-    genericMultiBlas<Float,yFloat,nSpin,20,order,write,Functor>(x, y, z, w, f);
-  } else if (x.Ncolor() == 24) {
-    genericMultiBlas<Float,yFloat,nSpin,24,order,write,Functor>(x, y, z, w, f);
-  } else if (x.Ncolor() == 32) {
-    genericMultiBlas<Float,yFloat,nSpin,32,order,write,Functor>(x, y, z, w, f);
+  void genericMultiBlas(std::vector<ColorSpinorField*> &x, std::vector<ColorSpinorField*> &y,
+                        std::vector<ColorSpinorField*> &z, std::vector<ColorSpinorField*> &w, Functor f) {
+  if (x[0]->Ncolor() == 3) {
+    genericMultiBlas<NXZ,Float,yFloat,nSpin,3,order,write,Functor>(x, y, z, w, f);
+  } else if (x[0]->Ncolor() == 4) {
+    genericMultiBlas<NXZ,Float,yFloat,nSpin,4,order,write,Functor>(x, y, z, w, f);
+  } else if (x[0]->Ncolor() == 6) { // free field Wilson
+    genericMultiBlas<NXZ,Float,yFloat,nSpin,6,order,write,Functor>(x, y, z, w, f);
+  } else if (x[0]->Ncolor() == 8) {
+    genericMultiBlas<NXZ,Float,yFloat,nSpin,8,order,write,Functor>(x, y, z, w, f);
+  } else if (x[0]->Ncolor() == 12) {
+    genericMultiBlas<NXZ,Float,yFloat,nSpin,12,order,write,Functor>(x, y, z, w, f);
+  } else if (x[0]->Ncolor() == 16) {
+    genericMultiBlas<NXZ,Float,yFloat,nSpin,16,order,write,Functor>(x, y, z, w, f);
+  } else if (x[0]->Ncolor() == 20) {
+    genericMultiBlas<NXZ,Float,yFloat,nSpin,20,order,write,Functor>(x, y, z, w, f);
+  } else if (x[0]->Ncolor() == 24) {
+    genericMultiBlas<NXZ,Float,yFloat,nSpin,24,order,write,Functor>(x, y, z, w, f);
+  } else if (x[0]->Ncolor() == 32) {
+    genericMultiBlas<NXZ,Float,yFloat,nSpin,32,order,write,Functor>(x, y, z, w, f);
   } else {
-    errorQuda("nColor = %d not implemeneted",x.Ncolor());
+    errorQuda("nColor = %d not implemented", x[0]->Ncolor());
   }
 }
 
-template <typename Float, typename yFloat, QudaFieldOrder order, typename write, typename Functor>
-  void genericMultiBlas(ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField &z, ColorSpinorField &w, Functor f) {
-  if (x.Nspin() == 4) {
-    genericMultiBlas<Float,yFloat,4,order,write,Functor>(x, y, z, w, f);
-  } else if (x.Nspin() == 2) {
-    genericMultiBlas<Float,yFloat,2,order,write,Functor>(x, y, z, w, f);
+template <int NXZ, typename Float, typename yFloat, QudaFieldOrder order, typename write, typename Functor>
+  void genericMultiBlas(std::vector<ColorSpinorField*> &x, std::vector<ColorSpinorField*> &y,
+                        std::vector<ColorSpinorField*> &z, std::vector<ColorSpinorField*> &w, Functor f) {
+  if (x[0]->Nspin() == 4) {
+    genericMultiBlas<NXZ,Float,yFloat,4,order,write,Functor>(x, y, z, w, f);
+  } else if (x[0]->Nspin() == 2) {
+    genericMultiBlas<NXZ,Float,yFloat,2,order,write,Functor>(x, y, z, w, f);
 #ifdef GPU_STAGGERED_DIRAC
-  } else if (x.Nspin() == 1) {
-    genericMultiBlas<Float,yFloat,1,order,write,Functor>(x, y, z, w, f);
+  } else if (x[0]->Nspin() == 1) {
+    genericMultiBlas<NXZ,Float,yFloat,1,order,write,Functor>(x, y, z, w, f);
 #endif
   } else {
-    errorQuda("nSpin = %d not implemeneted",x.Nspin());
+    errorQuda("nSpin = %d not implemented", x[0]->Nspin());
   }
 }
 
-template <typename Float, typename yFloat, typename write, typename Functor>
-  void genericMultiBlas(ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField &z, ColorSpinorField &w, Functor f) {
-  if (x.FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER) {
-    genericMultiBlas<Float,yFloat,QUDA_SPACE_SPIN_COLOR_FIELD_ORDER,write,Functor>
-      (x, y, z, w, f);
+template <int NXZ, typename Float, typename yFloat, typename write, typename Functor>
+  void genericMultiBlas(std::vector<ColorSpinorField*> &x, std::vector<ColorSpinorField*> &y,
+                        std::vector<ColorSpinorField*> &z, std::vector<ColorSpinorField*> &w, Functor f) {
+  if (x[0]->FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER) {
+    genericMultiBlas<NXZ,Float,yFloat,QUDA_SPACE_SPIN_COLOR_FIELD_ORDER,write,Functor>(x, y, z, w, f);
+  } else if (x[0]->FieldOrder() == QUDA_SPACE_COLOR_SPIN_FIELD_ORDER) {
+    genericMultiBlas<NXZ,Float,yFloat,QUDA_SPACE_COLOR_SPIN_FIELD_ORDER,write,Functor>(x, y, z, w, f);
+  } else if (x[0]->FieldOrder() == QUDA_PADDED_SPACE_SPIN_COLOR_FIELD_ORDER) {
+#ifdef BUILD_TIFR_INTERFACE
+    genericMultiBlas<NXZ,Float,yFloat,QUDA_PADDED_SPACE_SPIN_COLOR_FIELD_ORDER,write,Functor>(x, y, z, w, f);
+#else
+    errorQuda("TIFR interface has not been built\n");
+#endif
+  } else if (x[0]->FieldOrder() == QUDA_QDPJIT_FIELD_ORDER) {
+#ifdef BUILD_QDPJIT_INTERFACE
+    genericMultiBlas<NXZ,Float,yFloat,QUDA_QDPJIT_FIELD_ORDER,write,Functor>(x, y, z, w, f);
+#else
+    errorQuda("QDPJIT interface has not been built\n");
+#endif
   } else {
-    errorQuda("Not implemeneted");
+    errorQuda("Field order %d not implemented", x[0]->FieldOrder());
   }
 }
+
+/**
+   Driver for the generic host multi-blas kernel
+*/
+template <int NXZ, typename Float, typename yFloat, template <int,typename,typename> class Functor,
+	  typename write, typename T>
+void genericMultiBlas(const coeff_array<T> &a, const coeff_array<T> &b, const coeff_array<T> &c,
+		      std::vector<ColorSpinorField*> &x, std::vector<ColorSpinorField*> &y,
+		      std::vector<ColorSpinorField*> &z, std::vector<ColorSpinorField*> &w) {
+
+  const int NYW = y.size();
+
+  const int N = NXZ > NYW ? NXZ : NYW;
+  if (N > MAX_MULTI_BLAS_N) errorQuda("Spinor vector length exceeds max size (%d > %d)", N, MAX_MULTI_BLAS_N);
+
+  if (NXZ*NYW*sizeof(Complex) > MAX_MATRIX_SIZE)
+    errorQuda("A matrix exceeds max size (%lu > %d)", NXZ*NYW*sizeof(Complex), MAX_MATRIX_SIZE);
+
+  typedef typename vector<yFloat,2>::type Float2;
+
+  // the host functors read the coefficients in the compute precision with stride NYW
+  if (a.data && a.use_const) Amatrix_h = hostCoeff<Float2>(Amatrix_host, a.data, NXZ, NYW);
+  if (b.data && b.use_const) Bmatrix_h = hostCoeff<Float2>(Bmatrix_host, b.data, NXZ, NYW);
+  if (c.data && c.use_const) Cmatrix_h = hostCoeff<Float2>(Cmatrix_host, c.data, NXZ, NYW);
+
+  Functor<NXZ,Float2,Float2> f(a, b, c, NYW);
+  genericMultiBlas<NXZ,Float,yFloat,write>(x, y, z, w, f);
+}
@@ -9,6 +9,7 @@
 #include <blas_quda.h>
 #include <color_spinor_field.h>
 #include <color_spinor_field_order.h>
+#include <blas_helper.cuh>
 
 #define checkSpinor(a, b)						\
   {									\
@@ -71,6 +71,11 @@ static signed char *Amatrix_h;
 static signed char *Bmatrix_h;
 static signed char *Cmatrix_h;
 
+// host copies of the coefficient matrices in the compute precision, used for CPU fields
+static signed char Amatrix_host[MAX_MATRIX_SIZE];
+static signed char Bmatrix_host[MAX_MATRIX_SIZE];
+static signed char Cmatrix_host[MAX_MATRIX_SIZE];
+
 // 'sum' should be an array of length NXZ...?
 template<int k, int NXZ, typename FloatN, int M, typename ReduceType, typename Arg>
 __device__ inline void compute(vector_type<ReduceType,NXZ> &sum, Arg &arg, int idx, int parity) {
@@ -511,3 +516,171 @@ template <typename doubleN, typename ReduceType, typename RegType, typename Stor
 
   return;
 }
+
+
+/**
+   Generic host multi-reduce kernel.  As for the single reductions,
+   the sites are split into fixed-size blocks, each block accumulates
+   its own NXZ*NYW partial sums with a private copy of the reducer,
+   and the blocks are then combined pairwise so that the result is
+   independent of the number of threads.  The result is returned in
+   result[l*NYW + k] for X index l and Y index k.
+*/
+template <int NXZ, typename doubleN, typename Float2, typename write,
+  typename SpinorX, typename SpinorY, typename SpinorZ, typename SpinorW, typename Reducer>
+void genericMultiReduce(doubleN result[], std::vector<SpinorX> &X, std::vector<SpinorY> &Y,
+                        std::vector<SpinorZ> &Z, std::vector<SpinorW> &W, Reducer r, int volumeCB, int nParity) {
+
+  constexpr int length = SpinorX::length;
+  const int NYW = Y.size();
+  const int n_block = blas::hostReduceBlocks(volumeCB, nParity) / nParity;
+  std::vector<doubleN> partial(nParity * n_block * NXZ * NYW);
+
+#pragma omp parallel for collapse(2)
+  for (int parity=0; parity<nParity; parity++) {
+    for (int b=0; b<n_block; b++) {
+      Reducer r_ = r;
+      doubleN *sum = &partial[(parity*n_block + b) * NXZ * NYW];
+      for (int i=0; i<NXZ*NYW; i++) ::quda::zero(sum[i]);
+
+      const int x_end = (b+1)*blas::host_reduce_block < volumeCB ? (b+1)*blas::host_reduce_block : volumeCB;
+      for (int x=b*blas::host_reduce_block; x<x_end; x++) {
+        Float2 X_[NXZ][length], Z_[NXZ][length];
+        for (int l=0; l<NXZ; l++) {
+          X[l].load(X_[l], x, parity);
+          Z[l].load(Z_[l], x, parity);
+        }
+
+        for (int k=0; k<NYW; k++) {
+          Float2 Y_[length], W_[length];
+          Y[k].load(Y_, x, parity);
+          W[k].load(W_, x, parity);
+          for (int l=0; l<NXZ; l++) {
+            r_.pre();
+            for (int i=0; i<length; i++) {
+              Float2 x_ = X_[l][i], z_ = Z_[l][i];
+              r_(sum[l*NYW+k], x_, Y_[i], z_, W_[i], k, l);
+            }
+            r_.post(sum[l*NYW+k]);
+          }
+          if (write::Y) Y[k].save(Y_, x, parity);
+          if (write::W) W[k].save(W_, x, parity);
+        }
+      }
+    }
+  }
+
+  blas::pairwiseSum(partial.data(), nParity * n_block, NXZ * NYW);
+  for (int i=0; i<NXZ*NYW; i++) result[i] = partial[i];
+}
+
+template <int NXZ, typename doubleN, typename Float, typename yFloat, int nSpin, int nColor,
+  QudaFieldOrder order, typename write, typename Reducer>
+  void genericMultiReduce(doubleN result[], std::vector<ColorSpinorField*> &x, std::vector<ColorSpinorField*> &y,
+                          std::vector<ColorSpinorField*> &z, std::vector<ColorSpinorField*> &w, Reducer r) {
+  typedef typename vector<yFloat,2>::type Float2;
+  std::vector<blas::HostSpinor<Float2,Float,nSpin,nColor,order> > X, Z, W;
+  std::vector<blas::HostSpinor<Float2,yFloat,nSpin,nColor,order> > Y;
+  for (int i=0; i<NXZ; i++) { X.emplace_back(*x[i]); Z.emplace_back(*z[i]); }
+  for (unsigned int i=0; i<y.size(); i++) { Y.emplace_back(*y[i]); W.emplace_back(*w[i]); }
+  genericMultiReduce<NXZ,doubleN,Float2,write>(result, X, Y, Z, W, r, x[0]->VolumeCB(), x[0]->SiteSubset());
+}
+
+template <int NXZ, typename doubleN, typename Float, typename yFloat, int nSpin,
+  QudaFieldOrder order, typename write, typename Reducer>
+  void genericMultiReduce(doubleN result[], std::vector<ColorSpinorField*> &x, std::vector<ColorSpinorField*> &y,
+                          std::vector<ColorSpinorField*> &z, std::vector<ColorSpinorField*> &w, Reducer r) {
+  if (x[0]->Ncolor() == 3) {
+    genericMultiReduce<NXZ,doubleN,Float,yFloat,nSpin,3,order,write>(result, x, y, z, w, r);
+  } else if (x[0]->Ncolor() == 4) {
+    genericMultiReduce<NXZ,doubleN,Float,yFloat,nSpin,4,order,write>(result, x, y, z, w, r);
+  } else if (x[0]->Ncolor() == 6) { // free field Wilson
+    genericMultiReduce<NXZ,doubleN,Float,yFloat,nSpin,6,order,write>(result, x, y, z, w, r);
+  } else if (x[0]->Ncolor() == 8) {
+    genericMultiReduce<NXZ,doubleN,Float,yFloat,nSpin,8,order,write>(result, x, y, z, w, r);
+  } else if (x[0]->Ncolor() == 12) {
+    genericMultiReduce<NXZ,doubleN,Float,yFloat,nSpin,12,order,write>(result, x, y, z, w, r);
+  } else if (x[0]->Ncolor() == 16) {
+    genericMultiReduce<NXZ,doubleN,Float,yFloat,nSpin,16,order,write>(result, x, y, z, w, r);
+  } else if (x[0]->Ncolor() == 20) {
+    genericMultiReduce<NXZ,doubleN,Float,yFloat,nSpin,20,order,write>(result, x, y, z, w, r);
+  } else if (x[0]->Ncolor() == 24) {
+    genericMultiReduce<NXZ,doubleN,Float,yFloat,nSpin,24,order,write>(result, x, y, z, w, r);
+  } else if (x[0]->Ncolor() == 32) {
+    genericMultiReduce<NXZ,doubleN,Float,yFloat,nSpin,32,order,write>(result, x, y, z, w, r);
+  } else {
+    errorQuda("nColor = %d not implemented", x[0]->Ncolor());
+  }
+}
+
+template <int NXZ, typename doubleN, typename Float, typename yFloat, QudaFieldOrder order,
+  typename write, typename Reducer>
+  void genericMultiReduce(doubleN result[], std::vector<ColorSpinorField*> &x, std::vector<ColorSpinorField*> &y,
+                          std::vector<ColorSpinorField*> &z, std::vector<ColorSpinorField*> &w, Reducer r) {
+  if (x[0]->Nspin() == 4) {
+    genericMultiReduce<NXZ,doubleN,Float,yFloat,4,order,write>(result, x, y, z, w, r);
+  } else if (x[0]->Nspin() == 2) {
+    genericMultiReduce<NXZ,doubleN,Float,yFloat,2,order,write>(result, x, y, z, w, r);
+#ifdef GPU_STAGGERED_DIRAC
+  } else if (x[0]->Nspin() == 1) {
+    genericMultiReduce<NXZ,doubleN,Float,yFloat,1,order,write>(result, x, y, z, w, r);
+#endif
+  } else {
+    errorQuda("nSpin = %d not implemented", x[0]->Nspin());
+  }
+}
+
+template <int NXZ, typename doubleN, typename Float, typename yFloat, typename write, typename Reducer>
+  void genericMultiReduce(doubleN result[], std::vector<ColorSpinorField*> &x, std::vector<ColorSpinorField*> &y,
+                          std::vector<ColorSpinorField*> &z, std::vector<ColorSpinorField*> &w, Reducer r) {
+  if (x[0]->FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER) {
+    genericMultiReduce<NXZ,doubleN,Float,yFloat,QUDA_SPACE_SPIN_COLOR_FIELD_ORDER,write>(result, x, y, z, w, r);
+  } else if (x[0]->FieldOrder() == QUDA_SPACE_COLOR_SPIN_FIELD_ORDER) {
+    genericMultiReduce<NXZ,doubleN,Float,yFloat,QUDA_SPACE_COLOR_SPIN_FIELD_ORDER,write>(result, x, y, z, w, r);
+  } else if (x[0]->FieldOrder() == QUDA_PADDED_SPACE_SPIN_COLOR_FIELD_ORDER) {
+#ifdef BUILD_TIFR_INTERFACE
+    genericMultiReduce<NXZ,doubleN,Float,yFloat,QUDA_PADDED_SPACE_SPIN_COLOR_FIELD_ORDER,write>(result, x, y, z, w, r);
+#else
+    errorQuda("TIFR interface has not been built\n");
+#endif
+  } else if (x[0]->FieldOrder() == QUDA_QDPJIT_FIELD_ORDER) {
+#ifdef BUILD_QDPJIT_INTERFACE
+    genericMultiReduce<NXZ,doubleN,Float,yFloat,QUDA_QDPJIT_FIELD_ORDER,write>(result, x, y, z, w, r);
+#else
+    errorQuda("QDPJIT interface has not been built\n");
+#endif
+  } else {
+    errorQuda("CPU reductions not implemented for %d field order", x[0]->FieldOrder());
+  }
+}
+
+/**
+   Driver for the generic host multi-reduce kernel.  We don't have quad
+   precision support on the host so doubleN is used as the reduction
+   type.
+*/
+template <int NXZ, typename doubleN, typename Float, typename yFloat,
+  template <int MXZ, typename ReducerType, typename Float_, typename FloatN> class Reducer, typename write, typename T>
+  void genericMultiReduce(doubleN result[], const reduce::coeff_array<T> &a, const reduce::coeff_array<T> &b,
+                          const reduce::coeff_array<T> &c, std::vector<ColorSpinorField*>& x, std::vector<ColorSpinorField*>& y,
+                          std::vector<ColorSpinorField*>& z, std::vector<ColorSpinorField*>& w) {
+
+  const int NYW = y.size();
+  memset(result, 0, NXZ*NYW*sizeof(doubleN));
+
+  const int N_MAX = NXZ > NYW ? NXZ : NYW;
+  if (N_MAX > MAX_MULTI_BLAS_N) errorQuda("Spinor vector length exceeds max size (%d > %d)", N_MAX, MAX_MULTI_BLAS_N);
+
+  if (NXZ*NYW*sizeof(Complex) > MAX_MATRIX_SIZE)
+    errorQuda("A matrix exceeds max size (%lu > %d)", NXZ*NYW*sizeof(Complex), MAX_MATRIX_SIZE);
+
+  typedef typename vector<yFloat,2>::type Float2;
+
+  // the host reducers read the coefficients in the compute precision with stride NYW
+  if (a.data && a.use_const) Amatrix_h = blas::hostCoeff<Float2>(Amatrix_host, a.data, NXZ, NYW);
+  if (b.data && b.use_const) Bmatrix_h = blas::hostCoeff<Float2>(Bmatrix_host, b.data, NXZ, NYW);
+  if (c.data && c.use_const) Cmatrix_h = blas::hostCoeff<Float2>(Cmatrix_host, c.data, NXZ, NYW);
+
+  Reducer<NXZ, doubleN, Float2, Float2> r(a, b, c, NYW);
+  genericMultiReduce<NXZ,doubleN,Float,yFloat,write>(result, x, y, z, w, r);
+}
@@ -12,6 +12,17 @@ template<int NXZ, typename doubleN, typename ReduceType,
 
   int reduce_length = siteUnroll ? x[0]->RealLength() : x[0]->Length();
 
+  if (x[0]->Location() == QUDA_CPU_FIELD_LOCATION) {
+    if (x[0]->Precision() == QUDA_DOUBLE_PRECISION) {
+      genericMultiReduce<NXZ,doubleN,double,double,Reducer,write>(result, a, b, c, x, y, z, w);
+    } else if (x[0]->Precision() == QUDA_SINGLE_PRECISION) {
+      genericMultiReduce<NXZ,doubleN,float,float,Reducer,write>(result, a, b, c, x, y, z, w);
+    } else {
+      errorQuda("Precision %d not implemented", x[0]->Precision());
+    }
+    return;
+  }
+
   if (x[0]->Precision() == QUDA_DOUBLE_PRECISION) {
     if (x[0]->Nspin() == 4 || x[0]->Nspin() == 2) { // wilson
 #if defined(GPU_WILSON_DIRAC) || defined(GPU_DOMAIN_WALL_DIRAC) || defined(GPU_MULTIGRID)
@@ -13,6 +13,15 @@ namespace mixed {
     assert(siteUnroll==true);
     int reduce_length = siteUnroll ? x[0]->RealLength() : x[0]->Length();
 
+    if (x[0]->Location() == QUDA_CPU_FIELD_LOCATION) {
+      if (y[0]->Precision() == QUDA_DOUBLE_PRECISION && x[0]->Precision() == QUDA_SINGLE_PRECISION) {
+	genericMultiReduce<NXZ,doubleN,float,double,Reducer,write>(result, a, b, c, x, y, z, w);
+      } else {
+	errorQuda("Precision combination x=%d y=%d not supported\n", x[0]->Precision(), y[0]->Precision());
+      }
+      return;
+    }
+
     if (y[0]->Precision() == QUDA_DOUBLE_PRECISION && x[0]->Precision() == QUDA_SINGLE_PRECISION) {
 
       if (x[0]->Nspin() == 4) { // wilson
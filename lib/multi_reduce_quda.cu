@@ -2,6 +2,7 @@
 #include <tune_quda.h>
 #include <float_vector.h>
 #include <color_spinor_field_order.h>
+#include <blas_helper.cuh>
 #include <uint_to_char.h>
 
 //#define QUAD_SUM
@@ -55,9 +56,6 @@ static struct {
 namespace quda {
 
   // hooks into tune.cpp variables for policy tuning
-  typedef std::map<TuneKey, TuneParam> map;
-  const map& getTuneCache();
-
   void disableProfileCount();
   void enableProfileCount();
 
@@ -597,8 +595,17 @@ namespace quda {
         return TuneKey(x[0]->VolString(), typeid(*this).name(), aux);
       }
 
-      long long flops() const { return 0; } // FIXME
-      long long bytes() const { return 0; } // FIXME
+      // summed over the tiles, as counted by the constituent kernels: every (x, y) pair is reduced over once
+      long long flops() const
+      {
+        return (long long)x.size() * y.size() * ReducerDiagonal<1, double2, double2, double2>::flops() * x[0]->RealLength();
+      }
+
+      long long bytes() const
+      {
+        return (long long)x.size() * y.size() * ReducerDiagonal<1, double2, double2, double2>::streams() *
+          x[0]->RealLength() * x[0]->Precision();
+      }
 
       void preTune() { } // FIXME - use write to determine what needs to be saved
       void postTune() { } // FIXME - use write to determine what needs to be saved
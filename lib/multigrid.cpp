@@ -65,8 +65,7 @@ namespace quda {
         if (param.mg_global.generate_all_levels == QUDA_BOOLEAN_YES || param.level == 0) {
 
           if (param.B[0]->Location() == QUDA_CUDA_FIELD_LOCATION) {
-            rng = new RNG(param.B[0]->Volume(), 1234, param.B[0]->X());
-            rng->Init();
+            rng = new RNG(1234, param.B[0]->X());
           }
 
           // Initializing to random vectors
@@ -442,7 +441,6 @@ namespace quda {
 
   MG::~MG() {
     if (param.level < param.Nlevel-1) {
-      if (rng) rng->Release();
       delete rng;
 
       if (param.level == param.Nlevel-1 || param.cycle_type == QUDA_MG_CYCLE_RECURSIVE) {
@@ -849,7 +847,6 @@ namespace quda {
     if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Start loading %d vectors from %s\n", Nvec, vec_infile.c_str());
 
     if (strcmp(vec_infile.c_str(),"")!=0) {
-#ifdef HAVE_QIO
       std::vector<ColorSpinorField*> B_;
       if (B[0]->Location() == QUDA_CUDA_FIELD_LOCATION) {
         ColorSpinorParam csParam(*B[0]);
@@ -866,7 +863,7 @@ namespace quda {
         }
       }
 
-      void **V = static_cast<void**>(safe_malloc(Nvec*sizeof(void*)));
+      void **V = static_cast<void**>(arena_malloc(Nvec*sizeof(void*)));
       for (int i=0; i<Nvec; i++) V[i] = B_[i]->V();
 
       read_spinor_field(vec_infile.c_str(), &V[0], B_[0]->Precision(), B_[0]->X(),
@@ -880,10 +877,6 @@ namespace quda {
           delete B_[i];
         }
       }
-
-#else
-      errorQuda("\nQIO library was not built.\n");      
-#endif
     } else {
       if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Using %d constant nullvectors\n", Nvec);
 
@@ -916,7 +909,7 @@ namespace quda {
   }
 
   void MG::saveVectors(std::vector<ColorSpinorField*> &B) const {
-#ifdef HAVE_QIO
+    if (strcmp(param.mg_global.vec_outfile,"")==0) return; // nothing to save, so skip the download
 
     profile_global.TPSTART(QUDA_PROFILE_IO);
 
@@ -942,29 +935,22 @@ namespace quda {
     vec_outfile += "_level_";
     vec_outfile += std::to_string(param.level);
 
-    if (strcmp(param.mg_global.vec_outfile,"")!=0) {
-      if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Start saving %d vectors to %s\n", Nvec, vec_outfile.c_str());
+    if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Start saving %d vectors to %s\n", Nvec, vec_outfile.c_str());
 
-      void **V = static_cast<void**>(safe_malloc(Nvec*sizeof(void*)));
-      for (int i=0; i<Nvec; i++) V[i] = B_[i]->V();
+    void **V = static_cast<void**>(arena_malloc(Nvec*sizeof(void*)));
+    for (int i=0; i<Nvec; i++) V[i] = B_[i]->V();
 
-      write_spinor_field(vec_outfile.c_str(), &V[0], B_[0]->Precision(), B_[0]->X(),
-			 B_[0]->Ncolor(), B_[0]->Nspin(), Nvec, 0,  (char**)0);
+    write_spinor_field(vec_outfile.c_str(), &V[0], B_[0]->Precision(), B_[0]->X(),
+                       B_[0]->Ncolor(), B_[0]->Nspin(), Nvec, 0,  (char**)0);
 
-      host_free(V);
-      if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Done saving vectors\n");
-    }
+    host_free(V);
+    if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Done saving vectors\n");
 
     if (B[0]->Location() == QUDA_CUDA_FIELD_LOCATION) {
       for (int i=0; i<Nvec; i++) delete B_[i];
     }
 
     profile_global.TPSTOP(QUDA_PROFILE_IO);
-#else
-    if (strcmp(param.mg_global.vec_outfile,"")!=0) {
-      errorQuda("\nQIO library was not built.\n");
-    }
-#endif
   }
 
   void MG::dumpNullVectors() const
@@ -89,10 +89,10 @@ namespace quda {
     @brief Generate full SU(2) matrix (four real numbers instead of 2x2 complex matrix) and update link matrix.
     Get from MILC code.
     @param al weight
-    @param localstate CURAND rng state
+    @param localstate Philox rng state
  */
   template <class T>
-  __device__ static inline Matrix<T,2> generate_su2_matrix_milc(T al, cuRNGState& localState){
+  __host__ __device__ static inline Matrix<T,2> generate_su2_matrix_milc(T al, PhiloxState& localState){
     T xr1, xr2, xr3, xr4, d, r;
     int k;
     xr1 = Random<T>(localState);
@@ -139,13 +139,13 @@ namespace quda {
     a(0,0) = 1.0 - d;
     //compute r
     xr3 = 1.0 - a(0,0) * a(0,0);
-    xr3 = abs(xr3);
+    xr3 = fabs(xr3);
     r = sqrt(xr3);
     //compute a3
     a(1,1) = (2.0 * Random<T>(localState) - 1.0) * r;
     //compute a1 and a2
     xr1 = xr3 - a(1,1) * a(1,1);
-    xr1 = abs(xr1);
+    xr1 = fabs(xr1);
     xr1 = sqrt(xr1);
     //xr2 is a random number between 0 and 2*pi
     xr2 = PII * Random<T>(localState);
@@ -300,11 +300,11 @@ namespace quda {
     @brief Link update by pseudo-heatbath
     @param U link to be updated
     @param F staple
-    @param localstate CURAND rng state
+    @param localstate Philox rng state
  */
   template <class Float, int NCOLORS>
-  __device__ inline void heatBathSUN( Matrix<complex<Float>,NCOLORS>& U, Matrix<complex<Float>,NCOLORS> F,
-                                      cuRNGState& localState, Float BetaOverNc ){
+  __host__ __device__ inline void heatBathSUN( Matrix<complex<Float>,NCOLORS>& U, Matrix<complex<Float>,NCOLORS> F,
+                                               PhiloxState& localState, Float BetaOverNc ){
 
     if ( NCOLORS == 3 ) {
       //////////////////////////////////////////////////////////////////
@@ -436,7 +436,7 @@ namespace quda {
      @param F staple
    */
   template <class Float, int NCOLORS>
-  __device__ inline void overrelaxationSUN( Matrix<complex<Float>,NCOLORS>& U, Matrix<complex<Float>,NCOLORS> F ){
+  __host__ __device__ inline void overrelaxationSUN( Matrix<complex<Float>,NCOLORS>& U, Matrix<complex<Float>,NCOLORS> F ){
 
     if ( NCOLORS == 3 ) {
       //////////////////////////////////////////////////////////////////
@@ -596,21 +596,65 @@ namespace quda {
       for ( int dir = 0; dir < 4; ++dir ) X[dir] = data.X()[dir];
 #endif
       threads = X[0] * X[1] * X[2] * X[3] >> 1;
+      if ( rngstate.VolumeCB() != threads )
+        errorQuda("RNG volume %d does not match gauge field volume %d", rngstate.VolumeCB(), threads);
     }
   };
 
 
+/**
+    @brief Sum of the staples around the link U_mu(x)
+    @param dataOr gauge field accessor
+    @param x coordinates of the site (extended if the field is)
+    @param X lattice dimensions (extended if the field is)
+    @param idx checkerboard index of the site
+ */
+  template<typename Float, int NCOLORS, typename Gauge>
+  __host__ __device__ inline Matrix<complex<Float>,NCOLORS> computeStaple(Gauge &dataOr, const int x[], const int X[],
+                                                                          int idx, int mu, int parity){
+    Matrix<complex<Float>,NCOLORS> staple;
+    setZero(&staple);
+
+    Matrix<complex<Float>,NCOLORS> U;
+    for ( int nu = 0; nu < 4; nu++ ) if ( mu != nu ) {
+        int dx[4] = { 0, 0, 0, 0 };
+        Matrix<complex<Float>,NCOLORS> link;
+        dataOr.load((Float*)(link.data), idx, nu, parity);
+        dx[nu]++;
+        dataOr.load((Float*)(U.data), linkIndexShift(x,dx,X), mu, 1 - parity);
+        link *= U;
+        dx[nu]--;
+        dx[mu]++;
+        dataOr.load((Float*)(U.data), linkIndexShift(x,dx,X), nu, 1 - parity);
+        link *= conj(U);
+        staple += link;
+        dx[mu]--;
+        dx[nu]--;
+        dataOr.load((Float*)(link.data), linkIndexShift(x,dx,X), nu, 1 - parity);
+        dataOr.load((Float*)(U.data), linkIndexShift(x,dx,X), mu, 1 - parity);
+        link = conj(link) * U;
+        dx[mu]++;
+        dataOr.load((Float*)(U.data), linkIndexShift(x,dx,X), nu, parity);
+        link *= U;
+        staple += link;
+      }
+    return staple;
+  }
+
+
   template<typename Float, typename Gauge, int NCOLORS, bool HeatbathOrRelax>
   __global__ void compute_heatBath(MonteArg<Gauge, Float, NCOLORS> arg, int mu, int parity){
     int idx = threadIdx.x + blockIdx.x * blockDim.x;
     if ( idx >= arg.threads ) return;
-    int id = idx;
     int X[4];
     #pragma unroll
     for ( int dr = 0; dr < 4; ++dr ) X[dr] = arg.X[dr];
 
     int x[4];
     getCoords(x, idx, X, parity);
+    // the stream of the link is keyed on its global site and direction, the generation is the sweep
+    PhiloxState localState;
+    if ( HeatbathOrRelax ) localState = arg.rngstate.State(x, mu, 4);
 #ifdef MULTI_GPU
     #pragma unroll
     for ( int dr = 0; dr < 4; ++dr ) {
@@ -620,37 +664,12 @@ namespace quda {
     idx = linkIndex(x,X);
 #endif
 
-    Matrix<complex<Float>,NCOLORS> staple;
-    setZero(&staple);
+    Matrix<complex<Float>,NCOLORS> staple = computeStaple<Float, NCOLORS>(arg.dataOr, x, X, idx, mu, parity);
 
     Matrix<complex<Float>,NCOLORS> U;
-    for ( int nu = 0; nu < 4; nu++ ) if ( mu != nu ) {
-        int dx[4] = { 0, 0, 0, 0 };
-        Matrix<complex<Float>,NCOLORS> link;
-        arg.dataOr.load((Float*)(link.data), idx, nu, parity);
-        dx[nu]++;
-        arg.dataOr.load((Float*)(U.data), linkIndexShift(x,dx,X), mu, 1 - parity);
-        link *= U;
-        dx[nu]--;
-        dx[mu]++;
-        arg.dataOr.load((Float*)(U.data), linkIndexShift(x,dx,X), nu, 1 - parity);
-        link *= conj(U);
-        staple += link;
-        dx[mu]--;
-        dx[nu]--;
-        arg.dataOr.load((Float*)(link.data), linkIndexShift(x,dx,X), nu, 1 - parity);
-        arg.dataOr.load((Float*)(U.data), linkIndexShift(x,dx,X), mu, 1 - parity);
-        link = conj(link) * U;
-        dx[mu]++;
-        arg.dataOr.load((Float*)(U.data), linkIndexShift(x,dx,X), nu, parity);
-        link *= U;
-        staple += link;
-      }
     arg.dataOr.load((Float*)(U.data), idx, mu, parity);
     if ( HeatbathOrRelax ) {
-      cuRNGState localState = arg.rngstate.State()[ id ];
       heatBathSUN<Float, NCOLORS>( U, conj(staple), localState, arg.BetaOverNc );
-      arg.rngstate.State()[ id ] = localState;
     }
     else{
       overrelaxationSUN<Float, NCOLORS>( U, conj(staple) );
@@ -659,9 +678,40 @@ namespace quda {
   }
 
 
+  /**
+     @brief Number of floating point operations per heatbath or
+     overrelaxation link update
+  */
+  template <int NCOLORS, bool HeatbathOrRelax>
+  long long monteFlopsPerLink() {
+
+    //NEED TO CHECK THIS!!!!!!
+    if ( NCOLORS == 3 ) {
+      long long flop = 2268LL;
+      if ( HeatbathOrRelax ) {
+        flop += 801LL;
+      }
+      else{
+        flop += 843LL;
+      }
+      return flop;
+    }
+    else{
+      long long flop = NCOLORS * NCOLORS * NCOLORS * 84LL;
+      if ( HeatbathOrRelax ) {
+        flop += NCOLORS * NCOLORS * NCOLORS + (NCOLORS * ( NCOLORS - 1) / 2) * (46LL + 48LL + 56LL * NCOLORS);
+      }
+      else{
+        flop += NCOLORS * NCOLORS * NCOLORS + (NCOLORS * ( NCOLORS - 1) / 2) * (17LL + 112LL * NCOLORS);
+      }
+      return flop;
+    }
+  }
+
+
   template<typename Float, typename Gauge, int NCOLORS, int NElems, bool HeatbathOrRelax>
   class GaugeHB : Tunable {
-    MonteArg<Gauge, Float, NCOLORS> arg;
+    MonteArg<Gauge, Float, NCOLORS> &arg;
     int mu;
     int parity;
     mutable char aux_string[128];       // used as a label in the autotuner
@@ -705,51 +755,20 @@ namespace quda {
       return TuneKey(vol.str().c_str(), typeid(*this).name(), aux_string);
     }
 
-    void preTune() {
-      arg.data.backup();
-      if(HeatbathOrRelax) arg.rngstate.backup();
-    }
-    void postTune() {
-      arg.data.restore();
-      if(HeatbathOrRelax) arg.rngstate.restore();
-    }
+    void preTune() { arg.data.backup(); }
+    void postTune() { arg.data.restore(); }
     long long flops() const {
-
-      //NEED TO CHECK THIS!!!!!!
-      if ( NCOLORS == 3 ) {
-        long long flop = 2268LL;
-        if ( HeatbathOrRelax ) {
-          flop += 801LL;
-        }
-        else{
-          flop += 843LL;
-        }
-        flop *= arg.threads;
-        return flop;
-      }
-      else{
-        long long flop = NCOLORS * NCOLORS * NCOLORS * 84LL;
-        if ( HeatbathOrRelax ) {
-          flop += NCOLORS * NCOLORS * NCOLORS + (NCOLORS * ( NCOLORS - 1) / 2) * (46LL + 48LL + 56LL * NCOLORS);
-        }
-        else{
-          flop += NCOLORS * NCOLORS * NCOLORS + (NCOLORS * ( NCOLORS - 1) / 2) * (17LL + 112LL * NCOLORS);
-        }
-        flop *= arg.threads;
-        return flop;
-      }
+      return monteFlopsPerLink<NCOLORS, HeatbathOrRelax>() * arg.threads;
     }
     long long bytes() const {
       //NEED TO CHECK THIS!!!!!!
       if ( NCOLORS == 3 ) {
         long long byte = 20LL * NElems * sizeof(Float);
-        if ( HeatbathOrRelax ) byte += 2LL * sizeof(cuRNGState);
         byte *= arg.threads;
         return byte;
       }
       else{
         long long byte = 20LL * NCOLORS * NCOLORS * 2 * sizeof(Float);
-        if ( HeatbathOrRelax ) byte += 2LL * sizeof(cuRNGState);
         byte *= arg.threads;
         return byte;
       }
@@ -781,7 +800,9 @@ namespace quda {
         #endif
         }
       }
+      montearg.rngstate.advance();
     }
+    rngstate.advance(nhb);
     if ( getVerbosity() >= QUDA_SUMMARIZE ) {
       qudaDeviceSynchronize();
       profileHBOVR.TPSTOP(QUDA_PROFILE_COMPUTE);
@@ -844,12 +865,189 @@ namespace quda {
       errorQuda("Invalid Gauge Order\n");
     }
   }
+
+
+  /**
+     Host (cpuGaugeField) engine.  Links of the same parity and
+     direction are independent, so each (parity, mu) sub-sweep is
+     threaded over sites with OpenMP.  The random numbers for a link
+     update come from the same Philox streams as on the device, keyed
+     on the global site and direction with the sweep as generation, so
+     the updated field does not depend on the number of threads or on
+     the process grid.
+  */
+  template <typename Gauge, typename Float, int NCOLORS>
+  struct MonteCPUArg {
+    int threads;       // number of active sites per parity
+    int X[4];          // local grid dimensions
+    int border[4];
+    Gauge dataOr;
+    cpuGaugeField &data;
+    Float BetaOverNc;
+    RNG rngstate;
+    MonteCPUArg(const Gauge &dataOr, cpuGaugeField & data, Float Beta, RNG &rngstate)
+      : dataOr(dataOr), data(data), rngstate(rngstate) {
+      BetaOverNc = Beta / (Float)NCOLORS;
+      for ( int dir = 0; dir < 4; ++dir ) {
+        border[dir] = data.R()[dir];
+        X[dir] = data.X()[dir] - border[dir] * 2;
+      }
+      threads = X[0] * X[1] * X[2] * X[3] >> 1;
+      if ( rngstate.VolumeCB() != threads )
+        errorQuda("RNG volume %d does not match gauge field volume %d", rngstate.VolumeCB(), threads);
+    }
+  };
+
+
+  template<typename Float, typename Gauge, int NCOLORS, bool HeatbathOrRelax>
+  void compute_heatBathCPU(MonteCPUArg<Gauge, Float, NCOLORS> &arg, int mu, int parity){
+#pragma omp parallel for schedule(runtime)
+    for ( int id = 0; id < arg.threads; id++ ) {
+      int X[4];
+      for ( int dr = 0; dr < 4; ++dr ) X[dr] = arg.X[dr];
+
+      int x[4];
+      getCoords(x, id, X, parity);
+      PhiloxState localState;
+      if ( HeatbathOrRelax ) localState = arg.rngstate.State(x, mu, 4);
+
+      for ( int dr = 0; dr < 4; ++dr ) {
+        x[dr] += arg.border[dr];
+        X[dr] += 2 * arg.border[dr];
+      }
+      int idx = linkIndex(x,X);
+
+      Matrix<complex<Float>,NCOLORS> staple = computeStaple<Float, NCOLORS>(arg.dataOr, x, X, idx, mu, parity);
+
+      Matrix<complex<Float>,NCOLORS> U;
+      arg.dataOr.load((Float*)(U.data), idx, mu, parity);
+      if ( HeatbathOrRelax ) {
+        heatBathSUN<Float, NCOLORS>( U, conj(staple), localState, arg.BetaOverNc );
+      }
+      else{
+        overrelaxationSUN<Float, NCOLORS>( U, conj(staple) );
+      }
+      arg.dataOr.save((Float*)(U.data), idx, mu, parity);
+    }
+  }
+
+
+  template<typename Float, typename Gauge, int NCOLORS, bool HeatbathOrRelax>
+  class GaugeHBCPU : Tunable {
+    MonteCPUArg<Gauge, Float, NCOLORS> &arg;
+    int mu;
+    int parity;
+    private:
+    unsigned int sharedBytesPerThread() const { return 0; }
+    unsigned int sharedBytesPerBlock(const TuneParam &param) const { return 0; }
+    bool tuneGridDim() const { return false; }
+    unsigned int minThreads() const { return arg.threads; }
+
+    bool hostKernel() const { return true; }
+    unsigned int hostWorkItems() const { return arg.threads; }
+
+    public:
+    GaugeHBCPU(MonteCPUArg<Gauge, Float, NCOLORS> &arg)
+      : arg(arg), mu(0), parity(0) {
+    }
+    ~GaugeHBCPU () {
+    }
+    void SetParam(int _mu, int _parity){
+      mu = _mu;
+      parity = _parity;
+    }
+    void apply(const cudaStream_t &stream){
+      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+      HostLaunch launch(tp);
+      compute_heatBathCPU<Float, Gauge, NCOLORS, HeatbathOrRelax>(arg, mu, parity);
+    }
+
+    TuneKey tuneKey() const {
+      std::stringstream vol;
+      vol << arg.X[0] << "x";
+      vol << arg.X[1] << "x";
+      vol << arg.X[2] << "x";
+      vol << arg.X[3];
+      std::stringstream aux;
+      aux << "threads=" << arg.threads << ",prec=" << sizeof(Float) << getOmpThreadStr();
+      return TuneKey(vol.str().c_str(), typeid(*this).name(), aux.str().c_str());
+    }
+
+    void preTune() { arg.data.backup(); }
+    void postTune() { arg.data.restore(); }
+
+    long long flops() const { return monteFlopsPerLink<NCOLORS, HeatbathOrRelax>() * arg.threads; }
+    long long bytes() const { return 20LL * NCOLORS * NCOLORS * 2 * sizeof(Float) * arg.threads; }
+  };
+
+
+  template<typename Float, int NCOLORS, typename Gauge>
+  void Monte( Gauge dataOr, cpuGaugeField& data, RNG &rngstate, Float Beta, int nhb, int nover) {
+
+    TimeProfile profileHBOVR("HeatBath_OR_Relax_CPU", false);
+    MonteCPUArg<Gauge, Float, NCOLORS> montearg(dataOr, data, Beta, rngstate);
+    const bool exchange = comm_partitioned();
+
+    if ( getVerbosity() >= QUDA_SUMMARIZE ) profileHBOVR.TPSTART(QUDA_PROFILE_COMPUTE);
+    GaugeHBCPU<Float, Gauge, NCOLORS, true> hb(montearg);
+    for ( int step = 0; step < nhb; ++step ) {
+      for ( int parity = 0; parity < 2; ++parity ) {
+        for ( int mu = 0; mu < 4; ++mu ) {
+          hb.SetParam(mu, parity);
+          hb.apply(0);
+          if ( exchange ) data.exchangeExtendedGhost(data.R(), false);
+        }
+      }
+      montearg.rngstate.advance();
+    }
+    rngstate.advance(nhb);
+    if ( getVerbosity() >= QUDA_SUMMARIZE ) {
+      profileHBOVR.TPSTOP(QUDA_PROFILE_COMPUTE);
+      double secs = profileHBOVR.Last(QUDA_PROFILE_COMPUTE);
+      double gflops = (hb.flops() * 8 * nhb * 1e-9) / (secs);
+      double gbytes = hb.bytes() * 8 * nhb / (secs * 1e9);
+      printfQuda("HB (CPU): Time = %6.6f s, Gflop/s = %6.1f, GB/s = %6.1f\n", secs, gflops * comm_size(), gbytes * comm_size());
+    }
+
+    if ( getVerbosity() >= QUDA_SUMMARIZE ) profileHBOVR.TPSTART(QUDA_PROFILE_COMPUTE);
+    GaugeHBCPU<Float, Gauge, NCOLORS, false> relax(montearg);
+    for ( int step = 0; step < nover; ++step ) {
+      for ( int parity = 0; parity < 2; ++parity ) {
+        for ( int mu = 0; mu < 4; ++mu ) {
+          relax.SetParam(mu, parity);
+          relax.apply(0);
+          if ( exchange ) data.exchangeExtendedGhost(data.R(), false);
+        }
+      }
+    }
+    if ( getVerbosity() >= QUDA_SUMMARIZE ) {
+      profileHBOVR.TPSTOP(QUDA_PROFILE_COMPUTE);
+      double secs = profileHBOVR.Last(QUDA_PROFILE_COMPUTE);
+      double gflops = (relax.flops() * 8 * nover * 1e-9) / (secs);
+      double gbytes = relax.bytes() * 8 * nover / (secs * 1e9);
+      printfQuda("OVR (CPU): Time = %6.6f s, Gflop/s = %6.1f, GB/s = %6.1f\n", secs, gflops * comm_size(), gbytes * comm_size());
+    }
+  }
+
+
+  template<typename Float>
+  void Monte( cpuGaugeField& data, RNG &rngstate, Float Beta, int nhb, int nover) {
+
+    // host fields are only updated in the legacy no-reconstruct orders
+    if ( data.Order() == QUDA_QDP_GAUGE_ORDER ) {
+      Monte<Float, 3>(gauge::QDPOrder<Float,18>(data), data, rngstate, Beta, nhb, nover);
+    } else if ( data.Order() == QUDA_MILC_GAUGE_ORDER ) {
+      Monte<Float, 3>(gauge::MILCOrder<Float,18>(data), data, rngstate, Beta, nhb, nover);
+    } else {
+      errorQuda("Order %d not supported on the host", data.Order());
+    }
+  }
 #endif // GPU_GAUGE_ALG
 
 /** @brief Perform heatbath and overrelaxation. Performs nhb heatbath steps followed by nover overrelaxation steps.
  *
  * @param[in,out] data Gauge field
- * @param[in,out] rngstate state of the CURAND random number generator
+ * @param[in,out] rngstate random number generator, advanced by nhb
  * @param[in] Beta inverse of the gauge coupling, beta = 2 Nc / g_0^2
  * @param[in] nhb number of heatbath steps
  * @param[in] nover number of overrelaxation steps
@@ -868,5 +1066,19 @@ namespace quda {
 #endif // GPU_GAUGE_ALG
   }
 
+  void Monte( cpuGaugeField& data, RNG &rngstate, double Beta, int nhb, int nover) {
+#ifdef GPU_GAUGE_ALG
+    if ( data.Precision() == QUDA_SINGLE_PRECISION ) {
+      Monte<float> (data, rngstate, (float)Beta, nhb, nover);
+    } else if ( data.Precision() == QUDA_DOUBLE_PRECISION ) {
+      Monte<double>(data, rngstate, Beta, nhb, nover);
+    } else {
+      errorQuda("Precision %d not supported", data.Precision());
+    }
+#else
+    errorQuda("Pure gauge code has not been built");
+#endif // GPU_GAUGE_ALG
+  }
+
 
 }
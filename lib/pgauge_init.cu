@@ -180,9 +180,9 @@ namespace quda {
 #else
       for ( int dir = 0; dir < 4; ++dir ) X[dir] = data.X()[dir];
 #endif
-      //the optimal number of RNG states in rngstate array must be equal to half the lattice volume
-      //this number is the same used in heatbath...
       threads = X[0] * X[1] * X[2] * X[3] >> 1;
+      if ( rngstate.VolumeCB() != threads )
+        errorQuda("RNG volume %d does not match gauge field volume %d", rngstate.VolumeCB(), threads);
     }
   };
 
@@ -234,18 +234,18 @@ namespace quda {
 
 /**
     @brief Generate the four random real elements of the SU(2) matrix
-    @param localstate CURAND rng state
+    @param localstate Philox rng state
     @return four real numbers of the SU(2) matrix
  */
   template <class T>
-  __device__ static inline Matrix<T,2> randomSU2(cuRNGState& localState){
+  __host__ __device__ static inline Matrix<T,2> randomSU2(PhiloxState& localState){
     Matrix<T,2> a;
     T aabs, ctheta, stheta, phi;
     a(0,0) = Random<T>(localState, (T)-1.0, (T)1.0);
     aabs = sqrt( 1.0 - a(0,0) * a(0,0));
     ctheta = Random<T>(localState, (T)-1.0, (T)1.0);
     phi = PII * Random<T>(localState);
-    stheta = ( curand(&localState) & 1 ? 1 : -1 ) * sqrt( (T)1.0 - ctheta * ctheta );
+    stheta = ( philoxNext(localState) & 1 ? 1 : -1 ) * sqrt( (T)1.0 - ctheta * ctheta );
     a(0,1) = aabs * stheta * cos( phi );
     a(1,0) = aabs * stheta * sin( phi );
     a(1,1) = aabs * ctheta;
@@ -298,11 +298,11 @@ namespace quda {
 
 /**
     @brief Generate a SU(Nc) random matrix
-    @param localstate CURAND rng state
+    @param localstate Philox rng state
     @return SU(Nc) matrix
  */
   template <class Float, int NCOLORS>
-  __device__ inline Matrix<complex<Float>,NCOLORS> randomize( cuRNGState& localState ){
+  __host__ __device__ inline Matrix<complex<Float>,NCOLORS> randomize( PhiloxState& localState ){
     Matrix<complex<Float>,NCOLORS> U;
 
     for ( int i = 0; i < NCOLORS; i++ )
@@ -323,34 +323,30 @@ namespace quda {
 
   template<typename Float, typename Gauge, int NCOLORS>
   __global__ void compute_InitGauge_HotStart(InitGaugeHotArg<Gauge> arg){
-    int idx = threadIdx.x + blockIdx.x * blockDim.x;
-    if ( idx >= arg.threads ) return;
+    int id = threadIdx.x + blockIdx.x * blockDim.x;
+    if ( id >= arg.threads ) return;
+    int idx = id;
   #ifdef MULTI_GPU
-    int X[4], x[4];
+    int X[4];
     for ( int dr = 0; dr < 4; ++dr ) X[dr] = arg.X[dr];
     for ( int dr = 0; dr < 4; ++dr ) X[dr] += 2 * arg.border[dr];
-    int id = idx;
-    cuRNGState localState = arg.rngstate.State()[ id ];
-  #else
-    cuRNGState localState = arg.rngstate.State()[ idx ];
   #endif
     for ( int parity = 0; parity < 2; parity++ ) {
-    #ifdef MULTI_GPU
+      int x[4];
       getCoords(x, id, arg.X, parity);
-      for ( int dr = 0; dr < 4; ++dr ) x[dr] += arg.border[dr];
-      idx = linkIndex(x,X);
+    #ifdef MULTI_GPU
+      int xe[4];
+      for ( int dr = 0; dr < 4; ++dr ) xe[dr] = x[dr] + arg.border[dr];
+      idx = linkIndex(xe,X);
     #endif
       for ( int d = 0; d < 4; d++ ) {
+        // one Philox stream per link, keyed on the global site and direction
+        PhiloxState localState = arg.rngstate.State(x, d, 4);
         Matrix<complex<Float>,NCOLORS> U;
         U = randomize<Float, NCOLORS>(localState);
         arg.dataOr.save((Float*)(U.data),idx, d, parity);
       }
     }
-  #ifdef MULTI_GPU
-    arg.rngstate.State()[ id ] = localState;
-  #else
-    arg.rngstate.State()[ idx ] = localState;
-  #endif
   }
 
 
@@ -401,8 +397,6 @@ namespace quda {
 
     }
 
-    void preTune(){ arg.rngstate.backup(); }
-    void postTune(){ arg.rngstate.restore(); }
     long long flops() const {
       return 0;
     }                                  // Only correct if there is no link reconstruction, no cub reduction accounted also
@@ -421,6 +415,7 @@ namespace quda {
     InitGaugeHotArg<Gauge> initarg(dataOr, data, rngstate);
     InitGaugeHot<Float, Gauge, NCOLORS> init(initarg);
     init.apply(0);
+    rngstate.advance();
     checkCudaError();
     qudaDeviceSynchronize();
 
@@ -454,7 +449,7 @@ namespace quda {
 /** @brief Perform a hot start to the gauge field, random SU(3) matrix, followed by reunitarization, also exchange borders links in multi-GPU case.
  *
  * @param[in,out] data Gauge field
- * @param[in,out] rngstate state of the CURAND random number generator
+ * @param[in,out] rngstate random number generator, advanced by the call
  */
   void InitGaugeField( cudaGaugeField& data, RNG &rngstate) {
 #ifdef GPU_GAUGE_ALG
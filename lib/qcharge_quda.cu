@@ -9,6 +9,7 @@
 #include <atomic.cuh>
 #include <cub_helper.cuh>
 #include <index_helper.cuh>
+#include <blas_helper.cuh>
 
 #ifndef Pi2
 #define Pi2 6.2831853071795864769252867665590
@@ -25,6 +26,19 @@ namespace quda {
       : ReduceArg<double>(), data(data), threads(Fmunu.VolumeCB()) {}
   };
 
+  // Unnormalized topological charge density at one site from the field strength
+  template<typename Float, typename Gauge>
+  __host__ __device__ inline double qChargeSite(QChargeArg<Float,Gauge> &arg, int idx, int parity) {
+    // Load the field-strength tensor from memory
+    Matrix<complex<Float>,3> F[6];
+    for (int i=0; i<6; ++i) F[i] = arg.data(i, idx, parity);
+
+    double Q1 = getTrace(F[0]*F[5]).real();
+    double Q2 = getTrace(F[1]*F[4]).real();
+    double Q3 = getTrace(F[3]*F[2]).real();
+    return (Q1 + Q3 - Q2);
+  }
+
   // Core routine for computing the topological charge from the field strength
   template<int blockSize, typename Float, typename Gauge>
   __global__ void qChargeComputeKernel(QChargeArg<Float,Gauge> arg) {
@@ -34,15 +48,7 @@ namespace quda {
     double Q = 0.0;
 
     while (idx < arg.threads) {
-      // Load the field-strength tensor from global memory
-      Matrix<complex<Float>,3> F[6];
-      for (int i=0; i<6; ++i) F[i] = arg.data(i, idx, parity);
-
-      double Q1 = getTrace(F[0]*F[5]).real();
-      double Q2 = getTrace(F[1]*F[4]).real();
-      double Q3 = getTrace(F[3]*F[2]).real();
-      Q += (Q1 + Q3 - Q2);
-
+      Q += qChargeSite(arg, idx, parity);
       idx += blockDim.x*gridDim.x;
     }
     Q /= (Pi2*Pi2);
@@ -59,22 +65,29 @@ namespace quda {
     private:
       bool tuneGridDim() const { return true; }
 
+      // the CPU variant threads over fixed-size blocks of sites
+      bool hostKernel() const { return location == QUDA_CPU_FIELD_LOCATION; }
+      unsigned int hostWorkItems() const { return blas::hostReduceBlocks(arg.threads, 2); }
+
     public:
       QChargeCompute(QChargeArg<Float,Gauge> &arg, GaugeField *vol, QudaFieldLocation location) 
         : arg(arg), vol(vol), location(location) {
 	writeAuxString("threads=%d,prec=%lu",arg.threads,sizeof(Float));
+	if (location == QUDA_CPU_FIELD_LOCATION) strcat(aux, getOmpThreadStr());
       }
 
       virtual ~QChargeCompute() { }
 
       void apply(const cudaStream_t &stream) {
+        TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
         if (location == QUDA_CUDA_FIELD_LOCATION) {
           arg.result_h[0] = 0.;
-          TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
           LAUNCH_KERNEL(qChargeComputeKernel, tp, stream, arg, Float);
           qudaDeviceSynchronize();
         } else { // run the CPU code
-	  errorQuda("qChargeComputeKernel not supported on CPU");
+          HostLaunch launch(tp);
+          arg.result_h[0] = blas::hostReduce<double>([&](int parity, int idx) { return qChargeSite(arg, idx, parity); },
+                                                     arg.threads) / (Pi2*Pi2);
         }
       }
 
@@ -100,6 +113,18 @@ namespace quda {
     Float computeQCharge(GaugeField &Fmunu, QudaFieldLocation location){
       Float res = 0.;
 
+      if (location == QUDA_CPU_FIELD_LOCATION) {
+        // host fields are only supported in the legacy no-reconstruct orders
+        if (Fmunu.Order() == QUDA_QDP_GAUGE_ORDER) {
+          computeQCharge<Float>(gauge::QDPOrder<Float,18>(Fmunu), Fmunu, location, res);
+        } else if (Fmunu.Order() == QUDA_MILC_GAUGE_ORDER) {
+          computeQCharge<Float>(gauge::MILCOrder<Float,18>(Fmunu), Fmunu, location, res);
+        } else {
+          errorQuda("Order %d not supported on the host", Fmunu.Order());
+        }
+        return res;
+      }
+
       if (!Fmunu.isNative()) errorQuda("Topological charge computation only supported on native ordered fields");
 
       if (Fmunu.Reconstruct() == QUDA_RECONSTRUCT_NO) {
@@ -124,6 +149,10 @@ namespace quda {
 
     double charge = 0;
 #ifdef GPU_GAUGE_TOOLS
+    if (Fmunu.Location() != location) {
+      errorQuda("Fmunu location %d must match location %d", Fmunu.Location(), location);
+    }
+
     if (Fmunu.Precision() == QUDA_SINGLE_PRECISION){
       charge = computeQCharge<float>(Fmunu, location);
     } else if(Fmunu.Precision() == QUDA_DOUBLE_PRECISION) {
@@ -1,13 +1,26 @@
+#include <string.h>
+#include <stdlib.h>
 #include <qio.h>
 #include <qio_util.h>
 #include <quda.h>
 #include <util_quda.h>
+#include <field_io.h>
 
 QIO_Layout layout;
 int lattice_dim;
 int lattice_size[4];
 int this_node;
 
+// write in the native format instead of QIO if QUDA_FIELD_IO=native,
+// or if compression was requested since QIO cannot store it
+static bool native_field_io() {
+  static char *field_io = getenv("QUDA_FIELD_IO");
+  if (field_io && strcmp(field_io, "native") != 0 && strcmp(field_io, "qio") != 0)
+    errorQuda("QUDA_FIELD_IO=%s not recognized", field_io);
+  if (quda::native_field_io_precision(QUDA_DOUBLE_PRECISION, true) < QUDA_SINGLE_PRECISION) return true;
+  return field_io && strcmp(field_io, "native") == 0;
+}
+
 QIO_Reader *open_test_input(const char *filename, int volfmt, int serpar) {
   QIO_String *xml_file_in;
   QIO_Reader *infile;
@@ -156,6 +169,11 @@ void set_layout(const int *X) {
 }
 
 void read_gauge_field(const char *filename, void *gauge[], QudaPrecision precision, const int *X, int argc, char *argv[]) {
+  if (quda::is_native_field_file(filename)) {
+    quda::read_gauge_field_native(filename, gauge, precision, X);
+    return;
+  }
+
   this_node = mynode();
 
   set_layout(X);
@@ -197,6 +215,11 @@ int read_field(QIO_Reader *infile, int Ninternal, int count, void *field_in[], Q
 
 void read_spinor_field(const char *filename, void *V[], QudaPrecision precision, const int *X,
 		       int nColor, int nSpin, int Nvec, int argc, char *argv[]) {
+  if (quda::is_native_field_file(filename)) {
+    quda::read_spinor_field_native(filename, V, precision, X, nColor, nSpin, Nvec);
+    return;
+  }
+
   this_node = mynode();
 
   set_layout(X);
@@ -287,6 +310,11 @@ int write_su3_field(QIO_Writer *outfile, int count, void *field_out[],
 
 void write_gauge_field(const char *filename, void* gauge[], QudaPrecision precision, const int *X,
     int argc, char* argv[]) {
+  if (native_field_io()) {
+    quda::write_gauge_field_native(filename, gauge, precision, X, quda::native_field_io_precision(precision, false));
+    return;
+  }
+
   this_node = mynode();
 
   set_layout(X);
@@ -336,6 +364,12 @@ int write_field(QIO_Writer *outfile, int Ninternal, int count, void *field_out[]
 
 void write_spinor_field(const char *filename, void *V[], QudaPrecision precision, const int *X,
 		       int nColor, int nSpin, int Nvec, int argc, char *argv[]) {
+  if (native_field_io()) {
+    quda::write_spinor_field_native(filename, V, precision, X, nColor, nSpin, Nvec,
+				    quda::native_field_io_precision(precision, true));
+    return;
+  }
+
   this_node = mynode();
 
   set_layout(X);
@@ -274,39 +274,54 @@ doubleN reduceCuda(const double2 &a, const double2 &b,
 }
 
 /**
-   Generic reduce kernel with four loads and up to four stores.
+   Generic host reduce kernel with five loads and up to five stores.
+   The sites are split into fixed-size blocks which are distributed
+   over OpenMP threads.  Each block is summed in site order with its
+   own copy of the reducer, and the block partial sums are then
+   combined pairwise, so the result does not depend on the number of
+   threads.
   */
-template <typename ReduceType, typename Float, int writeX, int writeY, int writeZ,
+template <typename ReduceType, typename Float2, int writeX, int writeY, int writeZ,
   int writeW, int writeV, typename SpinorX, typename SpinorY, typename SpinorZ,
   typename SpinorW, typename SpinorV, typename Reducer>
-ReduceType genericReduce(SpinorX &X, SpinorY &Y, SpinorZ &Z, SpinorW &W, SpinorV &V, Reducer r) {
-
-  ReduceType sum;
-  ::quda::zero(sum);
-
-  for (int parity=0; parity<X.Nparity(); parity++) {
-    for (int x=0; x<X.VolumeCB(); x++) {
-      r.pre();
-      for (int s=0; s<X.Nspin(); s++) {
-	for (int c=0; c<X.Ncolor(); c++) {
-	  complex<Float> X_ = X(parity, x, s, c);
-	  complex<Float> Y_ = Y(parity, x, s, c);
-	  complex<Float> Z_ = Z(parity, x, s, c);
-	  complex<Float> W_ = W(parity, x, s, c);
-	  complex<Float> V_ = V(parity, x, s, c);
-	  r(sum, X_, Y_, Z_, W_, V_);
-	  if (writeX) X(parity, x, s, c) = X_;
-	  if (writeY) Y(parity, x, s, c) = Y_;
-	  if (writeZ) Z(parity, x, s, c) = Z_;
-	  if (writeW) W(parity, x, s, c) = W_;
-	  if (writeV) V(parity, x, s, c) = V_;
-	}
+ReduceType genericReduce(SpinorX &X, SpinorY &Y, SpinorZ &Z, SpinorW &W, SpinorV &V, Reducer r,
+                         int volumeCB, int nParity) {
+
+  constexpr int length = SpinorX::length;
+  const int n_block = hostReduceBlocks(volumeCB, nParity) / nParity;
+  std::vector<ReduceType> partial(nParity * n_block);
+
+#pragma omp parallel for collapse(2)
+  for (int parity=0; parity<nParity; parity++) {
+    for (int b=0; b<n_block; b++) {
+      Reducer r_ = r;
+      ReduceType sum;
+      ::quda::zero(sum);
+
+      const int x_end = (b+1)*host_reduce_block < volumeCB ? (b+1)*host_reduce_block : volumeCB;
+      for (int x=b*host_reduce_block; x<x_end; x++) {
+        Float2 X_[length], Y_[length], Z_[length], W_[length], V_[length];
+        X.load(X_, x, parity);
+        Y.load(Y_, x, parity);
+        Z.load(Z_, x, parity);
+        W.load(W_, x, parity);
+        V.load(V_, x, parity);
+        r_.pre();
+        for (int i=0; i<length; i++) r_(sum, X_[i], Y_[i], Z_[i], W_[i], V_[i]);
+        r_.post(sum);
+        if (writeX) X.save(X_, x, parity);
+        if (writeY) Y.save(Y_, x, parity);
+        if (writeZ) Z.save(Z_, x, parity);
+        if (writeW) W.save(W_, x, parity);
+        if (writeV) V.save(V_, x, parity);
       }
-      r.post(sum);
+
+      partial[parity*n_block + b] = sum;
     }
   }
 
-  return sum;
+  pairwiseSum(partial.data(), nParity * n_block);
+  return partial[0];
 }
 
 template<typename, int N> struct vector { };
@@ -317,9 +332,10 @@ template <typename ReduceType, typename Float, typename zFloat, int nSpin, int n
   int writeX, int writeY, int writeZ, int writeW, int writeV, typename R>
   ReduceType genericReduce(ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField &z,
 			   ColorSpinorField &w, ColorSpinorField &v, R r) {
-  colorspinor::FieldOrderCB<Float,nSpin,nColor,1,order> X(x), Y(y), W(w), V(v);
-  colorspinor::FieldOrderCB<zFloat,nSpin,nColor,1,order> Z(z);
-  return genericReduce<ReduceType,zFloat,writeX,writeY,writeZ,writeW,writeV>(X, Y, Z, W, V, r);
+  typedef typename vector<zFloat,2>::type Float2;
+  HostSpinor<Float2,Float,nSpin,nColor,order> X(x), Y(y), W(w), V(v);
+  HostSpinor<Float2,zFloat,nSpin,nColor,order> Z(z);
+  return genericReduce<ReduceType,Float2,writeX,writeY,writeZ,writeW,writeV>(X, Y, Z, W, V, r, x.VolumeCB(), x.SiteSubset());
 }
 
 template <typename ReduceType, typename Float, typename zFloat, int nSpin, QudaFieldOrder order,
@@ -384,8 +400,25 @@ doubleN genericReduce(ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField
   if (x.FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER) {
     value = genericReduce<ReduceType,Float,zFloat,QUDA_SPACE_SPIN_COLOR_FIELD_ORDER,writeX,writeY,writeZ,writeW,writeV,R>
       (x, y, z, w, v, r);
+  } else if (x.FieldOrder() == QUDA_SPACE_COLOR_SPIN_FIELD_ORDER) {
+    value = genericReduce<ReduceType,Float,zFloat,QUDA_SPACE_COLOR_SPIN_FIELD_ORDER,writeX,writeY,writeZ,writeW,writeV,R>
+      (x, y, z, w, v, r);
+  } else if (x.FieldOrder() == QUDA_PADDED_SPACE_SPIN_COLOR_FIELD_ORDER) {
+#ifdef BUILD_TIFR_INTERFACE
+    value = genericReduce<ReduceType,Float,zFloat,QUDA_PADDED_SPACE_SPIN_COLOR_FIELD_ORDER,writeX,writeY,writeZ,writeW,writeV,R>
+      (x, y, z, w, v, r);
+#else
+    errorQuda("TIFR interface has not been built\n");
+#endif
+  } else if (x.FieldOrder() == QUDA_QDPJIT_FIELD_ORDER) {
+#ifdef BUILD_QDPJIT_INTERFACE
+    value = genericReduce<ReduceType,Float,zFloat,QUDA_QDPJIT_FIELD_ORDER,writeX,writeY,writeZ,writeW,writeV,R>
+      (x, y, z, w, v, r);
+#else
+    errorQuda("QDPJIT interface has not been built\n");
+#endif
   } else {
-    warningQuda("CPU reductions not implemented for %d field order", x.FieldOrder());
+    errorQuda("CPU reductions not implemented for %d field order", x.FieldOrder());
   }
   return set(value);
 }
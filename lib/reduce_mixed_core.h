@@ -110,6 +110,9 @@ doubleN reduceCuda(const double2 &a, const double2 &b, ColorSpinorField &x,
     } else {
       errorQuda("Precision %d not implemented", x.Precision());
     }
+    // mirror the device reduction buffer so that kernels consuming an
+    // asynchronous reduction (e.g., caxpyXmazMR) see the local result
+    *static_cast<doubleN*>(getHostReduceBuffer()) = value;
   }
 
   const int Nreduce = sizeof(doubleN) / sizeof(double);
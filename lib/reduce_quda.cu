@@ -2,6 +2,7 @@
 #include <tune_quda.h>
 #include <float_vector.h>
 #include <color_spinor_field_order.h>
+#include <blas_helper.cuh>
 
 //#define QUAD_SUM
 #ifdef QUAD_SUM
@@ -823,6 +824,79 @@ namespace quda {
         (make_double2(a, 0.0), make_double2(b, 1.0-b), x, y, z, z, z);
     }
 
+    /**
+       double2 pipelinedCGUpdate(d a, d b, V s, V z, V r, V w, V q){}
+       s = w + b*s
+       z = q + b*z
+       r -= a*s
+       w -= a*z
+       Returns (r,r) and (w,r)
+    */
+    template <typename ReduceType, typename Float2, typename FloatN>
+    struct pipelinedCGUpdate_ : public ReduceFunctor<ReduceType, Float2, FloatN> {
+      Float2 a, b;
+      pipelinedCGUpdate_(const Float2 &a, const Float2 &b) : a(a), b(b) { ; }
+      __device__ __host__ void operator()(ReduceType &sum, FloatN &s, FloatN &z, FloatN &r, FloatN &w, FloatN &q) {
+        typedef typename ScalarType<ReduceType>::type scalar;
+        s = w + b.x*s;
+        z = q + b.x*z;
+        r -= a.x*s;
+        w -= a.x*z;
+        norm2_<scalar>(sum.x,r); dot_<scalar>(sum.y,w,r);
+      }
+      static int streams() { return 9; } //! total number of input and output streams
+      static int flops() { return 12; } //! flops per element
+    };
+
+    double2 pipelinedCGUpdate(double alpha, double beta, ColorSpinorField &s, ColorSpinorField &z,
+                              ColorSpinorField &r, ColorSpinorField &w, ColorSpinorField &q) {
+      return reduce::reduceCuda<double2,QudaSumFloat2,pipelinedCGUpdate_,1,1,1,1,0,false>
+        (make_double2(alpha, 0.0), make_double2(beta, 0.0), s, z, r, w, q);
+    }
+
+    /**
+       Compute the local contribution of a reduction, with the global
+       sum disabled, and then start its global sum without waiting for
+       it to complete.
+    */
+    template <typename T, typename Reduction>
+    ReduceFuture<T> reduceAsync(Reduction reduction) {
+      const bool global = commGlobalReduction();
+      commGlobalReductionSet(false);
+      T local = reduction();
+      commGlobalReductionSet(global);
+      return ReduceFuture<T>(local);
+    }
+
+    ReduceFuture<double> norm2Async(const ColorSpinorField &x) {
+      return reduceAsync<double>([&]() { return norm2(x); });
+    }
+
+    ReduceFuture<double> reDotProductAsync(ColorSpinorField &x, ColorSpinorField &y) {
+      return reduceAsync<double>([&]() { return reDotProduct(x, y); });
+    }
+
+    ReduceFuture<Complex> cDotProductAsync(ColorSpinorField &x, ColorSpinorField &y) {
+      return reduceAsync<Complex>([&]() { return cDotProduct(x, y); });
+    }
+
+    ReduceFuture<double3> cDotProductNormAAsync(ColorSpinorField &x, ColorSpinorField &y) {
+      return reduceAsync<double3>([&]() { return cDotProductNormA(x, y); });
+    }
+
+    ReduceFuture<double3> tripleCGReductionAsync(ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField &z) {
+      return reduceAsync<double3>([&]() { return tripleCGReduction(x, y, z); });
+    }
+
+    ReduceFuture<double4> quadrupleCGReductionAsync(ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField &z) {
+      return reduceAsync<double4>([&]() { return quadrupleCGReduction(x, y, z); });
+    }
+
+    ReduceFuture<double2> pipelinedCGUpdateAsync(double alpha, double beta, ColorSpinorField &s, ColorSpinorField &z,
+                                                 ColorSpinorField &r, ColorSpinorField &w, ColorSpinorField &q) {
+      return reduceAsync<double2>([&]() { return pipelinedCGUpdate(alpha, beta, s, z, r, w, q); });
+    }
+
    } // namespace blas
 
 } // namespace quda
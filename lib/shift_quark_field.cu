@@ -187,8 +187,8 @@ namespace quda {
           initTuneParam(param);
         }
 
-        long long flops() const { return 0; } // fixme
-        long long bytes() const { return 0; } // fixme
+        long long flops() const { return 0; } // pure data movement
+        long long bytes() const { return (long long)arg.length * (arg.in.Bytes() + arg.out.Bytes()); }
 
         TuneKey tuneKey() const {
           std::stringstream vol, aux;
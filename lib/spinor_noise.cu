@@ -24,12 +24,19 @@ namespace quda {
     V v;
     const int nParity;
     const int volumeCB;
+    const int volume4CB; // four-dimensional checkerboard volume, the sites are keyed on (4-d site, s)
+    const int Ls;
     RNG rng;
-    Arg(ColorSpinorField &v, RNG &rng) : v(v), nParity(v.SiteSubset()), volumeCB(v.VolumeCB()), rng(rng) { }
+    Arg(ColorSpinorField &v, RNG &rng) : v(v), nParity(v.SiteSubset()), volumeCB(v.VolumeCB()),
+                                         volume4CB(rng.VolumeCB()), Ls(v.VolumeCB() / rng.VolumeCB()), rng(rng)
+    {
+      if (volumeCB != Ls * volume4CB)
+        errorQuda("Field volume %d does not match RNG volume %d", volumeCB, volume4CB);
+    }
   };
 
   template<typename real, typename Arg> // Gauss
-  __device__ __host__ inline void genGauss(Arg &arg, cuRNGState& localState, int parity, int x_cb, int s, int c) {
+  __device__ __host__ inline void genGauss(Arg &arg, PhiloxState& localState, int parity, int x_cb, int s, int c) {
     real phi = 2.0*M_PI*Random<real>(localState);
     real radius = Random<real>(localState);
     radius = sqrt(-1.0 * log(radius));
@@ -37,31 +44,41 @@ namespace quda {
   }
 
   template<typename real, typename Arg> // Uniform
-  __device__ __host__ inline void genUniform(Arg &arg, cuRNGState& localState, int parity, int x_cb, int s, int c) {
+  __device__ __host__ inline void genUniform(Arg &arg, PhiloxState& localState, int parity, int x_cb, int s, int c) {
     real x = Random<real>(localState);
     real y = Random<real>(localState);
     arg.v(parity, x_cb, s, c) = complex<real>(x, y);
   }
 
-  /** CPU function to reorder spinor fields.  */
+  /**
+     Fill a site with noise.  The site draws from its own Philox
+     stream, keyed on its global four-dimensional index and fifth
+     coordinate, so the noise is independent of the partitioning.
+  */
   template <typename real, int Ns, int Nc, QudaNoiseType type, typename Arg>
-  void SpinorNoiseCPU(Arg &arg) {
+  __device__ __host__ inline void spinorNoiseSite(Arg &arg, int parity, int x_cb) {
+    const int s5 = x_cb / arg.volume4CB;
+    PhiloxState localState = arg.rng.State(x_cb - s5 * arg.volume4CB, parity, s5, arg.Ls);
+    for (int s=0; s<Ns; s++) {
+      for (int c=0; c<Nc; c++) {
+        if (type == QUDA_NOISE_GAUSS) genGauss<real>(arg, localState, parity, x_cb, s, c);
+        else if (type == QUDA_NOISE_UNIFORM) genUniform<real>(arg, localState, parity, x_cb, s, c);
+      }
+    }
+  }
 
+  /** CPU function to generate noise spinor fields.  */
+  template <typename real, int Ns, int Nc, QudaNoiseType type, typename Arg>
+  void SpinorNoiseCPU(Arg &arg) {
+#pragma omp parallel for collapse(2) schedule(runtime)
     for (int parity=0; parity<arg.nParity; parity++) {
       for (int x_cb=0; x_cb<arg.volumeCB; x_cb++) {
-        for (int s=0; s<Ns; s++) {
-          for (int c=0; c<Nc; c++) {
-            cuRNGState localState = arg.rng.State()[parity+2*x_cb];
-            if (type == QUDA_NOISE_GAUSS) genGauss<real>(arg, localState, parity, x_cb, s, c);
-            else if (type == QUDA_NOISE_UNIFORM) genUniform<real>(arg, localState, parity, x_cb, s, c);
-            arg.rng.State()[parity+2*x_cb] = localState;
-          }
-        }
+        spinorNoiseSite<real, Ns, Nc, type>(arg, parity, x_cb);
       }
     }
   }
 
-  /** CUDA kernel to reorder spinor fields.  Adopts a similar form as the CPU version, using the same inlined functions. */
+  /** CUDA kernel to generate noise spinor fields.  Adopts a similar form as the CPU version, using the same inlined functions. */
   template <typename real, int Ns, int Nc, QudaNoiseType type, typename Arg>
     __global__ void SpinorNoiseGPU(Arg arg) {
 
@@ -71,14 +88,7 @@ namespace quda {
     int parity = blockIdx.y * blockDim.y + threadIdx.y;
     if (parity >= arg.nParity) return;
 
-    cuRNGState localState = arg.rng.State()[parity+2*x_cb];
-    for (int s=0; s<Ns; s++) {
-      for (int c=0; c<Nc; c++) {
-        if (type == QUDA_NOISE_GAUSS) genGauss<real>(arg, localState, parity, x_cb, s, c);
-        else if (type == QUDA_NOISE_UNIFORM) genUniform<real>(arg, localState, parity, x_cb, s, c);
-      }
-    }
-    arg.rng.State()[parity+2*x_cb] = localState;
+    spinorNoiseSite<real, Ns, Nc, type>(arg, parity, x_cb);
   }
 
   template <typename real, int Ns, int Nc, QudaNoiseType type, typename Arg>
@@ -92,32 +102,31 @@ namespace quda {
     bool tuneGridDim() const { return false; } // Don't tune the grid dimensions.
     unsigned int minThreads() const { return meta.VolumeCB(); }
 
+    // the CPU variant threads over the sites of all parities
+    bool hostKernel() const { return meta.Location() == QUDA_CPU_FIELD_LOCATION; }
+    unsigned int hostWorkItems() const { return arg.nParity * arg.volumeCB; }
+
   public:
     SpinorNoise(Arg &arg, const ColorSpinorField &meta)
       : TunableVectorY(meta.SiteSubset()), arg(arg), meta(meta) {
       strcpy(aux, meta.AuxString());
       strcat(aux, meta.Location()==QUDA_CUDA_FIELD_LOCATION ? ",GPU" : ",CPU");
+      if (meta.Location() == QUDA_CPU_FIELD_LOCATION) strcat(aux, getOmpThreadStr());
     }
 
     void apply(const cudaStream_t &stream) {
       TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
       if (meta.Location() == QUDA_CPU_FIELD_LOCATION) {
-	errorQuda("Not implemented");
+        HostLaunch launch(tp);
+        SpinorNoiseCPU<real, Ns, Nc, type>(arg);
       } else {
 	SpinorNoiseGPU<real, Ns, Nc, type> <<<tp.grid, tp.block, tp.shared_bytes, stream>>>(arg);
       }
     }
 
-    bool advanceTuneParam(TuneParam &param) const {
-      if (meta.Location() == QUDA_CUDA_FIELD_LOCATION) return Tunable::advanceTuneParam(param);
-      else return false;
-    }
-
     TuneKey tuneKey() const { return TuneKey(meta.VolString(), typeid(*this).name(), aux); }
     long long flops() const { return 0; }
     long long bytes() const { return meta.Bytes(); }
-    void preTune() { arg.rng.backup(); }
-    void postTune(){ arg.rng.restore(); }
   };
 
   template <typename real, int Ns, int Nc, QudaFieldOrder order>
@@ -193,15 +202,15 @@ namespace quda {
     case QUDA_SINGLE_PRECISION: spinorNoise<float>(src, randstates, type); break;
     default: errorQuda("Precision %d not implemented", src.Precision());
     }
+    randstates.advance(); // the next call draws fresh noise
   }
 
   void spinorNoise(ColorSpinorField &src, int seed, QudaNoiseType type)
   {
-    RNG* randstates = new RNG(src.Volume(), seed, src.X());
-    randstates->Init();
-    spinorNoise(src, *randstates, type);
-    randstates->Release();
-    delete randstates;
+    int X[4] = { src.X(0), src.X(1), src.X(2), src.X(3) };
+    if (src.SiteSubset() == QUDA_PARITY_SITE_SUBSET) X[0] *= 2;
+    RNG randstates(seed, X);
+    spinorNoise(src, randstates, type);
   }
 
 } // namespace quda
@@ -316,8 +316,17 @@ namespace quda {
     void preTune(){ this->arg.outA.save(); this->arg.outB.save(); }
     void postTune(){ this->arg.outA.load(); this->arg.outB.load(); }
   
-    long long flops() const { return 0; } // FIXME
-    long long bytes() const { return 0; } // FIXME
+    /**
+       @return Number of outer products accumulated per thread: the
+       interior kernel does the one-hop (and three-hop) term in every
+       dimension, the exterior kernel a single term
+    */
+    int terms() const { return arg.kernelType == OPROD_INTERIOR_KERNEL ? 4 * (arg.nFace == 3 ? 2 : 1) : 1; }
+
+    // each term is an outer product (54) and a scaled accumulation (36)
+    long long flops() const { return 90ll * terms() * arg.length; }
+    // each thread loads its spinor, and each term a neighbour spinor and a link read and written
+    long long bytes() const { return (long long)arg.length * (6 + terms() * (6 + 2 * 18)) * sizeof(Float); }
     TuneKey tuneKey() const { return TuneKey(meta.VolString(), typeid(*this).name(), aux);}
   }; // StaggeredOprodField
 
@@ -3,6 +3,58 @@
 
 namespace quda {
 
+  double Timer::Percentile(double q) const
+  {
+    if (count == 0) return 0.0;
+    if (q <= 0.0) return Min();
+    if (q >= 1.0) return Max();
+    const uint64_t rank = static_cast<uint64_t>(q * (count - 1));
+
+    uint64_t cumulative = 0;
+    int b = 0;
+    for (; b < n_bin - 1; b++) {
+      cumulative += histogram[b];
+      if (cumulative > rank) break;
+    }
+
+    // take the middle of the bin, clamped to the recorded extremes
+    double ns;
+    if (b == 0) {
+      ns = 0.5 * (1ull << min_octave);
+    } else if (b == n_bin - 1) {
+      ns = max_ns;
+    } else {
+      const int octave = min_octave + (b - 1) / bins_per_octave;
+      const int sub = (b - 1) % bins_per_octave;
+      ns = static_cast<double>(1ull << octave) * (1.0 + (sub + 0.5) / bins_per_octave);
+    }
+    if (ns < min_ns) ns = min_ns;
+    if (ns > max_ns) ns = max_ns;
+    return 1e-9 * ns;
+  }
+
+  double Timer::Overhead()
+  {
+    static double overhead = -1.0;
+    if (overhead < 0.0) {
+      // take the fastest of several batches to exclude preemption
+      const int n = 1000;
+      uint64_t best = UINT64_MAX;
+      for (int batch = 0; batch < 10; batch++) {
+        Timer timer;
+        const uint64_t start = timerNanoseconds();
+        for (int i = 0; i < n; i++) {
+          timer.Start(__func__, __FILE__, __LINE__);
+          timer.Stop(__func__, __FILE__, __LINE__);
+        }
+        const uint64_t elapsed = timerNanoseconds() - start;
+        if (elapsed < best) best = elapsed;
+      }
+      overhead = 1e-9 * best / n;
+    }
+    return overhead;
+  }
+
   /**< Print out the profile information */
   void TimeProfile::Print() {
     if (profile[QUDA_PROFILE_TOTAL].time > 0.0) {
@@ -13,10 +65,12 @@ namespace quda {
     double accounted = 0.0;
     for (int i=0; i<QUDA_PROFILE_COUNT-1; i++) {
       if (profile[i].count > 0) {
-	printfQuda("     %20s     = %f secs (%6.3g%%), with %8d calls at %e us per call\n",
+	printfQuda("     %20s     = %f secs (%6.3g%%), with %8d calls at %e us per call"
+                   " (min %.3g, median %.3g, p99 %.3g us)\n",
 		   (const char*)&pname[i][0],  profile[i].time,
 		   100*profile[i].time/profile[QUDA_PROFILE_TOTAL].time,
-		   profile[i].count, 1e6*profile[i].time/profile[i].count);
+		   profile[i].count, 1e6*profile[i].time/profile[i].count,
+                   1e6*profile[i].Min(), 1e6*profile[i].Percentile(0.5), 1e6*profile[i].Percentile(0.99));
 	accounted += profile[i].time;
       }
     }
@@ -63,10 +117,13 @@ namespace quda {
     bool print_timer = true; // whether to print that timer
     for (int i=0; i<QUDA_PROFILE_LOWER_LEVEL; i++) { // we do not want to print detailed lower level timers
       if (global_profile[i].count > 0) {
-        if (print_timer) printfQuda("     %20s     = %f secs (%6.3g%%), with %8d calls at %e us per call\n",
+        if (print_timer) printfQuda("     %20s     = %f secs (%6.3g%%), with %8d calls at %e us per call"
+                                    " (min %.3g, median %.3g, p99 %.3g us)\n",
                    (const char*)&pname[i][0],  global_profile[i].time,
                    100*global_profile[i].time/global_profile[QUDA_PROFILE_TOTAL].time,
-                   global_profile[i].count, 1e6*global_profile[i].time/global_profile[i].count);
+                   global_profile[i].count, 1e6*global_profile[i].time/global_profile[i].count,
+                   1e6*global_profile[i].Min(), 1e6*global_profile[i].Percentile(0.5),
+                   1e6*global_profile[i].Percentile(0.99));
         accounted += global_profile[i].time;
       }
     }
@@ -83,6 +140,8 @@ namespace quda {
                   accounted, "QUDA", global_profile[QUDA_PROFILE_TOTAL].time);
     }
 
+    printfQuda("        timer overhead        = %.3g us per start/stop\n", 1e6*Timer::Overhead());
+
   }
 
 }
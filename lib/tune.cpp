@@ -2,19 +2,28 @@
 #include <comm_quda.h>
 #include <quda.h> // for QUDA_VERSION_STRING
 #include <sys/stat.h> // for stat()
+#include <sys/mman.h> // for mmap()
 #include <fcntl.h>
 #include <cfloat> // for FLT_MAX
 #include <ctime>
 #include <fstream>
 #include <typeinfo>
-#include <map>
 #include <list>
+#include <vector>
+#include <algorithm>
 #include <unistd.h>
 #include <uint_to_char.h>
 
 #include <deque>
 #include <queue>
 #include <functional>
+#include <chrono>
+#include <atomic>
+#include <memory>
+#include <iterator>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #ifdef PTHREADS
 #include <pthread.h>
 #endif
@@ -28,7 +37,7 @@ namespace quda { static TuneKey last_key; }
 quda::TuneKey getLastTuneKey() { return quda::last_key; }
 
 namespace quda {
-  typedef std::map<TuneKey, TuneParam> map;
+  typedef TuneCache map;
 
   struct TraceKey {
 
@@ -92,25 +101,12 @@ namespace quda {
     return enable_trace;
   }
 
-  void postTrace_(const char *func, const char *file, int line) {
-    if (traceEnabled() >= 1) {
-      char aux[TuneKey::aux_n];
-      strcpy(aux,file);
-      strcat(aux,":");
-      char tmp[TuneKey::aux_n];
-      i32toa(tmp,line);
-      strcat(aux,tmp);
-      TuneKey key("", func, aux);
-      TraceKey trace_entry(key, 0.0);
-      trace_list.push_back(trace_entry);
-    }
-  }
-
   static const std::string quda_hash = QUDA_HASH; // defined in lib/Makefile
   static std::string resource_path;
   static map tunecache;
   static map::iterator it;
   static size_t initial_cache_size = 0;
+  static bool binary_cache_stale = false; // set if tunecache.bin is missing or older than tunecache.tsv
 
 #define STR_(x) #x
 #define STR(x) STR_(x)
@@ -121,6 +117,237 @@ namespace quda {
   /** tuning in progress? */
   static bool tuning = false;
 
+  /**
+     The timeline is a bounded ring of events that is filled without
+     locks: each writer claims an index with a fetch_add on the head,
+     takes the slot by moving its sequence number from a published
+     (even) value to 2*index+1, and publishes it with 2*index+2, so
+     concurrent launches from several host threads (or thread ranks)
+     never serialize.  Once full, the oldest events are overwritten.  A
+     writer that finds its slot still held by another writer, or
+     already taken by a later index, drops its event instead of
+     interleaving with it, and readers skip any slot whose sequence
+     number changes while they copy it.  The ring is exported in Chrome
+     trace-event format by saveProfile().
+  */
+  struct TimelineEvent {
+    std::atomic<uint64_t> seq; // 2*index+1 while being written, 2*index+2 once published
+    char name[128];
+    char aux[128];
+    char volume[TuneKey::volume_n];
+    char region[96];
+    const char *category;
+    char phase;      // 'X' for a complete event, 'i' for an instant event
+    bool estimated;  // timing estimated from the tunecache rather than measured
+    int pid;         // rank
+    int tid;         // host thread
+    double ts;       // microseconds since the trace epoch
+    double dur;      // microseconds
+    long long flops;
+    long long bytes;
+  };
+
+  struct Timeline {
+    std::unique_ptr<TimelineEvent[]> events;
+    size_t capacity;
+    std::atomic<uint64_t> head;
+    std::atomic<uint64_t> dropped; // events lost to a slot held by another writer
+    std::chrono::steady_clock::time_point epoch;
+
+    Timeline() : capacity(65536), head(0), dropped(0), epoch(std::chrono::steady_clock::now())
+    {
+      char *size_env = getenv("QUDA_TRACE_BUFFER_SIZE");
+      if (size_env && atol(size_env) > 0) capacity = atol(size_env);
+      events.reset(new TimelineEvent[capacity]);
+      for (size_t i = 0; i < capacity; i++) events[i].seq.store(0, std::memory_order_relaxed);
+    }
+
+    double now() const
+    {
+      return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - epoch).count();
+    }
+  };
+
+  static Timeline &timeline()
+  {
+    static Timeline timeline_;
+    return timeline_;
+  }
+
+  // stack of the TimeProfile regions open on this thread, innermost last
+  static thread_local std::vector<std::string> region_stack;
+
+  static int traceThreadId()
+  {
+    static std::atomic<int> thread_count(0);
+    static thread_local int tid = thread_count++;
+    return tid;
+  }
+
+  static inline void copyString(char *dst, const char *src, size_t n)
+  {
+    strncpy(dst, src, n - 1);
+    dst[n - 1] = '\0';
+  }
+
+  static void recordEvent(const char *category, char phase, const char *name, const char *aux, const char *volume,
+                          double ts, double dur, long long flops, long long bytes, bool estimated = false)
+  {
+    Timeline &tl = timeline();
+    const uint64_t index = tl.head.fetch_add(1, std::memory_order_relaxed);
+    TimelineEvent &event = tl.events[index % tl.capacity];
+
+    uint64_t seq = event.seq.load(std::memory_order_relaxed);
+    do {
+      if ((seq & 1) || seq > 2 * index) { // another writer holds the slot, or a later one has wrapped onto it
+        tl.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+    } while (!event.seq.compare_exchange_weak(seq, 2 * index + 1, std::memory_order_relaxed));
+    std::atomic_thread_fence(std::memory_order_release);
+    copyString(event.name, name, sizeof(event.name));
+    copyString(event.aux, aux, sizeof(event.aux));
+    copyString(event.volume, volume, sizeof(event.volume));
+    copyString(event.region, region_stack.empty() ? "" : region_stack.back().c_str(), sizeof(event.region));
+    event.category = category;
+    event.phase = phase;
+    event.estimated = estimated;
+    event.pid = comm_rank();
+    event.tid = traceThreadId();
+    event.ts = ts;
+    event.dur = dur;
+    event.flops = flops;
+    event.bytes = bytes;
+    event.seq.store(2 * index + 2, std::memory_order_release);
+  }
+
+  void traceRegionBegin_(const std::string &profile, const std::string &region)
+  {
+    region_stack.push_back(profile + ":" + region);
+  }
+
+  void traceRegionEnd_(const std::string &profile, const std::string &region, double seconds)
+  {
+    const std::string name = profile + ":" + region;
+    // regions need not be strictly nested, so remove the innermost match
+    for (auto it = region_stack.rbegin(); it != region_stack.rend(); it++) {
+      if (*it == name) {
+        region_stack.erase(std::next(it).base());
+        break;
+      }
+    }
+    const double end = timeline().now();
+    recordEvent("region", 'X', name.c_str(), "", "", end - 1e6 * seconds, 1e6 * seconds, 0, 0);
+  }
+
+  /**
+     Record a kernel launch on the timeline.  tuneLaunch() returns
+     before the kernel is enqueued and does not see its stream, so no
+     device timing is available: the event starts when the launch is
+     issued from the host and lasts for the tuned kernel time.  It is
+     marked as estimated in the trace, and is placed on the issuing
+     host thread rather than on a stream.
+  */
+  static void traceLaunch(const TuneKey &key, const TuneParam &param, const Tunable &tunable)
+  {
+    recordEvent(tunable.hostKernel() ? "host kernel" : "kernel", 'X', key.name, key.aux, key.volume,
+                timeline().now(), 1e6 * param.time, tunable.launchFlops(), tunable.launchBytes(), true);
+  }
+
+  static void jsonString(std::ostream &out, const char *str)
+  {
+    out << '"';
+    for (const char *c = str; *c; c++) {
+      switch (*c) {
+      case '"': out << "\\\""; break;
+      case '\\': out << "\\\\"; break;
+      case '\n': out << "\\n"; break;
+      case '\t': out << "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(*c) < 0x20) out << ' ';
+        else out << *c;
+      }
+    }
+    out << '"';
+  }
+
+  /**
+   * Serialize the timeline to an ostream in Chrome trace-event JSON,
+   * which can be loaded into chrome://tracing or Perfetto.
+   */
+  static void serializeTimeline(std::ostream &out)
+  {
+    Timeline &tl = timeline();
+    const uint64_t head = tl.head.load(std::memory_order_acquire);
+    const uint64_t first = head > tl.capacity ? head - tl.capacity : 0;
+
+    out << "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"version\":\"" << quda_version << "\",\"hash\":\"" << quda_hash
+        << "\",\"dropped\":" << first + tl.dropped.load(std::memory_order_relaxed)
+        << ",\"kernel_timing\":\"kernel events start at host issue and last for the tuned time\"},\"traceEvents\":[";
+
+    TimelineEvent event;
+    bool comma = false;
+    out << std::setprecision(15);
+    for (uint64_t index = first; index < head; index++) {
+      const TimelineEvent &slot = tl.events[index % tl.capacity];
+      const uint64_t seq = slot.seq.load(std::memory_order_acquire);
+      if (seq != 2 * index + 2) continue; // still being written or already overwritten
+      memcpy(event.name, slot.name, sizeof(event.name));
+      memcpy(event.aux, slot.aux, sizeof(event.aux));
+      memcpy(event.volume, slot.volume, sizeof(event.volume));
+      memcpy(event.region, slot.region, sizeof(event.region));
+      event.category = slot.category;
+      event.phase = slot.phase;
+      event.estimated = slot.estimated;
+      event.pid = slot.pid;
+      event.tid = slot.tid;
+      event.ts = slot.ts;
+      event.dur = slot.dur;
+      event.flops = slot.flops;
+      event.bytes = slot.bytes;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.seq.load(std::memory_order_relaxed) != seq) continue;
+
+      out << (comma ? ",\n" : "\n") << "{\"name\":";
+      jsonString(out, event.name);
+      out << ",\"cat\":\"" << event.category << "\",\"ph\":\"" << event.phase << "\"";
+      out << ",\"ts\":" << event.ts;
+      if (event.phase == 'X') out << ",\"dur\":" << event.dur;
+      else out << ",\"s\":\"t\"";
+      out << ",\"pid\":" << event.pid << ",\"tid\":" << event.tid << ",\"args\":{";
+      out << "\"region\":";
+      jsonString(out, event.region);
+      if (event.aux[0]) {
+        out << ",\"aux\":";
+        jsonString(out, event.aux);
+      }
+      if (event.volume[0]) {
+        out << ",\"volume\":";
+        jsonString(out, event.volume);
+      }
+      if (event.flops || event.bytes) out << ",\"flops\":" << event.flops << ",\"bytes\":" << event.bytes;
+      if (event.estimated) out << ",\"estimated\":true";
+      out << "}}";
+      comma = true;
+    }
+    out << "\n]}" << std::endl;
+  }
+
+  void postTrace_(const char *func, const char *file, int line) {
+    if (traceEnabled() >= 1) {
+      char aux[TuneKey::aux_n];
+      strcpy(aux,file);
+      strcat(aux,":");
+      char tmp[TuneKey::aux_n];
+      i32toa(tmp,line);
+      strcat(aux,tmp);
+      TuneKey key("", func, aux);
+      TraceKey trace_entry(key, 0.0);
+      trace_list.push_back(trace_entry);
+      recordEvent("posted", 'i', func, aux, "", timeline().now(), 0.0, 0, 0);
+    }
+  }
+
   bool activeTuning() { return tuning; }
 
   static bool profile_count = true;
@@ -139,7 +366,6 @@ namespace quda {
     std::string line;
     std::stringstream ls;
 
-    TuneKey key;
     TuneParam param;
 
     std::string v;
@@ -153,6 +379,7 @@ namespace quda {
       if (!line.length()) continue; // skip blank lines (e.g., at end of file)
       ls.clear();
       ls.str(line);
+      TuneKey key;
       ls >> v >> n >> a >> param.block.x >> param.block.y >> param.block.z;
       check = snprintf(key.volume, key.volume_n, "%s", v.c_str());
       if (check < 0 || check >= key.volume_n) errorQuda("Error writing volume string (check = %d)", check);
@@ -174,11 +401,16 @@ namespace quda {
    */
   static void serializeTuneCache(std::ostream &out)
   {
-    map::iterator entry;
+    // the cache is unordered, so sort the entries to keep the export stable
+    std::vector<const map::value_type*> entries;
+    entries.reserve(tunecache.size());
+    for (const auto &entry : tunecache) entries.push_back(&entry);
+    std::sort(entries.begin(), entries.end(),
+              [](const map::value_type *a, const map::value_type *b) { return a->first < b->first; });
 
-    for (entry = tunecache.begin(); entry != tunecache.end(); entry++) {
-      TuneKey key = entry->first;
-      TuneParam param = entry->second;
+    for (auto entry : entries) {
+      const TuneKey &key = entry->first;
+      const TuneParam &param = entry->second;
 
       out << std::setw(16) << key.volume << "\t" << key.name << "\t" << key.aux << "\t";
       out << param.block.x << "\t" << param.block.y << "\t" << param.block.z << "\t";
@@ -189,6 +421,173 @@ namespace quda {
   }
 
 
+  /**
+   * Binary tunecache layout: a header followed by the identity string
+   * (the same fields as the first line of tunecache.tsv), then one
+   * fixed-size record per entry with its strings appended.  The
+   * identity string and every record are padded to 8 bytes so the file
+   * can be walked in place once mapped.  Values are stored in native
+   * byte order.
+   */
+  static const char binary_magic[8] = {'Q', 'U', 'D', 'A', 'T', 'U', 'N', 'E'};
+  static const uint32_t binary_format = 1;
+
+  struct BinaryHeader {
+    char magic[8];
+    uint32_t format;
+    uint32_t id_n;
+    uint64_t n_entry;
+  };
+
+  struct BinaryRecord {
+    uint64_t hash;
+    uint16_t volume_n;
+    uint16_t name_n;
+    uint16_t aux_n;
+    uint16_t comment_n;
+    int32_t block[3];
+    int32_t grid[3];
+    int32_t shared_bytes;
+    int32_t aux[4];
+    float time;
+  };
+
+  static_assert(sizeof(BinaryHeader) == 24 && sizeof(BinaryRecord) == 64, "Unexpected padding in binary tunecache layout");
+
+  static inline size_t pad8(size_t n) { return (n + 7) & ~static_cast<size_t>(7); }
+
+  static std::string cacheIdentity()
+  {
+    std::string id = "tunecache\t" + quda_version;
+#ifdef GITVERSION
+    id += std::string("\t") + gitversion;
+#else
+    id += "\t" + quda_version;
+#endif
+    id += "\t" + quda_hash;
+    return id;
+  }
+
+  static void appendBinaryEntry(std::string &out, const TuneKey &key, const TuneParam &param)
+  {
+    BinaryRecord rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.hash = key.hash();
+    rec.volume_n = strlen(key.volume);
+    rec.name_n = strlen(key.name);
+    rec.aux_n = strlen(key.aux);
+    rec.comment_n = param.comment.length();
+    rec.block[0] = param.block.x; rec.block[1] = param.block.y; rec.block[2] = param.block.z;
+    rec.grid[0] = param.grid.x; rec.grid[1] = param.grid.y; rec.grid[2] = param.grid.z;
+    rec.shared_bytes = param.shared_bytes;
+    rec.aux[0] = param.aux.x; rec.aux[1] = param.aux.y; rec.aux[2] = param.aux.z; rec.aux[3] = param.aux.w;
+    rec.time = param.time;
+
+    out.append(reinterpret_cast<const char*>(&rec), sizeof(rec));
+    out.append(key.volume, rec.volume_n);
+    out.append(key.name, rec.name_n);
+    out.append(key.aux, rec.aux_n);
+    out.append(param.comment);
+    out.resize(pad8(out.size()), '\0');
+  }
+
+  /**
+   * Serialize tunecache to a binary buffer.  If key is non-null only
+   * that entry is included (if present).
+   */
+  static void serializeTuneCacheBinary(std::string &out, const TuneKey *key = nullptr)
+  {
+    const std::string id = cacheIdentity();
+    map::const_iterator single = key ? tunecache.find(*key) : tunecache.end();
+
+    BinaryHeader header;
+    memcpy(header.magic, binary_magic, sizeof(binary_magic));
+    header.format = binary_format;
+    header.id_n = id.length();
+    header.n_entry = key ? (single != tunecache.end() ? 1 : 0) : tunecache.size();
+
+    out.clear();
+    out.reserve(sizeof(header) + pad8(id.length()) + header.n_entry * (sizeof(BinaryRecord) + 128));
+    out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.append(id);
+    out.resize(pad8(out.size()), '\0');
+
+    if (key) {
+      if (single != tunecache.end()) appendBinaryEntry(out, single->first, single->second);
+    } else {
+      for (const auto &entry : tunecache) appendBinaryEntry(out, entry.first, entry.second);
+    }
+  }
+
+  /**
+   * Deserialize a binary tunecache buffer, e.g., a mapped tunecache.bin
+   * or a buffer received from another node.
+   */
+  static void deserializeTuneCacheBinary(const char *in, size_t size, const char *source)
+  {
+    BinaryHeader header;
+    if (size < sizeof(header)) errorQuda("Bad format in %s", source);
+    memcpy(&header, in, sizeof(header));
+    if (memcmp(header.magic, binary_magic, sizeof(binary_magic)) || header.format != binary_format)
+      errorQuda("Bad format in %s", source);
+
+    size_t offset = sizeof(header);
+    const std::string id = cacheIdentity();
+    if (offset + header.id_n > size) errorQuda("Bad format in %s", source);
+    if (id.compare(0, std::string::npos, in + offset, header.id_n))
+      errorQuda("Cache file %s does not match current QUDA build. \nPlease delete this file or set the QUDA_RESOURCE_PATH environment variable to point to a new path.", source);
+    offset = pad8(offset + header.id_n);
+
+    TuneParam param;
+    for (uint64_t i = 0; i < header.n_entry; i++) {
+      BinaryRecord rec;
+      if (offset + sizeof(rec) > size) errorQuda("Bad format in %s", source);
+      memcpy(&rec, in + offset, sizeof(rec));
+      offset += sizeof(rec);
+
+      if (rec.volume_n >= TuneKey::volume_n || rec.name_n >= TuneKey::name_n || rec.aux_n >= TuneKey::aux_n ||
+          offset + rec.volume_n + rec.name_n + rec.aux_n + rec.comment_n > size)
+        errorQuda("Bad format in %s", source);
+
+      TuneKey key;
+      memcpy(key.volume, in + offset, rec.volume_n); key.volume[rec.volume_n] = '\0'; offset += rec.volume_n;
+      memcpy(key.name, in + offset, rec.name_n); key.name[rec.name_n] = '\0'; offset += rec.name_n;
+      memcpy(key.aux, in + offset, rec.aux_n); key.aux[rec.aux_n] = '\0'; offset += rec.aux_n;
+      param.comment.assign(in + offset, rec.comment_n);
+      offset = pad8(offset + rec.comment_n);
+
+      // the stored hash guards against a change of hash function as well as corruption
+      if (key.hash() != rec.hash) errorQuda("Bad format in %s", source);
+
+      param.block = dim3(rec.block[0], rec.block[1], rec.block[2]);
+      param.grid = dim3(rec.grid[0], rec.grid[1], rec.grid[2]);
+      param.shared_bytes = rec.shared_bytes;
+      param.aux = make_int4(rec.aux[0], rec.aux[1], rec.aux[2], rec.aux[3]);
+      param.time = rec.time;
+      tunecache[key] = param;
+    }
+  }
+
+  /**
+   * Read a binary tunecache file by mapping it into memory.
+   */
+  static void loadTuneCacheBinary(const std::string &path)
+  {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1) errorQuda("Unable to open %s", path.c_str());
+    struct stat fstat_;
+    if (fstat(fd, &fstat_)) errorQuda("Unable to stat %s", path.c_str());
+    size_t size = fstat_.st_size;
+
+    void *in = size > 0 ? mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+    if (in == MAP_FAILED) errorQuda("Unable to map %s", path.c_str());
+    close(fd);
+
+    tunecache.reserve(tunecache.size() + size / sizeof(BinaryRecord));
+    deserializeTuneCacheBinary(static_cast<const char*>(in), size, path.c_str());
+    munmap(in, size);
+  }
+
   template <class T>
   struct less_significant : std::binary_function<T,T,bool> {
     inline bool operator()(const T &lhs, const T &rhs) {
@@ -196,6 +595,131 @@ namespace quda {
     }
   };
 
+  /**
+     Record the work done by one launch of a kernel in its cache entry,
+     for the profile and roofline.
+  */
+  static inline void recordWork(TuneParam &param, const Tunable &tunable)
+  {
+    param.flops = tunable.launchFlops();
+    param.bytes = tunable.launchBytes();
+    param.host = tunable.hostKernel();
+  }
+
+  /**
+     @return Peak memory bandwidth in GB/s, measured once with a
+     STREAM-like probe: a device-to-device copy for device kernels and
+     an OpenMP triad for host kernels.  The best of several repetitions
+     is taken.  QUDA_PEAK_BANDWIDTH and QUDA_PEAK_HOST_BANDWIDTH (GB/s)
+     override the measurement.
+  */
+  static double peakBandwidth(bool host)
+  {
+    static double peak[2] = {-1.0, -1.0};
+    double &bw = peak[host ? 1 : 0];
+    if (bw >= 0.0) return bw;
+
+    char *peak_env = getenv(host ? "QUDA_PEAK_HOST_BANDWIDTH" : "QUDA_PEAK_BANDWIDTH");
+    if (peak_env && atof(peak_env) > 0.0) {
+      bw = atof(peak_env);
+      return bw;
+    }
+
+    const int n_rep = 5;
+    if (!host) {
+      // stay well within free memory since this may run mid-job from saveProfile
+      size_t free_bytes, total_bytes;
+      cudaMemGetInfo(&free_bytes, &total_bytes);
+      const size_t size = std::min(static_cast<size_t>(256) << 20, (free_bytes / 8) & ~static_cast<size_t>(4095));
+      if (size < (16 << 20)) {
+        warningQuda("Insufficient free device memory to measure the peak bandwidth");
+        bw = 0.0;
+        return bw;
+      }
+      void *a = device_malloc(size);
+      void *b = device_malloc(size);
+      cudaMemset(a, 0, size);
+
+      cudaEvent_t start, end;
+      cudaEventCreate(&start);
+      cudaEventCreate(&end);
+      float best_time = FLT_MAX;
+      for (int rep = 0; rep <= n_rep; rep++) {
+        float elapsed_time;
+        cudaEventRecord(start, 0);
+        cudaMemcpyAsync(b, a, size, cudaMemcpyDeviceToDevice, 0);
+        cudaEventRecord(end, 0);
+        cudaEventSynchronize(end);
+        cudaEventElapsedTime(&elapsed_time, start, end);
+        if (rep > 0 && elapsed_time < best_time) best_time = elapsed_time; // first copy is a warm up
+      }
+      cudaEventDestroy(start);
+      cudaEventDestroy(end);
+      device_free(b);
+      device_free(a);
+
+      bw = 2.0 * size / (1e6 * best_time); // read + write, time in ms
+    } else {
+      const long n = 1 << 23; // 64 MiB per array, beyond the last-level cache
+      double *a = static_cast<double*>(safe_malloc(n * sizeof(double)));
+      double *b = static_cast<double*>(safe_malloc(n * sizeof(double)));
+      double *c = static_cast<double*>(safe_malloc(n * sizeof(double)));
+
+#pragma omp parallel for
+      for (long i = 0; i < n; i++) { a[i] = 0.0; b[i] = 1.0; c[i] = 2.0; }
+
+      double best_time = DBL_MAX;
+      for (int rep = 0; rep < n_rep; rep++) {
+        auto start = std::chrono::steady_clock::now();
+#pragma omp parallel for
+        for (long i = 0; i < n; i++) a[i] = b[i] + 3.0 * c[i];
+        double elapsed_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (elapsed_time < best_time) best_time = elapsed_time;
+      }
+      host_free(c);
+      host_free(b);
+      host_free(a);
+
+      bw = 3.0 * n * sizeof(double) / (1e9 * best_time);
+    }
+
+    if (getVerbosity() >= QUDA_VERBOSE)
+      printfQuda("Measured peak %s bandwidth %.1f GB/s\n", host ? "host" : "device", bw);
+    return bw;
+  }
+
+  /**
+     Achieved throughput of a profile entry against the roofline given
+     by the peak bandwidth and, if QUDA_PEAK_GFLOPS is set, the peak
+     flop rate.
+  */
+  struct Roofline {
+    double gflops;    // achieved Gflop/s
+    double gbytes;    // achieved GB/s
+    double intensity; // flop / byte
+    double attainable; // roofline Gflop/s at this intensity
+    double percent;   // percentage of the roofline achieved
+    bool memory_bound;
+
+    Roofline(const TuneParam &param)
+    {
+      // untimed entries (e.g., never tuned) have no throughput
+      const double time = param.time;
+      gflops = time > 0.0 ? param.flops / (1e9 * time) : 0.0;
+      gbytes = time > 0.0 ? param.bytes / (1e9 * time) : 0.0;
+      intensity = param.bytes > 0 ? static_cast<double>(param.flops) / param.bytes : 0.0;
+
+      static const char *peak_env = getenv("QUDA_PEAK_GFLOPS");
+      const double peak_gflops = peak_env && !param.host ? atof(peak_env) : 0.0;
+      const double bw = peakBandwidth(param.host);
+
+      memory_bound = !(peak_gflops > 0.0 && intensity * bw > peak_gflops);
+      attainable = memory_bound ? intensity * bw : peak_gflops;
+      // kernels without flops are measured against the bandwidth alone
+      percent = param.flops > 0 && attainable > 0.0 ? 100.0 * gflops / attainable : (bw > 0.0 ? 100.0 * gbytes / bw : 0.0);
+    }
+  };
+
   /**
    * Serialize tunecache to an ostream, useful for writing to a file or sending to other nodes.
    */
@@ -237,8 +761,12 @@ namespace quda {
       if (param.n_calls > 0 && !is_policy) {
 	double time = param.n_calls * param.time;
 
+	Roofline roofline(param);
+
 	out << std::setw(12) << param.n_calls * param.time << "\t" << std::setw(12) << (time / total_time) * 100 << "\t";
-	out << std::setw(12) << param.n_calls << "\t" << std::setw(12) << param.time << "\t" << std::setw(16) << key.volume << "\t";
+	out << std::setw(12) << param.n_calls << "\t" << std::setw(12) << param.time << "\t";
+	out << std::setw(12) << roofline.gflops << "\t" << std::setw(12) << roofline.gbytes << "\t";
+	out << std::setw(12) << roofline.intensity << "\t" << std::setw(12) << roofline.percent << "\t" << std::setw(16) << key.volume << "\t";
 	out << key.name << "\t" << key.aux << "\t" << param.comment; // param.comment ends with a newline
       }
 
@@ -288,30 +816,94 @@ namespace quda {
 
 
   /**
-   * Distribute the tunecache from node 0 to all other nodes.
+   * Write the first line shared by the profile files: label, version,
+   * git version, hash and the time of writing (ctime ends in a newline).
+   */
+  static void serializeHeader(std::ostream &out, const std::string &label, const time_t &now)
+  {
+    out << label << "\t" << quda_version;
+#ifdef GITVERSION
+    out << "\t" << gitversion;
+#else
+    out << "\t" << quda_version;
+#endif
+    out << "\t" << quda_hash << "\t# Last updated " << ctime(&now);
+  }
+
+  /**
+   * Serialize the roofline of each profiled kernel to an ostream, in
+   * decreasing order of significance and leaving out policies and
+   * kernels with no recorded time.
+   * @return The number of kernels written
+   */
+  static int serializeRoofline(std::ostream &out)
+  {
+    out << "# peak device bandwidth = " << peakBandwidth(false) << " GB/s" << std::endl;
+    out << "# peak host bandwidth = " << peakBandwidth(true) << " GB/s" << std::endl;
+    char *peak_env = getenv("QUDA_PEAK_GFLOPS");
+    if (peak_env) out << "# peak device flops = " << peak_env << " Gflop/s" << std::endl;
+    out << std::endl;
+
+    out << std::setw(12) << "total time" << "\t" << std::setw(12) << "calls" << "\t" << std::setw(12) << "time / call" << "\t";
+    out << std::setw(12) << "Gflop/s" << "\t" << std::setw(12) << "GB/s" << "\t" << std::setw(12) << "flop/byte" << "\t";
+    out << std::setw(12) << "roofline" << "\t" << std::setw(12) << "% roofline" << "\t" << std::setw(8) << "bound" << "\t";
+    out << std::setw(8) << "where" << "\t" << std::setw(16) << "volume" << "\tname\taux" << std::endl;
+
+    typedef std::pair<TuneKey, TuneParam> profile_t;
+    typedef std::priority_queue<profile_t, std::deque<profile_t>, less_significant<profile_t> > queue_t;
+    queue_t q(tunecache.begin(), tunecache.end());
+
+    int n_entry = 0;
+    while (!q.empty()) {
+      const TuneKey &key = q.top().first;
+      const TuneParam &param = q.top().second;
+
+      char tmp[14] = { };
+      strncpy(tmp, key.aux, 13);
+      bool is_policy_kernel = strncmp(tmp, "policy_kernel", 13) == 0 ? true : false;
+      bool is_policy = (strncmp(tmp, "policy", 6) == 0 && !is_policy_kernel) ? true : false;
+
+      if (param.n_calls > 0 && param.time > 0.0 && !is_policy) {
+        Roofline roofline(param);
+        out << std::setw(12) << param.n_calls * param.time << "\t" << std::setw(12) << param.n_calls << "\t";
+        out << std::setw(12) << param.time << "\t" << std::setw(12) << roofline.gflops << "\t";
+        out << std::setw(12) << roofline.gbytes << "\t" << std::setw(12) << roofline.intensity << "\t";
+        out << std::setw(12) << roofline.attainable << "\t" << std::setw(12) << roofline.percent << "\t";
+        out << std::setw(8) << (roofline.memory_bound ? "memory" : "compute") << "\t";
+        out << std::setw(8) << (param.host ? "host" : "device") << "\t" << std::setw(16) << key.volume << "\t";
+        out << key.name << "\t" << key.aux << std::endl;
+        n_entry++;
+      }
+      q.pop();
+    }
+    return n_entry;
+  }
+
+
+  /**
+   * Distribute the tunecache from node 0 to all other nodes.  If key
+   * is non-null only that entry is distributed.
    */
-  static void broadcastTuneCache()
+  static void broadcastTuneCache(const TuneKey *key = nullptr)
   {
 #ifdef MULTI_GPU
 
-    std::stringstream serialized;
+    std::string serialized;
     size_t size;
 
     if (comm_rank() == 0) {
-      serializeTuneCache(serialized);
-      size = serialized.str().length();
+      serializeTuneCacheBinary(serialized, key);
+      size = serialized.length();
     }
     comm_broadcast(&size, sizeof(size_t));
 
     if (size > 0) {
       if (comm_rank() == 0) {
-	comm_broadcast(const_cast<char *>(serialized.str().c_str()), size);
+	comm_broadcast(const_cast<char *>(serialized.data()), size);
       } else {
-	char *serstr = new char[size+1];
+	char *serstr = new char[size];
 	comm_broadcast(serstr, size);
-	serstr[size] ='\0'; // null-terminate
-	serialized.str(serstr);
-	deserializeTuneCache(serialized);
+	deserializeTuneCacheBinary(serstr, size, "broadcast tunecache");
 	delete[] serstr;
       }
     }
@@ -355,9 +947,25 @@ namespace quda {
 
       cache_path = resource_path;
       cache_path += "/tunecache.tsv";
-      cache_file.open(cache_path.c_str());
+      std::string binary_path = resource_path + "/tunecache.bin";
+
+      // prefer the binary cache, unless the text export has been modified since it was written
+      struct stat binary_stat, text_stat;
+      bool have_binary = !stat(binary_path.c_str(), &binary_stat);
+      bool have_text = !stat(cache_path.c_str(), &text_stat);
+
+      if (have_binary && (!have_text || text_stat.st_mtime <= binary_stat.st_mtime)) {
+
+        loadTuneCacheBinary(binary_path);
+	initial_cache_size = tunecache.size();
+
+	if (getVerbosity() >= QUDA_SUMMARIZE) {
+	  printfQuda("Loaded %d sets of cached parameters from %s\n", static_cast<int>(initial_cache_size), binary_path.c_str());
+	}
 
-      if (cache_file) {
+      } else if (have_text) {
+
+        cache_file.open(cache_path.c_str());
 
 	if (!cache_file.good()) errorQuda("Bad format in %s", cache_path.c_str());
 	getline(cache_file, line);
@@ -386,6 +994,7 @@ namespace quda {
 
 	cache_file.close();
 	initial_cache_size = tunecache.size();
+	binary_cache_stale = true;
 
 	if (getVerbosity() >= QUDA_SUMMARIZE) {
 	  printfQuda("Loaded %d sets of cached parameters from %s\n", static_cast<int>(initial_cache_size), cache_path.c_str());
@@ -425,7 +1034,7 @@ namespace quda {
     if (comm_rank() == 0) {
 #endif
 
-      if (tunecache.size() == initial_cache_size && !error) return;
+      if (tunecache.size() == initial_cache_size && !binary_cache_stale && !error) return;
 
       // Acquire lock.  Note that this is only robust if the filesystem supports flock() semantics, which is true for
       // NFS on recent versions of linux but not Lustre by default (unless the filesystem was mounted with "-o flock").
@@ -461,6 +1070,18 @@ namespace quda {
       serializeTuneCache(cache_file);
       cache_file.close();
 
+      // the binary cache is written after the text export so that it is never older than it
+      if (!error) {
+        std::string binary_path = resource_path + "/tunecache.bin";
+        std::string serialized;
+        serializeTuneCacheBinary(serialized);
+        std::ofstream binary_file(binary_path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        binary_file.write(serialized.data(), serialized.length());
+        binary_file.close();
+        if (binary_file.fail()) warningQuda("Unable to write %s", binary_path.c_str());
+        else binary_cache_stale = false;
+      }
+
       // Release lock.
       close(lock_handle);
       remove(lock_path.c_str());
@@ -500,8 +1121,8 @@ namespace quda {
   {
     time_t now;
     int lock_handle;
-    std::string lock_path, profile_path, async_profile_path, trace_path;
-    std::ofstream profile_file, async_profile_file, trace_file;
+    std::string lock_path, profile_path, async_profile_path, trace_path, timeline_path, roofline_path;
+    std::ofstream profile_file, async_profile_file, trace_file, timeline_file, roofline_file;
 
     if (resource_path.empty()) return;
 
@@ -534,17 +1155,22 @@ namespace quda {
 	profile_path = resource_path + "/profile_" + std::to_string(count) + ".tsv";
 	async_profile_path = resource_path + "/profile_async_" + std::to_string(count) + ".tsv";
         if (traceEnabled()) trace_path = resource_path + "/trace_" + std::to_string(count) + ".tsv";
+        if (traceEnabled()) timeline_path = resource_path + "/trace_" + std::to_string(count) + ".json";
       } else {
 	profile_path = resource_path + "/" + profile_fname + "_" + std::to_string(count) + ".tsv";
 	async_profile_path = resource_path + "/" + profile_fname + "_" + std::to_string(count) + "_async.tsv";
 	if (traceEnabled()) trace_path = resource_path + "/" + profile_fname + "_trace_" + std::to_string(count) + ".tsv";
+	if (traceEnabled()) timeline_path = resource_path + "/" + profile_fname + "_trace_" + std::to_string(count) + ".json";
       }
+      // the roofline is cumulative, so each save replaces the last one
+      roofline_path = resource_path + "/" + (profile_fname ? std::string(profile_fname) + "_" : std::string()) + "roofline.tsv";
 
       count++;
 
       profile_file.open(profile_path.c_str());
       async_profile_file.open(async_profile_path.c_str());
       if (traceEnabled()) trace_file.open(trace_path.c_str());
+      if (traceEnabled()) timeline_file.open(timeline_path.c_str());
 
       if (getVerbosity() >= QUDA_SUMMARIZE) {
 	// compute number of non-zero entries that will be output in the profile
@@ -563,28 +1189,21 @@ namespace quda {
 	printfQuda("Saving %d sets of cached parameters to %s\n", n_entry, profile_path.c_str());
 	printfQuda("Saving %d sets of cached profiles to %s\n", n_policy, async_profile_path.c_str());
 	if (traceEnabled()) printfQuda("Saving trace list with %lu entries to %s\n", trace_list.size(), trace_path.c_str());
+	if (traceEnabled()) printfQuda("Saving trace timeline to %s\n", timeline_path.c_str());
       }
 
       time(&now);
 
       std::string Label = label.empty() ? "profile" : label;
 
-      profile_file << Label << "\t" << quda_version;
-#ifdef GITVERSION
-      profile_file << "\t" << gitversion;
-#else
-      profile_file << "\t" << quda_version;
-#endif
-      profile_file << "\t" << quda_hash << "\t# Last updated " << ctime(&now) << std::endl;
-      profile_file << std::setw(12) << "total time" << "\t" << std::setw(12) << "percentage" << "\t" << std::setw(12) << "calls" << "\t" << std::setw(12) << "time / call" << "\t" << std::setw(16) << "volume" << "\tname\taux\tcomment" << std::endl;
+      serializeHeader(profile_file, Label, now);
+      profile_file << std::endl;
+      profile_file << std::setw(12) << "total time" << "\t" << std::setw(12) << "percentage" << "\t" << std::setw(12) << "calls" << "\t" << std::setw(12) << "time / call" << "\t";
+      profile_file << std::setw(12) << "Gflop/s" << "\t" << std::setw(12) << "GB/s" << "\t" << std::setw(12) << "flop/byte" << "\t" << std::setw(12) << "% roofline" << "\t";
+      profile_file << std::setw(16) << "volume" << "\tname\taux\tcomment" << std::endl;
 
-      async_profile_file << Label << "\t" << quda_version;
-#ifdef GITVERSION
-      async_profile_file << "\t" << gitversion;
-#else
-      async_profile_file << "\t" << quda_version;
-#endif
-      async_profile_file << "\t" << quda_hash << "\t# Last updated " << ctime(&now) << std::endl;
+      serializeHeader(async_profile_file, Label, now);
+      async_profile_file << std::endl;
       async_profile_file << std::setw(12) << "total time" << "\t" << std::setw(12) << "percentage" << "\t" << std::setw(12) << "calls" << "\t" << std::setw(12) << "time / call" << "\t" << std::setw(16) << "volume" << "\tname\taux\tcomment" << std::endl;
 
       serializeProfile(profile_file, async_profile_file);
@@ -593,13 +1212,8 @@ namespace quda {
       async_profile_file.close();
 
       if (traceEnabled()) {
-        trace_file << "trace" << "\t" << quda_version;
-#ifdef GITVERSION
-        trace_file << "\t" << gitversion;
-#else
-        trace_file << "\t" << quda_version;
-#endif
-        trace_file << "\t" << quda_hash << "\t# Last updated " << ctime(&now) << std::endl;
+        serializeHeader(trace_file, "trace", now);
+        trace_file << std::endl;
 
         trace_file << std::setw(12) << "time\t" << std::setw(12) << "device-mem\t" << std::setw(12) << "pinned-mem\t";
         trace_file << std::setw(12) << "mapped-mem\t" << std::setw(12) << "host-mem\t";
@@ -608,8 +1222,17 @@ namespace quda {
         serializeTrace(trace_file);
 
         trace_file.close();
+
+        serializeTimeline(timeline_file);
+        timeline_file.close();
       }
 
+      roofline_file.open(roofline_path.c_str());
+      serializeHeader(roofline_file, "roofline", now);
+      int n_roofline = serializeRoofline(roofline_file);
+      roofline_file.close();
+      if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("Saving roofline of %d kernels to %s\n", n_roofline, roofline_path.c_str());
+
       // Release lock.
       close(lock_handle);
       remove(lock_path.c_str());
@@ -619,6 +1242,42 @@ namespace quda {
 #endif
   }
 
+  int hostThreads()
+  {
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+  }
+
+  HostLaunch::HostLaunch(const TuneParam &param) : threads(1), kind(0), chunk(0)
+  {
+#ifdef _OPENMP
+    omp_sched_t kind_;
+    omp_get_schedule(&kind_, &chunk);
+    kind = static_cast<int>(kind_);
+    threads = omp_get_max_threads();
+
+    omp_set_num_threads(param.block.x);
+    if (param.block.y) omp_set_schedule(omp_sched_dynamic, param.block.y);
+    else omp_set_schedule(omp_sched_static, 0);
+#endif
+  }
+
+  HostLaunch::~HostLaunch()
+  {
+#ifdef _OPENMP
+    omp_set_num_threads(threads);
+    omp_set_schedule(static_cast<omp_sched_t>(kind), chunk);
+#endif
+  }
+
+  static inline std::string launchString(const Tunable &tunable, const TuneParam &param)
+  {
+    return tunable.hostKernel() ? tunable.hostParamString(param) : tunable.paramString(param);
+  }
+
   static TimeProfile launchTimer("tuneLaunch");
 
 //  static int tally = 0;
@@ -663,7 +1322,7 @@ namespace quda {
 
       if (verbosity >= QUDA_DEBUG_VERBOSE) {
         printfQuda("Launching %s with %s at vol=%s with %s\n",
-                   key.name, key.aux, key.volume, tunable.paramString(param).c_str());
+                   key.name, key.aux, key.volume, launchString(tunable, param).c_str());
       }
 
 #ifdef LAUNCH_TIMER
@@ -671,7 +1330,7 @@ namespace quda {
       launchTimer.TPSTART(QUDA_PROFILE_EPILOGUE);
 #endif
 
-      tunable.checkLaunchParam(param);
+      if (!tunable.hostKernel()) tunable.checkLaunchParam(param);
 
 #ifdef PTHREADS
       //pthread_mutex_unlock(&pthread_mutex);
@@ -679,7 +1338,10 @@ namespace quda {
       //printfQuda("pthread_mutex_unlock a complete %d\n",tally);
 #endif
       // we could be tuning outside of the current scope
-      if (!tuning && profile_count) param.n_calls++;
+      if (!tuning && profile_count) {
+        // the work per launch is only queried on the first call of each profile
+        if (param.n_calls++ == 0) recordWork(param, tunable);
+      }
 
 #ifdef LAUNCH_TIMER
       launchTimer.TPSTOP(QUDA_PROFILE_EPILOGUE);
@@ -689,6 +1351,7 @@ namespace quda {
       if (traceEnabled() >= 2) {
         TraceKey trace_entry(key, param.time);
         trace_list.push_back(trace_entry);
+        traceLaunch(key, param, tunable);
       }
 
       return param;
@@ -700,12 +1363,16 @@ namespace quda {
 #endif
 
     if (enabled == QUDA_TUNE_NO) {
-      tunable.defaultTuneParam(param);
-      tunable.checkLaunchParam(param);
+      if (tunable.hostKernel()) {
+        tunable.defaultHostTuneParam(param);
+      } else {
+        tunable.defaultTuneParam(param);
+        tunable.checkLaunchParam(param);
+      }
 
       if (verbosity >= QUDA_DEBUG_VERBOSE) {
         printfQuda("Launching %s with %s at vol=%s with %s (untuned)\n",
-                   key.name, key.aux, key.volume, tunable.paramString(param).c_str());
+                   key.name, key.aux, key.volume, launchString(tunable, param).c_str());
       }
     } else if (!tuning) {
 
@@ -736,7 +1403,28 @@ namespace quda {
         Timer tune_timer;
         tune_timer.Start(__func__, __FILE__, __LINE__);
 
-        tunable.initTuneParam(param);
+        if (tunable.hostKernel()) tunable.initHostTuneParam(param);
+        else tunable.initTuneParam(param);
+
+	// host kernels execute synchronously so are timed directly
+	while (tuning && tunable.hostKernel()) {
+	  tunable.apply(0); // initial call to warm up the caches and the thread pool for this thread count
+	  auto host_start = std::chrono::steady_clock::now();
+	  for (int i=0; i<tunable.tuningIter(); i++) {
+	    tunable.apply(0);  // calls tuneLaunch() again, which simply returns the currently active param
+	  }
+	  elapsed_time = std::chrono::duration<float>(std::chrono::steady_clock::now() - host_start).count() / tunable.tuningIter();
+
+	  if (elapsed_time < best_time) {
+	    best_time = elapsed_time;
+	    best_param = param;
+	  }
+	  if (verbosity >= QUDA_DEBUG_VERBOSE) {
+	    printfQuda("    %s gives %s\n", tunable.hostParamString(param).c_str(), tunable.perfString(elapsed_time).c_str());
+	  }
+	  tuning = tunable.advanceHostTuneParam(param);
+	}
+
 	while (tuning) {
 	  cudaDeviceSynchronize();
 	  cudaGetLastError(); // clear error counter
@@ -797,7 +1485,7 @@ namespace quda {
 	  errorQuda("Auto-tuning failed for %s with %s at vol=%s", key.name, key.aux, key.volume);
 	}
 	if (verbosity >= QUDA_VERBOSE) {
-	  printfQuda("Tuned %s giving %s for %s with %s\n", tunable.paramString(best_param).c_str(),
+	  printfQuda("Tuned %s giving %s for %s with %s\n", launchString(tunable, best_param).c_str(),
 		     tunable.perfString(best_time).c_str(), key.name, key.aux);
 	}
 	time(&now);
@@ -815,17 +1503,20 @@ namespace quda {
 	tunecache[key] = best_param;
 
       }
-      if (commGlobalReduction() || policyTuning()) broadcastTuneCache();
+      // only the newly tuned entry needs to be distributed
+      if (commGlobalReduction() || policyTuning()) broadcastTuneCache(&key);
 
       // check this process is getting the key that is expected
       if (tunecache.find(key) == tunecache.end()) {
 	errorQuda("Failed to find key entry (%s:%s:%s)", key.name, key.volume, key.aux);
       }
+      recordWork(tunecache[key], tunable);
       param = tunecache[key]; // read this now for all processes
 
       if (traceEnabled() >= 2) {
         TraceKey trace_entry(key, param.time);
         trace_list.push_back(trace_entry);
+        traceLaunch(key, param, tunable);
       }
 
     } else if (&tunable != active_tunable) {
@@ -3,6 +3,9 @@
 #include <cstring>
 #include <stack>
 #include <sys/time.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include <enum_quda.h>
 #include <util_quda.h>
@@ -15,7 +18,7 @@ static char prefix_[MAX_PREFIX_SIZE] = "";
 static FILE *outfile_ = stdout;
 
 static const int MAX_BUFFER_SIZE = 1000;
-static char buffer_[MAX_BUFFER_SIZE] = "";
+static COMM_RANK_LOCAL char buffer_[MAX_BUFFER_SIZE] = "";
 
 QudaVerbosity getVerbosity() { return verbosity_; }
 char *getOutputPrefix() { return prefix_; }
@@ -27,8 +30,8 @@ void setVerbosity(QudaVerbosity verbosity)
 }
 
 bool getRankVerbosity() {
-  static bool init = false;
-  static bool rank_verbosity = false;
+  static COMM_RANK_LOCAL bool init = false;
+  static COMM_RANK_LOCAL bool rank_verbosity = false;
   static char *rank_verbosity_env = getenv("QUDA_RANK_VERBOSITY");
 
   if (!init && rank_verbosity_env) { // set the policies to tune for explicitly
@@ -48,21 +51,27 @@ bool getRankVerbosity() {
 }
 
 // default has autotuning enabled but can be overridden with the QUDA_ENABLE_TUNING environment variable
-QudaTune getTuning() {
-  static bool init = false;
-  static QudaTune tune = QUDA_TUNE_YES;
+static bool tune_init = false;
+static QudaTune tune_ = QUDA_TUNE_YES;
 
-  if (!init) {
+QudaTune getTuning() {
+  if (!tune_init) {
     char *enable_tuning = getenv("QUDA_ENABLE_TUNING");
     if (!enable_tuning || strcmp(enable_tuning,"0")!=0) {
-      tune = QUDA_TUNE_YES;
+      tune_ = QUDA_TUNE_YES;
     } else {
-      tune = QUDA_TUNE_NO;
+      tune_ = QUDA_TUNE_NO;
     }
-    init = true;
+    tune_init = true;
   }
 
-  return tune;
+  return tune_;
+}
+
+void setTuning(QudaTune tune)
+{
+  tune_ = tune;
+  tune_init = true;
 }
 
 void setOutputPrefix(const char *prefix)
@@ -102,13 +111,16 @@ void popVerbosity()
 char *getPrintBuffer() { return buffer_; }
 
 char* getOmpThreadStr() {
-  static char omp_thread_string[128];
-  static bool init = false;
-  if (!init) {
-    strcpy(omp_thread_string,",omp_threads=");
-    char *omp_threads = getenv("OMP_NUM_THREADS");
-    strcat(omp_thread_string, omp_threads ? omp_threads : "1");
-    init = true;
-  }
+  // rebuilt on every call, so that host kernels launched after a
+  // change of the thread count get their own tunecache entries
+  static COMM_RANK_LOCAL char omp_thread_string[128];
+#ifdef _OPENMP
+  // the runtime also accounts for thread limits other than OMP_NUM_THREADS
+  snprintf(omp_thread_string, 128, ",omp_threads=%d", omp_get_max_threads());
+#else
+  strcpy(omp_thread_string,",omp_threads=");
+  char *omp_threads = getenv("OMP_NUM_THREADS");
+  strcat(omp_thread_string, omp_threads ? omp_threads : "1");
+#endif
   return omp_thread_string;
 }
@@ -172,6 +172,79 @@ void clover_mat(void *out, void **gauge, void *clover, void *in, double kappa,
   free(tmp);
 }
 
+// Apply the even-odd preconditioned Wilson-clover operator to nrhs vectors
+void clover_matpc_mrhs(void **out, void **gauge, void *clover, void *clover_inv, void **in, int nrhs, double kappa,
+                       QudaMatPCType matpc_type, int dagger, QudaPrecision precision, QudaGaugeParam &gauge_param) {
+
+  double kappa2 = -kappa*kappa;
+  void **tmp = (void**)malloc(nrhs*sizeof(void*));
+  for (int r = 0; r < nrhs; r++) tmp[r] = malloc(Vh*spinorSiteSize*precision);
+
+  const int parity = (matpc_type == QUDA_MATPC_EVEN_EVEN || matpc_type == QUDA_MATPC_EVEN_EVEN_ASYMMETRIC) ? 0 : 1;
+  const int other = 1 - parity;
+
+  switch(matpc_type) {
+  case QUDA_MATPC_EVEN_EVEN:
+  case QUDA_MATPC_ODD_ODD:
+    if (!dagger) {
+      wil_dslash_mrhs(tmp, gauge, in, nrhs, other, dagger, precision, gauge_param);
+      for (int r = 0; r < nrhs; r++) apply_clover(out[r], clover_inv, tmp[r], other, precision);
+      wil_dslash_mrhs(tmp, gauge, out, nrhs, parity, dagger, precision, gauge_param);
+      for (int r = 0; r < nrhs; r++) apply_clover(out[r], clover_inv, tmp[r], parity, precision);
+    } else {
+      for (int r = 0; r < nrhs; r++) apply_clover(tmp[r], clover_inv, in[r], parity, precision);
+      wil_dslash_mrhs(out, gauge, tmp, nrhs, other, dagger, precision, gauge_param);
+      for (int r = 0; r < nrhs; r++) apply_clover(tmp[r], clover_inv, out[r], other, precision);
+      wil_dslash_mrhs(out, gauge, tmp, nrhs, parity, dagger, precision, gauge_param);
+    }
+    for (int r = 0; r < nrhs; r++) xpay(in[r], kappa2, out[r], Vh*spinorSiteSize, precision);
+    break;
+  case QUDA_MATPC_EVEN_EVEN_ASYMMETRIC:
+  case QUDA_MATPC_ODD_ODD_ASYMMETRIC:
+    wil_dslash_mrhs(out, gauge, in, nrhs, other, dagger, precision, gauge_param);
+    for (int r = 0; r < nrhs; r++) apply_clover(tmp[r], clover_inv, out[r], other, precision);
+    wil_dslash_mrhs(out, gauge, tmp, nrhs, parity, dagger, precision, gauge_param);
+    for (int r = 0; r < nrhs; r++) {
+      apply_clover(tmp[r], clover, in[r], parity, precision);
+      xpay(tmp[r], kappa2, out[r], Vh*spinorSiteSize, precision);
+    }
+    break;
+  default:
+    errorQuda("Unsupoorted matpc=%d", matpc_type);
+  }
+
+  for (int r = 0; r < nrhs; r++) free(tmp[r]);
+  free(tmp);
+}
+
+// Apply the full Wilson-clover operator to nrhs vectors
+void clover_mat_mrhs(void **out, void **gauge, void *clover, void **in, int nrhs, double kappa,
+                     int dagger, QudaPrecision precision, QudaGaugeParam &gauge_param) {
+
+  void **inEven = (void**)malloc(4*nrhs*sizeof(void*));
+  void **inOdd = inEven + nrhs, **outEven = inEven + 2*nrhs, **outOdd = inEven + 3*nrhs;
+  for (int r = 0; r < nrhs; r++) {
+    inEven[r] = in[r];
+    inOdd[r] = (char*)in[r] + Vh*spinorSiteSize*precision;
+    outEven[r] = out[r];
+    outOdd[r] = (char*)out[r] + Vh*spinorSiteSize*precision;
+  }
+
+  wil_dslash_mrhs(outOdd, gauge, inEven, nrhs, 1, dagger, precision, gauge_param);
+  wil_dslash_mrhs(outEven, gauge, inOdd, nrhs, 0, dagger, precision, gauge_param);
+
+  // lastly apply the clover and kappa terms
+  void *tmp = malloc(V*spinorSiteSize*precision);
+  for (int r = 0; r < nrhs; r++) {
+    apply_clover(tmp, clover, inEven[r], 0, precision);
+    apply_clover((char*)tmp + Vh*spinorSiteSize*precision, clover, inOdd[r], 1, precision);
+    xpay(tmp, -kappa, out[r], V*spinorSiteSize, precision);
+  }
+
+  free(tmp);
+  free(inEven);
+}
+
 void applyTwist(void *out, void *in, void *tmpH, double a, QudaPrecision precision) {
   switch (precision) {
   case QUDA_DOUBLE_PRECISION:
@@ -0,0 +1,197 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <vector>
+
+#include <quda_internal.h>
+#include <comm_quda.h>
+#include <test_util.h>
+
+// In a typical application, quda.h is the only QUDA header required.
+#include <quda.h>
+
+extern int niter;
+extern int xdim, ydim, zdim, tdim;
+extern int gridsize_from_cmdline[];
+
+extern void usage(char** );
+
+// bytes per face site: a spin-projected single-precision spinor
+static const size_t site_bytes = 2 * 3 * 2 * sizeof(float);
+
+// number of ranks that saw an incorrect halo or reduction
+static int n_fail = 0;
+
+void display_test_info(int nranks)
+{
+  printfQuda("running the following test:\n");
+  printfQuda("threaded comms halo exchange on %d ranks, local volume %dx%dx%dx%d, %d iterations\n", nranks, xdim,
+             ydim, zdim, tdim, niter);
+  printfQuda("Grid partition info:     X  Y  Z  T\n");
+  printfQuda("                         %d  %d  %d  %d\n", dimPartitioned(0), dimPartitioned(1), dimPartitioned(2),
+             dimPartitioned(3));
+}
+
+/**
+   Exchange the faces of every partitioned dimension in both directions,
+   with contiguous messages when strided is false and with every other
+   site of a buffer twice the face size when strided is true.  Each
+   send buffer is filled with the sending rank, as ints so that any
+   number of ranks can be told apart, so the receiver can check where
+   its halo came from.
+ */
+static int exchange(int dim, bool strided, int iter)
+{
+  const int X[4] = {xdim, ydim, zdim, tdim};
+  const int face = xdim * ydim * zdim * tdim / X[dim];
+  const size_t stride = strided ? 2 * site_bytes : site_bytes;
+  const size_t bytes = face * stride;
+  const size_t site_words = site_bytes / sizeof(int);
+  const size_t stride_words = stride / sizeof(int);
+
+  std::vector<int> send[2], recv[2];
+  MsgHandle *mh_send[2], *mh_recv[2];
+  for (int dir = 0; dir < 2; dir++) {
+    send[dir].assign(bytes / sizeof(int), comm_rank());
+    recv[dir].assign(bytes / sizeof(int), -1);
+    const int d = dir == 0 ? -1 : +1;
+    if (strided) {
+      mh_send[dir] = comm_declare_strided_send_relative(send[dir].data(), dim, d, site_bytes, face, stride);
+      mh_recv[dir] = comm_declare_strided_receive_relative(recv[dir].data(), dim, d, site_bytes, face, stride);
+    } else {
+      mh_send[dir] = comm_declare_send_relative(send[dir].data(), dim, d, bytes);
+      mh_recv[dir] = comm_declare_receive_relative(recv[dir].data(), dim, d, bytes);
+    }
+  }
+
+  for (int i = 0; i < iter; i++) {
+    for (int dir = 0; dir < 2; dir++) comm_start(mh_recv[dir]);
+    for (int dir = 0; dir < 2; dir++) comm_start(mh_send[dir]);
+    for (int dir = 0; dir < 2; dir++) {
+      comm_wait(mh_send[dir]);
+      comm_wait(mh_recv[dir]);
+    }
+  }
+
+  int fail = 0;
+  for (int dir = 0; dir < 2; dir++) {
+    const int expected = comm_neighbor_rank(dir, dim);
+    for (int s = 0; s < face; s++) {
+      for (size_t w = 0; w < stride_words; w++) {
+        const int value = recv[dir][s * stride_words + w];
+        if (value != (w < site_words ? expected : -1)) fail = 1;
+      }
+    }
+    comm_free(mh_send[dir]);
+    comm_free(mh_recv[dir]);
+  }
+
+  return fail;
+}
+
+/**
+   Send depth messages to the neighbour in each direction before
+   receiving any.  The sends must not wait for the receiver however
+   many are queued, and the messages must arrive in order.
+ */
+static int queue(int dim, int depth)
+{
+  int send[2][2], recv[2][2];
+  MsgHandle *mh_send[2], *mh_recv[2];
+  for (int dir = 0; dir < 2; dir++) {
+    const int d = dir == 0 ? -1 : +1;
+    mh_send[dir] = comm_declare_send_relative(send[dir], dim, d, sizeof(send[dir]));
+    mh_recv[dir] = comm_declare_receive_relative(recv[dir], dim, d, sizeof(recv[dir]));
+  }
+
+  for (int i = 0; i < depth; i++) {
+    for (int dir = 0; dir < 2; dir++) {
+      send[dir][0] = comm_rank();
+      send[dir][1] = i;
+      comm_start(mh_send[dir]);
+      comm_wait(mh_send[dir]);
+    }
+  }
+
+  int fail = 0;
+  for (int i = 0; i < depth; i++) {
+    for (int dir = 0; dir < 2; dir++) {
+      comm_start(mh_recv[dir]);
+      comm_wait(mh_recv[dir]);
+      if (recv[dir][0] != comm_neighbor_rank(dir, dim) || recv[dir][1] != i) fail = 1;
+    }
+  }
+
+  for (int dir = 0; dir < 2; dir++) {
+    comm_free(mh_send[dir]);
+    comm_free(mh_recv[dir]);
+  }
+
+  return fail;
+}
+
+static void rank_main(void *)
+{
+  initComms(0, nullptr, gridsize_from_cmdline);
+  display_test_info(comm_size());
+
+  int fail = 0;
+  for (int dim = 0; dim < 4; dim++) {
+    if (!commDimPartitioned(dim)) continue;
+    fail |= queue(dim, 64);
+    comm_barrier();
+
+    for (int strided = 0; strided < 2; strided++) {
+      fail |= exchange(dim, strided, 1); // warm up and check
+      comm_barrier();
+
+      comm_threads_stats_reset();
+      auto start = std::chrono::steady_clock::now();
+      exchange(dim, strided, niter);
+      comm_barrier();
+      double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+      CommStats stats;
+      comm_threads_stats(&stats);
+      printfQuda("dim %d %-10s: %zu messages, %zu bytes per rank, %g us per exchange, %g GB/s per rank\n", dim,
+                 strided ? "strided" : "contiguous", stats.messages, stats.bytes, 1e6 * secs / niter,
+                 1e-9 * stats.bytes / secs);
+    }
+  }
+
+  // the tree sum is exact for small integers
+  double sum = comm_rank();
+  comm_allreduce(&sum);
+  if (sum != 0.5 * comm_size() * (comm_size() - 1)) fail = 1;
+
+  comm_threads_stats_reset();
+  for (int i = 0; i < niter; i++) {
+    double x = 1.0;
+    comm_allreduce(&x);
+  }
+  CommStats stats;
+  comm_threads_stats(&stats);
+  printfQuda("allreduce latency: %g us\n", 1e6 * stats.collective_time / stats.collectives);
+
+  comm_allreduce_int(&fail);
+  if (comm_rank() == 0) n_fail = fail;
+  if (fail) printfQuda("%d ranks failed\n", fail);
+
+  comm_finalize();
+}
+
+int main(int argc, char **argv)
+{
+  for (int i = 1; i < argc; i++) {
+    if (process_command_line_option(argc, argv, &i) == 0) continue;
+    printf("ERROR: Invalid option:%s\n", argv[i]);
+    usage(argv);
+  }
+
+  int nranks = 1;
+  for (int d = 0; d < 4; d++) nranks *= gridsize_from_cmdline[d];
+  comm_threads_launch(nranks, rank_main, nullptr);
+
+  return n_fail ? EXIT_FAILURE : EXIT_SUCCESS;
+}
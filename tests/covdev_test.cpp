@@ -316,12 +316,13 @@ void covdevRef(int mu)
   // compare to dslash reference implementation
   printfQuda("Calculating reference implementation...");
   fflush(stdout);
+  stopwatchStart();
 #ifdef MULTI_GPU
   mat_mg4dir(spinorRef, links, ghostLink, spinor, dagger, mu, inv_param.cpu_prec, gaugeParam.cpu_prec);
 #else
   mat(spinorRef->V(), links, spinor->V(), dagger, mu, inv_param.cpu_prec, gaugeParam.cpu_prec);
 #endif    
-  printfQuda("done.\n");
+  printfQuda("done in %g secs.\n", stopwatchReadSeconds());
 
 }
 
@@ -645,6 +645,7 @@ void dslashRef() {
   // compare to dslash reference implementation
   printfQuda("Calculating reference implementation...");
   fflush(stdout);
+  stopwatchStart();
 
   if (dslash_type == QUDA_WILSON_DSLASH) {
     switch (test_type) {
@@ -938,7 +939,7 @@ void dslashRef() {
     exit(-1);
   }
 
-  printfQuda("done.\n");
+  printfQuda("done in %g secs.\n", stopwatchReadSeconds());
 }
 
 
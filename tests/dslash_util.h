@@ -89,6 +89,59 @@ static inline void su3Tmul(sFloat *res, gFloat *mat, sFloat *vec) {
 }
 
 
+// The multi-RHS host operators work on blocks of up to maxMultiRHS
+// vectors stored with the right-hand-side index running fastest,
+// block[(x*siteSize + k)*nrhs + r], so that every link that is loaded
+// is applied to all the vectors of the block in unit-stride loops.
+const int maxMultiRHS = 16;
+
+// copy vector v into column r of a block of nrhs vectors
+template <typename Float>
+static inline void packRHS(Float *block, const Float *v, int r, int nrhs, int sites, int siteSize) {
+#pragma omp parallel for
+  for (int x = 0; x < sites; x++)
+    for (int k = 0; k < siteSize; k++) block[(x*siteSize + k)*nrhs + r] = v[x*siteSize + k];
+}
+
+// copy column r of a block of nrhs vectors into vector v
+template <typename Float>
+static inline void unpackRHS(Float *v, const Float *block, int r, int nrhs, int sites, int siteSize) {
+#pragma omp parallel for
+  for (int x = 0; x < sites; x++)
+    for (int k = 0; k < siteSize; k++) v[x*siteSize + k] = block[(x*siteSize + k)*nrhs + r];
+}
+
+// res = mat * vec (or mat^dagger * vec if dagger) for each of the n
+// vectors of the color-vector blocks vec and res, in the operation
+// order of su3Mul and su3Tmul
+template <typename sFloat, typename gFloat>
+static inline void su3MulMultiRHS(sFloat *res, const gFloat *mat, const sFloat *vec, int n, bool dagger) {
+  sFloat U[3*3*2];
+  for (int m = 0; m < 3; m++) {
+    for (int k = 0; k < 3; k++) {
+      U[m*(3*2) + k*(2) + 0] = dagger ? + mat[k*(3*2) + m*(2) + 0] : mat[m*(3*2) + k*(2) + 0];
+      U[m*(3*2) + k*(2) + 1] = dagger ? - mat[k*(3*2) + m*(2) + 1] : mat[m*(3*2) + k*(2) + 1];
+    }
+  }
+
+  for (int m = 0; m < 3; m++) {
+    sFloat *res_re = res + (2*m+0)*n, *res_im = res + (2*m+1)*n;
+#pragma omp simd
+    for (int r = 0; r < n; r++) res_re[r] = res_im[r] = 0;
+    for (int k = 0; k < 3; k++) {
+      const sFloat a_re = U[m*(3*2) + k*(2) + 0];
+      const sFloat a_im = U[m*(3*2) + k*(2) + 1];
+      const sFloat *b_re = vec + (2*k+0)*n, *b_im = vec + (2*k+1)*n;
+#pragma omp simd
+      for (int r = 0; r < n; r++) {
+        res_re[r] += a_re * b_re[r] - a_im * b_im[r];
+        res_im[r] += a_re * b_im[r] + a_im * b_re[r];
+      }
+    }
+  }
+}
+
+
 // i represents a "half index" into an even or odd "half lattice".
 // when oddBit={0,1} the half lattice is {even,odd}.
 // 
@@ -184,6 +237,14 @@ template <QudaDWFPCType type, typename Float>
   Float *spinorNeighbor_5d(int i, int dir, int oddBit, Float *spinorField, int neighbor_distance=1, int siteSize=24) {
   int nb = neighbor_distance;
   int j;
+
+  // with 4-d preconditioning each fifth-dimensional slice is a copy of the 4-d checkerboard
+  const LatticeGeometry *geom = hostGeometry();
+  if (type == QUDA_4D_PC && dir < 8 && geom && LatticeGeometry::hopIndex(nb) >= 0) {
+    const int xs = i / Vh;
+    return &spinorField[(xs*Vh + geom->neighbor(oddBit, i - xs*Vh, dir, nb))*siteSize];
+  }
+
   switch (dir) {
   case 0: j = neighborIndex_5d<type>(i, oddBit, 0, 0, 0, 0, +nb); break;
   case 1: j = neighborIndex_5d<type>(i, oddBit, 0, 0, 0, 0, -nb); break;
@@ -216,10 +277,16 @@ static inline Float *gaugeLink_mg4dir(int i, int dir, int oddBit, Float **gaugeE
   Float **gaugeField;
   int j;
   int d = nbr_distance;
+  const LatticeGeometry *geom = hostGeometry(n_ghost_faces);
   if (dir % 2 == 0) {
     j = i;
     gaugeField = (oddBit ? gaugeOdd : gaugeEven);
   }
+  else if (geom && LatticeGeometry::hopIndex(d) >= 0) {
+    j = geom->ghostNeighbor(oddBit, i, dir, d);
+    if (j < 0) return &(oddBit ? ghostGaugeEven : ghostGaugeOdd)[dir/2][(-j-1)*(3*3*2)];
+    gaugeField = (oddBit ? gaugeEven : gaugeOdd);
+  }
   else {
 
     int Y = fullLatticeIndex(i, oddBit);
@@ -295,6 +362,14 @@ static inline Float *spinorNeighbor_mg4dir(int i, int dir, int oddBit, Float *sp
 {
   int j;
   int nb = neighbor_distance;
+
+  const LatticeGeometry *geom = hostGeometry(nFace);
+  if (geom && LatticeGeometry::hopIndex(nb) >= 0) {
+    j = geom->ghostNeighbor(oddBit, i, dir, nb);
+    if (j < 0) return (dir % 2 == 0 ? fwd_nbr_spinor : back_nbr_spinor)[dir/2] + (-j-1)*mySpinorSiteSize;
+    return &spinorField[j*(mySpinorSiteSize)];
+  }
+
   int Y = fullLatticeIndex(i, oddBit);
   int x4 = Y/(Z[2]*Z[1]*Z[0]);
   int x3 = (Y/(Z[1]*Z[0])) % Z[2];
@@ -434,6 +509,20 @@ Float *spinorNeighbor_5d_mgpu(int i, int dir, int oddBit, Float *spinorField, Fl
 {
   int j;
   int nb = neighbor_distance;
+
+  const LatticeGeometry *geom = hostGeometry(nFace);
+  if (type == QUDA_4D_PC && geom && LatticeGeometry::hopIndex(nb) >= 0) {
+    const int xs = i / Vh;
+    j = geom->ghostNeighbor(oddBit, i - xs*Vh, dir, nb);
+    if (j >= 0) return &spinorField[(xs*Vh + j)*spinorSize];
+
+    // the 5-d ghost zones are ordered by depth, then fifth dimension, then face
+    const int faceCB = geom->faceVolumeCB[dir/2];
+    const int depth = (-j-1) / faceCB;
+    const int offset = (depth*Ls + xs)*faceCB + (-j-1) - depth*faceCB;
+    return (dir % 2 == 0 ? fwd_nbr_spinor : back_nbr_spinor)[dir/2] + offset*spinorSize;
+  }
+
   int Y = (type == QUDA_5D_PC) ? fullLatticeIndex_5d(i, oddBit) : fullLatticeIndex_5d_4dpc(i, oddBit);
 
   int xs = Y/(Z[3]*Z[2]*Z[1]*Z[0]);
@@ -5,6 +5,7 @@
 #include <quda.h>
 #include <quda_internal.h>
 #include <gauge_field.h>
+#include <color_spinor_field.h>
 
 #include <comm_quda.h>
 #include <test_util.h>
@@ -16,6 +17,10 @@
 
 #include <qio_field.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #if defined(QMP_COMMS)
 #include <qmp.h>
 #elif defined(MPI_COMMS)
@@ -192,11 +197,9 @@ class GaugeAlgTest : public ::testing::Test {
 #else
     cudaInGauge = new cudaGaugeField(gParam);
 #endif
-    int halfvolume = xdim*ydim*zdim*tdim >> 1;
-    printfQuda("xdim=%d\tydim=%d\tzdim=%d\ttdim=%d\trng_size=%d\n",xdim,ydim,zdim,tdim,halfvolume);
-    // CURAND random generator initialization
-    randstates = new RNG(halfvolume, 1234, param.X);
-    randstates->Init();
+    printfQuda("xdim=%d\tydim=%d\tzdim=%d\ttdim=%d\n",xdim,ydim,zdim,tdim);
+    // counter-based random number generator, keyed on the global site
+    randstates = new RNG(1234, param.X);
 
     nsteps = 10;
     nhbsteps = 4;
@@ -248,7 +251,6 @@ class GaugeAlgTest : public ::testing::Test {
 
     a0.Stop(__func__, __FILE__, __LINE__);
     printfQuda("Time -> %.6f s\n", a0.Last());
-    randstates->Release();
     delete randstates;
   }
 
@@ -311,6 +313,81 @@ TEST_F(GaugeAlgTest,Coulomb_FFT){
   }
 }
 
+template <typename Float>
+double maxDeviation(const ColorSpinorField &a, const ColorSpinorField &b)
+{
+  double dev = 0.0;
+  const Float *x = (const Float*)a.V();
+  const Float *y = (const Float*)b.V();
+  for (size_t i = 0; i < a.Bytes() / sizeof(Float); i++) dev = MAX(dev, DABS(x[i] - y[i]));
+  return dev;
+}
+
+// Noise drawn from the same seed must be bitwise identical whatever
+// the number of OpenMP threads, and uniform noise must be bitwise
+// identical between host and device.  Gaussian noise goes through
+// log, sin and cos, which may differ in the last bit between host and
+// device, so it is compared to a tolerance.
+TEST(RandomTest,SpinorNoise){
+  ColorSpinorParam csParam;
+  csParam.nColor = 3;
+  csParam.nSpin = 4;
+  csParam.nDim = 4;
+  int X[4] = {xdim, ydim, zdim, tdim};
+  for (int d=0; d<4; d++) csParam.x[d] = X[d];
+  csParam.setPrecision(prec == QUDA_DOUBLE_PRECISION ? QUDA_DOUBLE_PRECISION : QUDA_SINGLE_PRECISION);
+  csParam.pad = 0;
+  csParam.siteSubset = QUDA_FULL_SITE_SUBSET;
+  csParam.siteOrder = QUDA_EVEN_ODD_SITE_ORDER;
+  csParam.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+  csParam.gammaBasis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+  csParam.create = QUDA_ZERO_FIELD_CREATE;
+  cpuColorSpinorField serial(csParam), threaded(csParam), deviceResult(csParam);
+
+  csParam.fieldOrder = csParam.Precision() == QUDA_DOUBLE_PRECISION ? QUDA_FLOAT2_FIELD_ORDER : QUDA_FLOAT4_FIELD_ORDER;
+  cudaColorSpinorField device(csParam);
+
+  const bool isDouble = csParam.Precision() == QUDA_DOUBLE_PRECISION;
+  const double tol = isDouble ? 1e-12 : 1e-5;
+  const QudaNoiseType type[] = {QUDA_NOISE_UNIFORM, QUDA_NOISE_GAUSS};
+  for (int t=0; t<2; t++) {
+    // untuned, so that each fill runs on all the threads that are set
+    const QudaTune tune = getTuning();
+    setTuning(QUDA_TUNE_NO);
+#ifdef _OPENMP
+    const int max_threads = omp_get_max_threads();
+    omp_set_num_threads(1);
+#endif
+    RNG rngSerial(1234, X);
+    spinorNoise(serial, rngSerial, type[t]);
+#ifdef _OPENMP
+    omp_set_num_threads(MAX(max_threads, 2));
+    int running = 0;
+#pragma omp parallel
+    {
+#pragma omp single
+      running = omp_get_num_threads();
+    }
+    EXPECT_GT(running, 1);
+#endif
+    RNG rngThreaded(1234, X);
+    spinorNoise(threaded, rngThreaded, type[t]);
+#ifdef _OPENMP
+    omp_set_num_threads(max_threads);
+#endif
+    setTuning(tune);
+    ASSERT_EQ(memcmp(serial.V(), threaded.V(), serial.Bytes()), 0);
+
+    RNG rngDevice(1234, X);
+    spinorNoise(device, rngDevice, type[t]);
+    deviceResult = device;
+    double dev = isDouble ? maxDeviation<double>(serial, deviceResult) : maxDeviation<float>(serial, deviceResult);
+    printfQuda("%s noise: host and device deviate by %e\n", type[t] == QUDA_NOISE_UNIFORM ? "Uniform" : "Gaussian", dev);
+    if (type[t] == QUDA_NOISE_UNIFORM) ASSERT_EQ(memcmp(serial.V(), deviceResult.V(), serial.Bytes()), 0);
+    else ASSERT_LE(dev, tol);
+  }
+}
+
 
 
 
@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <chrono>
 
 #include <quda.h>
 #include <quda_internal.h>
@@ -17,6 +18,10 @@
 
 #include <qio_field.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #if defined(QMP_COMMS)
 #include <qmp.h>
 #elif defined(MPI_COMMS)
@@ -146,6 +151,172 @@ void CallUnitarizeLinks(quda::cudaGaugeField *cudaInGauge){
    device_free(num_failures_dev);
   }
 
+/**
+   Cold start a host gauge field, including the halo
+*/
+void coldStart(quda::cpuGaugeField &gauge)
+{
+  for (int dir=0; dir<4; dir++) {
+    for (int i=0; i<gauge.Volume(); i++) {
+      for (int c=0; c<3; c++) {
+        if (gauge.Precision() == QUDA_DOUBLE_PRECISION) ((double**)gauge.Gauge_p())[dir][i*gaugeSiteSize + 8*c] = 1.0;
+        else ((float**)gauge.Gauge_p())[dir][i*gaugeSiteSize + 8*c] = 1.0;
+      }
+    }
+  }
+}
+
+template <typename Float>
+void linkDeviation(const quda::GaugeField &a, const quda::GaugeField &b, double tol, double &dev, long &agree)
+{
+  dev = 0.0;
+  agree = 0;
+  for (int d = 0; d < 4; d++) {
+    const Float *x = ((const Float **)a.Gauge_p())[d];
+    const Float *y = ((const Float **)b.Gauge_p())[d];
+    for (int i = 0; i < a.Volume(); i++) {
+      double link_dev = 0.0;
+      for (int j = 0; j < gaugeSiteSize; j++) link_dev = MAX(link_dev, fabs(x[i*gaugeSiteSize+j] - y[i*gaugeSiteSize+j]));
+      dev = MAX(dev, link_dev);
+      if (link_dev <= tol) agree++;
+    }
+  }
+}
+
+/**
+   Check that the host heatbath is reproducible: the same sweeps from
+   the same seed must give a bitwise identical field whatever the
+   number of OpenMP threads, and should follow the device heatbath,
+   which draws from the same Philox streams.  The device comparison is
+   not bitwise, since a rounding difference can flip an accept/reject
+   step of the heatbath, but a wrong stream mapping would leave
+   hardly any link in agreement.
+*/
+void checkHostMonte(double beta_value, int nhbsteps, int novrsteps)
+{
+  using namespace quda;
+  int x[4] = {xdim, ydim, zdim, tdim};
+  int y[4];
+  int R[4] = {0,0,0,0};
+  for(int dir=0; dir<4; ++dir) if(comm_dim_partitioned(dir)) R[dir] = 2;
+  for(int dir=0; dir<4; ++dir) y[dir] = x[dir] + 2 * R[dir];
+  GaugeFieldParam gParamEx(y, prec, QUDA_RECONSTRUCT_NO, 0, QUDA_VECTOR_GEOMETRY, QUDA_GHOST_EXCHANGE_EXTENDED);
+  gParamEx.create = QUDA_ZERO_FIELD_CREATE;
+  gParamEx.order = QUDA_QDP_GAUGE_ORDER;
+  gParamEx.link_type = QUDA_WILSON_LINKS;
+  gParamEx.siteSubset = QUDA_FULL_SITE_SUBSET;
+  gParamEx.t_boundary = QUDA_PERIODIC_T;
+  gParamEx.nFace = 1;
+  for(int dir=0; dir<4; ++dir) gParamEx.r[dir] = R[dir];
+
+  cpuGaugeField serial(gParamEx), threaded(gParamEx), deviceResult(gParamEx);
+  coldStart(serial);
+  coldStart(threaded);
+
+  GaugeFieldParam gParamDev(gParamEx);
+  gParamDev.order = QUDA_FLOAT2_GAUGE_ORDER;
+  gParamDev.create = QUDA_NULL_FIELD_CREATE;
+  cudaGaugeField device(gParamDev);
+  device.copy(serial);
+
+  // untuned, the host kernels run on all the threads that are set,
+  // where the tuner could settle on a single thread for both fields
+  const QudaTune tune = getTuning();
+  setTuning(QUDA_TUNE_NO);
+#ifdef _OPENMP
+  const int max_threads = omp_get_max_threads();
+  const int nthreads = MAX(max_threads, 2);
+  omp_set_num_threads(1);
+#else
+  const int nthreads = 1;
+#endif
+  RNG rng_serial(1234, x);
+  Monte(serial, rng_serial, beta_value, nhbsteps, novrsteps);
+#ifdef _OPENMP
+  omp_set_num_threads(nthreads);
+  int running = 0;
+#pragma omp parallel
+  {
+#pragma omp single
+    running = omp_get_num_threads();
+  }
+  if (running < 2) errorQuda("Only %d OpenMP thread runs with %d threads set", running, nthreads);
+#endif
+  RNG rng_threaded(1234, x);
+  Monte(threaded, rng_threaded, beta_value, nhbsteps, novrsteps);
+#ifdef _OPENMP
+  omp_set_num_threads(max_threads);
+#endif
+  setTuning(tune);
+
+  int mismatch = 0;
+  for (int dir=0; dir<4; dir++) {
+    if (memcmp(((void**)serial.Gauge_p())[dir], ((void**)threaded.Gauge_p())[dir], (size_t)serial.Volume() * gaugeSiteSize * serial.Precision()))
+      mismatch = 1;
+  }
+  comm_allreduce_int(&mismatch);
+  if (mismatch) errorQuda("Host heatbath with 1 and %d threads gives different fields", nthreads);
+  printfQuda("Host heatbath with 1 and %d threads gives bitwise identical fields\n", nthreads);
+
+  RNG rng_device(1234, x);
+  Monte(device, rng_device, beta_value, nhbsteps, novrsteps);
+  deviceResult.copy(device);
+
+  const double tol = prec == QUDA_DOUBLE_PRECISION ? 1e-10 : 1e-4;
+  double dev;
+  long agree;
+  if (prec == QUDA_DOUBLE_PRECISION) linkDeviation<double>(serial, deviceResult, tol, dev, agree);
+  else linkDeviation<float>(serial, deviceResult, tol, dev, agree);
+  double links = 4.0 * serial.Volume();
+  comm_allreduce_max(&dev);
+  comm_allreduce(&links);
+  double agreed = agree;
+  comm_allreduce(&agreed);
+  printfQuda("Host heatbath agrees with the device on %.2f%% of the links, maximum deviation %e\n", 100.0 * agreed / links, dev);
+  if (agreed < 0.5 * links) errorQuda("Host heatbath does not follow the device Philox streams");
+}
+
+/**
+   Benchmark the host heatbath and overrelaxation sweeps on cold
+   started local volumes of L^4, reporting the sweep rate and the
+   plaquette reached.
+*/
+void benchmarkHostMonte(double beta_value, int nhbsteps, int novrsteps)
+{
+  using namespace quda;
+  const int L[] = {4, 8, 12, 16};
+  const int nsteps = 2;
+
+  for (int l=0; l<4; l++) {
+    int y[4];
+    int R[4] = {0,0,0,0};
+    for(int dir=0; dir<4; ++dir) if(comm_dim_partitioned(dir)) R[dir] = 2;
+    for(int dir=0; dir<4; ++dir) y[dir] = L[l] + 2 * R[dir];
+    GaugeFieldParam gParamEx(y, prec, QUDA_RECONSTRUCT_NO, 0, QUDA_VECTOR_GEOMETRY, QUDA_GHOST_EXCHANGE_EXTENDED);
+    gParamEx.create = QUDA_ZERO_FIELD_CREATE;
+    gParamEx.order = QUDA_QDP_GAUGE_ORDER;
+    gParamEx.link_type = QUDA_WILSON_LINKS;
+    gParamEx.siteSubset = QUDA_FULL_SITE_SUBSET;
+    gParamEx.t_boundary = QUDA_PERIODIC_T;
+    gParamEx.nFace = 1;
+    for(int dir=0; dir<4; ++dir) gParamEx.r[dir] = R[dir];
+    cpuGaugeField gaugeEx(gParamEx);
+    coldStart(gaugeEx);
+
+    // wall-clock time, since clock() sums over the OpenMP threads
+    int x[4] = {L[l], L[l], L[l], L[l]};
+    RNG randstates(1234, x);
+    auto start = std::chrono::steady_clock::now();
+    for (int step=0; step<nsteps; step++) Monte(gaugeEx, randstates, beta_value, nhbsteps, novrsteps);
+    double time0 = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double3 plaq = plaquette(gaugeEx, QUDA_CPU_FIELD_LOCATION);
+    double sweeps = nsteps * (nhbsteps + novrsteps);
+    printfQuda("Host heatbath %d^4: %g sweeps/s, %g link updates/s, plaquette = %e\n", L[l], sweeps / time0,
+               sweeps * 4 * L[l]*L[l]*L[l]*L[l] / time0, plaq.x);
+  }
+}
+
 int main(int argc, char **argv)
 {
 
@@ -225,10 +396,8 @@ int main(int argc, char **argv)
     gParamEx.nFace = 1;
     for(int dir=0; dir<4; ++dir) gParamEx.r[dir] = R[dir];
     cudaGaugeField *gaugeEx = new cudaGaugeField(gParamEx);
-    int halfvolume = xdim*ydim*zdim*tdim >> 1;
-    // CURAND random generator initialization
-    RNG *randstates = new RNG(halfvolume, 1234, gauge_param.X);
-    randstates->Init();
+    // counter-based random number generator, keyed on the global site
+    RNG *randstates = new RNG(1234, gauge_param.X);
 
     int nsteps = heatbath_num_steps;
     int nwarm = heatbath_warmup_steps;
@@ -349,10 +518,12 @@ int main(int argc, char **argv)
 
     delete gauge;
     delete gaugeEx;
+
+    checkHostMonte(beta_value, nhbsteps, novrsteps);
+    benchmarkHostMonte(beta_value, nhbsteps, novrsteps);
     //Release all temporary memory used for data exchange between GPUs in multi-GPU mode
     PGaugeExchangeFree();
  
-    randstates->Release();
     delete randstates;
   }
 
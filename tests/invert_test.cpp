@@ -235,7 +235,8 @@ int main(int argc, char **argv)
       dslash_type == QUDA_TWISTED_MASS_DSLASH || 
       dslash_type == QUDA_TWISTED_CLOVER_DSLASH || 
       multishift || inv_type == QUDA_CG_INVERTER ||
-      inv_type == QUDA_CG3_INVERTER || inv_type == QUDA_CA_CG_INVERTER) {
+      inv_type == QUDA_CG3_INVERTER || inv_type == QUDA_CA_CG_INVERTER ||
+      inv_type == QUDA_PIPELINED_CG_INVERTER) {
     inv_param.solve_type = QUDA_NORMOP_PC_SOLVE;
   } else {
     inv_param.solve_type = QUDA_DIRECT_PC_SOLVE;
@@ -694,6 +695,41 @@ int main(int argc, char **argv)
 
   }
 
+  // compare the pipelined solver against plain CG on the last source
+  if (inv_type == QUDA_PIPELINED_CG_INVERTER && !multishift) {
+    int pipe_iter = inv_param.iter;
+    double pipe_secs = inv_param.secs;
+    double pipe_res = inv_param.true_res;
+
+    void *spinorRef = malloc(inv_param.Ls*V*spinorSiteSize*sSize);
+    memset(spinorRef, 0, inv_param.Ls*V*spinorSiteSize*sSize);
+
+    inv_param.inv_type = QUDA_CG_INVERTER;
+    invertQuda(spinorRef, spinorIn, &inv_param);
+    inv_param.inv_type = QUDA_PIPELINED_CG_INVERTER;
+
+    int vol = inv_param.solution_type == QUDA_MAT_SOLUTION ? V : Vh;
+    mxpy(spinorOut, spinorRef, vol*spinorSiteSize*inv_param.Ls, inv_param.cpu_prec);
+    double diff = sqrt(norm_2(spinorRef, vol*spinorSiteSize*inv_param.Ls, inv_param.cpu_prec) /
+		       norm_2(spinorOut, vol*spinorSiteSize*inv_param.Ls, inv_param.cpu_prec));
+
+    printfQuda("Pipelined CG: %i iter / %g secs, residual = %g\n", pipe_iter, pipe_secs, pipe_res);
+    printfQuda("Plain CG:     %i iter / %g secs, residual = %g\n", inv_param.iter, inv_param.secs, inv_param.true_res);
+    printfQuda("Relative difference between solutions = %g\n", diff);
+
+    free(spinorRef);
+
+    const double res_tol = 10*(inv_param.tol > inv_param.true_res ? inv_param.tol : inv_param.true_res);
+    if (pipe_res > res_tol)
+      errorQuda("Pipelined CG residual %g does not match plain CG residual %g", pipe_res, inv_param.true_res);
+
+    // each solution error is bounded by the condition number times its residual, so allow for a
+    // moderately conditioned operator on top of the residual tolerance
+    const double diff_tol = 10*res_tol;
+    if (diff > diff_tol)
+      errorQuda("Pipelined CG solution differs from plain CG by %g (tolerance %g)", diff, diff_tol);
+  }
+
   freeGaugeQuda();
   if (dslash_type == QUDA_CLOVER_WILSON_DSLASH || dslash_type == QUDA_TWISTED_CLOVER_DSLASH) freeCloverQuda();
   
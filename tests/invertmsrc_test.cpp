@@ -481,6 +481,44 @@ int main(int argc, char **argv)
 //  }
 //    #if 0
 //   else
+
+  // the Wilson and clover references are applied to all the solutions at once
+  const bool multi_rhs = (dslash_type == QUDA_WILSON_DSLASH || dslash_type == QUDA_CLOVER_WILSON_DSLASH);
+  if (multi_rhs) {
+    const int n = inv_param.num_src;
+    if (inv_param.solution_type == QUDA_MAT_SOLUTION) {
+      if (dslash_type == QUDA_WILSON_DSLASH) {
+        wil_mat_mrhs(spinorCheck, gauge, spinorOutMulti, n, inv_param.kappa, 0, inv_param.cpu_prec, gauge_param);
+      } else {
+        clover_mat_mrhs(spinorCheck, gauge, clover, spinorOutMulti, n, inv_param.kappa, 0, inv_param.cpu_prec, gauge_param);
+      }
+    } else if (inv_param.solution_type == QUDA_MATPC_SOLUTION) {
+      if (dslash_type == QUDA_WILSON_DSLASH) {
+        wil_matpc_mrhs(spinorCheck, gauge, spinorOutMulti, n, inv_param.kappa, inv_param.matpc_type, 0,
+                       inv_param.cpu_prec, gauge_param);
+      } else {
+        clover_matpc_mrhs(spinorCheck, gauge, clover, clover_inv, spinorOutMulti, n, inv_param.kappa,
+                          inv_param.matpc_type, 0, inv_param.cpu_prec, gauge_param);
+      }
+    } else if (inv_param.solution_type == QUDA_MATPCDAG_MATPC_SOLUTION) {
+      void **spinorTmp = (void**)malloc(n*sizeof(void*));
+      for (int i=0; i<n; i++) spinorTmp[i] = malloc(V*spinorSiteSize*sSize*inv_param.Ls);
+      if (dslash_type == QUDA_WILSON_DSLASH) {
+        wil_matpc_mrhs(spinorTmp, gauge, spinorOutMulti, n, inv_param.kappa, inv_param.matpc_type, 0,
+                       inv_param.cpu_prec, gauge_param);
+        wil_matpc_mrhs(spinorCheck, gauge, spinorTmp, n, inv_param.kappa, inv_param.matpc_type, 1,
+                       inv_param.cpu_prec, gauge_param);
+      } else {
+        clover_matpc_mrhs(spinorTmp, gauge, clover, clover_inv, spinorOutMulti, n, inv_param.kappa,
+                          inv_param.matpc_type, 0, inv_param.cpu_prec, gauge_param);
+        clover_matpc_mrhs(spinorCheck, gauge, clover, clover_inv, spinorTmp, n, inv_param.kappa,
+                          inv_param.matpc_type, 1, inv_param.cpu_prec, gauge_param);
+      }
+      for (int i=0; i<n; i++) free(spinorTmp[i]);
+      free(spinorTmp);
+    }
+  }
+
   for (int i=0; i <inv_param.num_src; i++){
 
     if (inv_param.solution_type == QUDA_MAT_SOLUTION) {
@@ -499,8 +537,8 @@ int main(int argc, char **argv)
 
 	  tm_ndeg_mat(evenOut, oddOut, gauge, evenIn, oddIn, inv_param.kappa, inv_param.mu, inv_param.epsilon, 0, inv_param.cpu_prec, gauge_param);
 	}
-      } else if (dslash_type == QUDA_WILSON_DSLASH || dslash_type == QUDA_CLOVER_WILSON_DSLASH) {
-        wil_mat(spinorCheck[i], gauge, spinorOutMulti[i], inv_param.kappa, 0, inv_param.cpu_prec, gauge_param);
+      } else if (multi_rhs) {
+        // applied above
       } else if (dslash_type == QUDA_DOMAIN_WALL_DSLASH) {
         dw_mat(spinorCheck[i], gauge, spinorOutMulti[i], kappa5, inv_param.dagger, inv_param.cpu_prec, gauge_param, inv_param.mass);
 //      } else if (dslash_type == QUDA_DOMAIN_WALL_4D_DSLASH) {
@@ -530,9 +568,8 @@ int main(int argc, char **argv)
 	  errorQuda("Twisted mass solution type not supported");
         tm_matpc(spinorCheck[i], gauge, spinorOutMulti[i], inv_param.kappa, inv_param.mu, inv_param.twist_flavor,
                  inv_param.matpc_type, 0, inv_param.cpu_prec, gauge_param);
-      } else if (dslash_type == QUDA_WILSON_DSLASH || dslash_type == QUDA_CLOVER_WILSON_DSLASH) {
-        wil_matpc(spinorCheck[i], gauge, spinorOutMulti[i], inv_param.kappa, inv_param.matpc_type, 0,
-                  inv_param.cpu_prec, gauge_param);
+      } else if (multi_rhs) {
+        // applied above
       } else if (dslash_type == QUDA_DOMAIN_WALL_DSLASH) {
         dw_matpc(spinorCheck[i], gauge, spinorOutMulti[i], kappa5, inv_param.matpc_type, 0, inv_param.cpu_prec, gauge_param, inv_param.mass);
       } else if (dslash_type == QUDA_DOMAIN_WALL_4D_DSLASH) {
@@ -569,7 +606,7 @@ int main(int argc, char **argv)
 
       void *spinorTmp = malloc(V*spinorSiteSize*sSize*inv_param.Ls);
 
-      ax(0, spinorCheck[i], V*spinorSiteSize, inv_param.cpu_prec);
+      if (!multi_rhs) ax(0, spinorCheck[i], V*spinorSiteSize, inv_param.cpu_prec);
 
       if (dslash_type == QUDA_TWISTED_MASS_DSLASH || dslash_type == QUDA_TWISTED_CLOVER_DSLASH) {
 	if (inv_param.twist_flavor != QUDA_TWIST_SINGLET)
@@ -578,11 +615,8 @@ int main(int argc, char **argv)
                  inv_param.matpc_type, 0, inv_param.cpu_prec, gauge_param);
         tm_matpc(spinorCheck[i], gauge, spinorTmp, inv_param.kappa, inv_param.mu, inv_param.twist_flavor,
                  inv_param.matpc_type, 1, inv_param.cpu_prec, gauge_param);
-      } else if (dslash_type == QUDA_WILSON_DSLASH || dslash_type == QUDA_CLOVER_WILSON_DSLASH) {
-        wil_matpc(spinorTmp, gauge, spinorOutMulti[i], inv_param.kappa, inv_param.matpc_type, 0,
-                  inv_param.cpu_prec, gauge_param);
-        wil_matpc(spinorCheck[i], gauge, spinorTmp, inv_param.kappa, inv_param.matpc_type, 1,
-                  inv_param.cpu_prec, gauge_param);
+      } else if (multi_rhs) {
+        // applied above
       } else {
         printfQuda("Unsupported dslash_type\n");
         exit(-1);
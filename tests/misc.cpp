@@ -1226,6 +1226,8 @@ get_solver_type(char* s)
     ret = QUDA_CA_CGNR_INVERTER;
   } else if (strcmp(s, "ca-gcr") == 0){
     ret = QUDA_CA_GCR_INVERTER;
+  } else if (strcmp(s, "pipelined-cg") == 0){
+    ret = QUDA_PIPELINED_CG_INVERTER;
   } else {
     fprintf(stderr, "Error: invalid solver type %s\n", s);
     exit(1);
@@ -1315,6 +1317,9 @@ get_solver_str(QudaInverterType type)
   case QUDA_CA_GCR_INVERTER:
     ret = "ca-gcr";
     break;
+  case QUDA_PIPELINED_CG_INVERTER:
+    ret = "pipelined-cg";
+    break;
   default:
     ret = "unknown";
     errorQuda("Error: invalid solver type %d\n", type);
@@ -11,6 +11,7 @@
 // include because of nasty globals used in the tests
 #include <dslash_util.h>
 #include <dirac_quda.h>
+#include <tune_quda.h>
 
 #define MAX(a,b) ((a)>(b)?(a):(b))
 
@@ -83,7 +84,8 @@ void initFields(QudaPrecision prec)
 
   param.siteOrder = QUDA_EVEN_ODD_SITE_ORDER;
   param.gammaBasis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
-  param.setPrecision(QUDA_DOUBLE_PRECISION);
+  // the host fields match the precision of the host coarse links
+  param.setPrecision(prec < QUDA_SINGLE_PRECISION ? QUDA_SINGLE_PRECISION : prec);
   param.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
 
   param.create = QUDA_ZERO_FIELD_CREATE;
@@ -188,7 +190,12 @@ void freeFields()
 
 DiracCoarse *dirac;
 
-double benchmark(int test, const int niter) {
+double benchmark(int test, const int niter, QudaFieldLocation location = QUDA_CUDA_FIELD_LOCATION) {
+
+  ColorSpinorField &x = location == QUDA_CUDA_FIELD_LOCATION ? *xD : *xH;
+  ColorSpinorField &y = location == QUDA_CUDA_FIELD_LOCATION ? *yD : *yH;
+
+  if (location == QUDA_CPU_FIELD_LOCATION) stopwatchStart();
 
   cudaEvent_t start, end;
   cudaEventCreate(&start);
@@ -197,13 +204,13 @@ double benchmark(int test, const int niter) {
 
   switch(test) {
   case 0:
-    for (int i=0; i < niter; ++i) dirac->Dslash(xD->Even(), yD->Odd(), QUDA_EVEN_PARITY);
+    for (int i=0; i < niter; ++i) dirac->Dslash(x.Even(), y.Odd(), QUDA_EVEN_PARITY);
     break;
   case 1:
-    for (int i=0; i < niter; ++i) dirac->M(*xD, *yD);
+    for (int i=0; i < niter; ++i) dirac->M(x, y);
     break;
   case 2:
-    for (int i=0; i < niter; ++i) dirac->Clover(xD->Even(), yD->Even(), QUDA_EVEN_PARITY);
+    for (int i=0; i < niter; ++i) dirac->Clover(x.Even(), y.Even(), QUDA_EVEN_PARITY);
     break;
   default:
     errorQuda("Undefined test %d", test);
@@ -216,7 +223,7 @@ double benchmark(int test, const int niter) {
   cudaEventDestroy(start);
   cudaEventDestroy(end);
 
-  double secs = runTime / 1000;
+  double secs = location == QUDA_CUDA_FIELD_LOCATION ? runTime / 1000 : stopwatchReadSeconds();
   return secs;
 }
 
@@ -272,6 +279,35 @@ int main(int argc, char** argv)
 
     printfQuda("Ncolor = %2d, %-31s: Gflop/s = %6.1f\n", Ncolor, names[test_type], gflops);
 
+    if (prec >= QUDA_SINGLE_PRECISION) {
+      // scaling of the CPU coarse operator with the number of OpenMP
+      // threads: tuning is switched off, since the tuner may settle on
+      // fewer threads than are available, so each row runs on exactly
+      // the given number of threads with the default static schedule
+      const int max_threads = hostThreads();
+      const QudaTune tune = getTuning();
+      setTuning(QUDA_TUNE_NO);
+      double gflops_1 = 0.0;
+      for (int threads = 1; ; threads = 2*threads < max_threads ? 2*threads : max_threads) {
+        TuneParam tp;
+        tp.block = dim3(threads, 0, 1);
+        HostLaunch launch(tp);
+
+        benchmark(test_type, 1, QUDA_CPU_FIELD_LOCATION);
+        dirac->Flops();
+
+        const int host_niter = MAX(niter/100, 1);
+        double host_secs = benchmark(test_type, host_niter, QUDA_CPU_FIELD_LOCATION);
+        double host_gflops = (dirac->Flops()*1e-9)/(host_secs);
+        if (threads == 1) gflops_1 = host_gflops;
+
+        printfQuda("Ncolor = %2d, %-31s: CPU threads = %3d, Gflop/s = %6.1f, speedup = %5.2f\n",
+                   Ncolor, names[test_type], threads, host_gflops, host_gflops / gflops_1);
+        if (threads == max_threads) break;
+      }
+      setTuning(tune);
+    }
+
     delete dirac;
     freeFields();
   }
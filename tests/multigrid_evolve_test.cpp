@@ -720,10 +720,8 @@ int main(int argc, char **argv)
     gParamEx.nFace = 1;
     for(int dir=0; dir<4; ++dir) gParamEx.r[dir] = R[dir];
     cudaGaugeField *gaugeEx = new cudaGaugeField(gParamEx);
-    int halfvolume = xdim*ydim*zdim*tdim >> 1;
-    // CURAND random generator initialization
-    RNG *randstates = new RNG(halfvolume, 1234, gauge_param.X);
-    randstates->Init();
+    // counter-based random number generator, keyed on the global site
+    RNG *randstates = new RNG(1234, gauge_param.X);
 
     int nsteps = 10;
     int nhbsteps = 1;
@@ -835,7 +833,6 @@ int main(int argc, char **argv)
     //Release all temporary memory used for data exchange between GPUs in multi-GPU mode
     PGaugeExchangeFree();
  
-    randstates->Release();
     delete randstates;
   }
 
@@ -3,6 +3,8 @@
 #include <time.h>
 #include <math.h>
 #include <string.h>
+#include <chrono>
+#include <string>
 
 #include <util_quda.h>
 #include <test_util.h>
@@ -103,6 +105,7 @@ extern QudaSolveType solve_type;
 
 extern char vec_infile[];
 extern char vec_outfile[];
+extern char vec_compare[];
 
 //Twisted mass flavor type
 extern QudaTwistFlavorType twist_flavor;
@@ -515,6 +518,65 @@ void setInvertParam(QudaInvertParam &inv_param) {
   inv_param.omega = 1.0;
 }
 
+/**
+   Compare the solver with null-space vectors stored at full, half and
+   quarter precision.  The vectors of mg_preconditioner are written to
+   "<vec_compare>_full" etc., mg_preconditioner is destroyed, and the
+   multigrid setup is loaded from each file in turn to solve spinorIn.
+*/
+void compareCompressedVectors(void *mg_preconditioner, QudaMultigridParam &mg_param, QudaInvertParam &inv_param,
+                              void *spinorOut, void *spinorIn)
+{
+  const int n = 3;
+  const char *label[n] = {"full", "half", "quarter"};
+  const char *io_prec[n] = {"double", "half", "quarter"}; // never written above the field precision
+  char file[n][256];
+
+  const char *env = getenv("QUDA_FIELD_IO_PRECISION");
+  const std::string env_prec = env ? env : "";
+
+  for (int i=0; i<n; i++) {
+    snprintf(file[i], 256, "%s_%s", vec_compare, label[i]);
+    setenv("QUDA_FIELD_IO_PRECISION", io_prec[i], 1);
+    strcpy(mg_param.vec_outfile, file[i]);
+    dumpMultigridQuda(mg_preconditioner, &mg_param);
+  }
+  if (env) setenv("QUDA_FIELD_IO_PRECISION", env_prec.c_str(), 1);
+  else unsetenv("QUDA_FIELD_IO_PRECISION");
+  destroyMultigridQuda(mg_preconditioner);
+
+  const QudaBoolean vec_load = mg_param.vec_load;
+  const QudaBoolean vec_store = mg_param.vec_store;
+  mg_param.vec_load = QUDA_BOOLEAN_YES;
+  mg_param.vec_store = QUDA_BOOLEAN_NO;
+
+  double setup_secs[n], solve_secs[n], true_res[n];
+  int iter[n];
+  for (int i=0; i<n; i++) {
+    strcpy(mg_param.vec_infile, file[i]);
+    auto start = std::chrono::steady_clock::now();
+    void *mg = newMultigridQuda(&mg_param);
+    setup_secs[i] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    inv_param.preconditioner = mg;
+    invertQuda(spinorOut, spinorIn, &inv_param);
+    iter[i] = inv_param.iter;
+    solve_secs[i] = inv_param.secs;
+    true_res[i] = inv_param.true_res;
+    destroyMultigridQuda(mg);
+  }
+
+  mg_param.vec_load = vec_load;
+  mg_param.vec_store = vec_store;
+  strcpy(mg_param.vec_infile, vec_infile);
+  strcpy(mg_param.vec_outfile, vec_outfile);
+
+  printfQuda("\nNull-space vector precision comparison:\n");
+  printfQuda("%-8s %12s %8s %12s %14s\n", "vectors", "setup secs", "iter", "solve secs", "true residual");
+  for (int i=0; i<n; i++)
+    printfQuda("%-8s %12.3f %8d %12.3f %14e\n", label[i], setup_secs[i], iter[i], solve_secs[i], true_res[i]);
+}
+
 int main(int argc, char **argv)
 {
   // We give here the default values to some of the array
@@ -684,8 +746,9 @@ int main(int argc, char **argv)
     invertQuda(spinorOut, spinorIn, &inv_param);
   }
 
-  // free the multigrid solver
-  destroyMultigridQuda(mg_preconditioner);
+  // free the multigrid solver, after comparing against compressed null-space vectors if requested
+  if (strcmp(vec_compare,"")) compareCompressedVectors(mg_preconditioner, mg_param, inv_param, spinorOut, spinorIn);
+  else destroyMultigridQuda(mg_preconditioner);
 
 
 
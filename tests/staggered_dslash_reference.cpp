@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <math.h>
 #include <string.h>
+#include <algorithm>
 
 #include <test_util.h>
 #include <quda_internal.h>
@@ -227,6 +228,112 @@ matdagmat(void *out, void **fatlink, void** longlink, void *in, double mass, int
 }
 
 
+#ifndef MULTI_GPU
+
+// Staggered dslash applied to a block of n <= maxMultiRHS vectors
+// stored with the right-hand-side index running fastest (see packRHS),
+// so that each fat and long link is loaded once for all the vectors.
+// The neighbors come from the cached lattice geometry, and the
+// operation order per site matches dslashReference.
+template <typename sFloat, typename gFloat>
+static void dslashMultiRHS(sFloat *res, gFloat **fatlink, gFloat **longlink, const sFloat *spinorField,
+                           int n, int oddBit, int daggerBit)
+{
+  const LatticeGeometry &geom = latticeGeometry(Z, 3);
+  const int siteSize = 3 * 2 * n;
+
+  // links for forward hops are at this parity, for backward hops at the other
+  const gFloat *fat[2][4], *lng[2][4];
+  for (int mu = 0; mu < 4; mu++) {
+    fat[0][mu] = fatlink[mu] + oddBit * Vh * gaugeSiteSize;
+    fat[1][mu] = fatlink[mu] + (1 - oddBit) * Vh * gaugeSiteSize;
+    lng[0][mu] = longlink[mu] + oddBit * Vh * gaugeSiteSize;
+    lng[1][mu] = longlink[mu] + (1 - oddBit) * Vh * gaugeSiteSize;
+  }
+
+#pragma omp parallel for
+  for (int i = 0; i < Vh; i++) {
+    sFloat out[3 * 2 * maxMultiRHS] = {};
+    sFloat gauged[3 * 2 * maxMultiRHS];
+
+    for (int dir = 0; dir < 8; dir++) {
+      const int mu = dir / 2;
+      const bool back = dir % 2 == 1;
+      const int j1 = geom.neighbor(oddBit, i, dir, 1);
+      const int j3 = geom.neighbor(oddBit, i, dir, 3);
+      const gFloat *fatlnk = back ? fat[1][mu] + j1 * gaugeSiteSize : fat[0][mu] + i * gaugeSiteSize;
+      const gFloat *longlnk = back ? lng[1][mu] + j3 * gaugeSiteSize : lng[0][mu] + i * gaugeSiteSize;
+
+      su3MulMultiRHS(gauged, fatlnk, spinorField + j1 * siteSize, n, back);
+      if (back) for (int k = 0; k < siteSize; k++) out[k] -= gauged[k];
+      else for (int k = 0; k < siteSize; k++) out[k] += gauged[k];
+
+      su3MulMultiRHS(gauged, longlnk, spinorField + j3 * siteSize, n, back);
+      if (back) for (int k = 0; k < siteSize; k++) out[k] -= gauged[k];
+      else for (int k = 0; k < siteSize; k++) out[k] += gauged[k];
+    }
+
+    if (daggerBit) for (int k = 0; k < siteSize; k++) out[k] = -out[k];
+    for (int k = 0; k < siteSize; k++) res[i * siteSize + k] = out[k];
+  }
+}
+
+template <typename sFloat, typename gFloat>
+static void MatdagmatMultiRHS(sFloat **out, gFloat **fatlink, gFloat **longlink, sFloat **in, int nrhs,
+                              sFloat mass, int daggerBit, QudaParity parity)
+{
+  const int siteSize = 3 * 2;
+  const sFloat msq_x4 = mass * mass * 4;
+  const int oddBit = parity == QUDA_ODD_PARITY ? 1 : 0;
+
+  const size_t bytes = (size_t)Vh * siteSize * std::min(nrhs, maxMultiRHS) * sizeof(sFloat);
+  sFloat *inBlock = (sFloat *)malloc(bytes);
+  sFloat *tmpBlock = (sFloat *)malloc(bytes);
+  sFloat *outBlock = (sFloat *)malloc(bytes);
+
+  for (int r0 = 0; r0 < nrhs; r0 += maxMultiRHS) {
+    const int n = std::min(maxMultiRHS, nrhs - r0);
+    for (int r = 0; r < n; r++) packRHS(inBlock, in[r0 + r], r, n, Vh, siteSize);
+
+    dslashMultiRHS(tmpBlock, fatlink, longlink, inBlock, n, 1 - oddBit, daggerBit);
+    dslashMultiRHS(outBlock, fatlink, longlink, tmpBlock, n, oddBit, daggerBit);
+
+    for (int r = 0; r < n; r++) {
+      unpackRHS(out[r0 + r], outBlock, r, n, Vh, siteSize);
+      // lastly apply the mass term
+      axmy(in[r0 + r], msq_x4, out[r0 + r], Vh * siteSize);
+    }
+  }
+
+  free(outBlock);
+  free(tmpBlock);
+  free(inBlock);
+}
+
+void matdagmat_mrhs(void **out, void **fatlink, void **longlink, void **in, int nrhs, double mass, int dagger_bit,
+                    QudaPrecision sPrecision, QudaPrecision gPrecision, QudaParity parity)
+{
+  if (parity != QUDA_EVEN_PARITY && parity != QUDA_ODD_PARITY)
+    errorQuda("ERROR: full parity not supported in function %s\n", __FUNCTION__);
+
+  if (sPrecision == QUDA_DOUBLE_PRECISION) {
+    if (gPrecision == QUDA_DOUBLE_PRECISION) {
+      MatdagmatMultiRHS((double **)out, (double **)fatlink, (double **)longlink, (double **)in, nrhs, (double)mass, dagger_bit, parity);
+    } else {
+      MatdagmatMultiRHS((double **)out, (float **)fatlink, (float **)longlink, (double **)in, nrhs, (double)mass, dagger_bit, parity);
+    }
+  } else {
+    if (gPrecision == QUDA_DOUBLE_PRECISION) {
+      MatdagmatMultiRHS((float **)out, (double **)fatlink, (double **)longlink, (float **)in, nrhs, (float)mass, dagger_bit, parity);
+    } else {
+      MatdagmatMultiRHS((float **)out, (float **)fatlink, (float **)longlink, (float **)in, nrhs, (float)mass, dagger_bit, parity);
+    }
+  }
+}
+
+#endif
+
+
 
 
 
@@ -30,4 +30,11 @@ void matdagmat_mg4dir(cpuColorSpinorField* out, void **fatlink, void **longlink,
 		      cpuColorSpinorField* in, double mass, int dagger_bit,
 		      QudaPrecision sPrecision, QudaPrecision gPrecision, cpuColorSpinorField* tmp, QudaParity parity);
 
+#ifndef MULTI_GPU
+// multi-RHS variant of matdagmat, out[i] = M^dagger M in[i] for the nrhs
+// single-parity vectors, with each link loaded once per block of vectors
+void matdagmat_mrhs(void **out, void **fatlink, void **longlink, void **in, int nrhs, double mass, int dagger_bit,
+		    QudaPrecision sPrecision, QudaPrecision gPrecision, QudaParity parity);
+#endif
+
 #endif // _QUDA_DLASH_REF_H
@@ -731,6 +731,7 @@ void staggeredDslashRef()
   // compare to dslash reference implementation
   // printfQuda("Calculating reference implementation...");
   fflush(stdout);
+  stopwatchStart();
   switch (test_type) {
     case 0:
 #ifdef MULTI_GPU
@@ -768,6 +769,7 @@ void staggeredDslashRef()
     default:
       errorQuda("Test type not defined");
   }
+  printfQuda("Reference implementation took %g secs\n", stopwatchReadSeconds());
 
 }
 
@@ -359,16 +359,34 @@ invert_test(void)
 
 
 
+      // verify every solution, the reported residual is that of source 0
+      {
+        cpuColorSpinorField* spinorRefArray[NUM_SRC];
+        void* refArray[NUM_SRC];
+        spinorRefArray[0] = ref;
+        for(int i=1;i < inv_param.num_src; i++) spinorRefArray[i] = new cpuColorSpinorField(csParam);
+        for(int i=0;i < inv_param.num_src; i++) refArray[i] = spinorRefArray[i]->V();
+
 #ifdef MULTI_GPU
-      matdagmat_mg4dir(ref, qdp_fatlink, qdp_longlink, ghost_fatlink, ghost_longlink,
-          out, mass, 0, inv_param.cpu_prec, gaugeParam.cpu_prec, tmp, QUDA_EVEN_PARITY);
+        for(int i=0;i < inv_param.num_src; i++)
+          matdagmat_mg4dir(spinorRefArray[i], qdp_fatlink, qdp_longlink, ghost_fatlink, ghost_longlink,
+              spinorOutArray[i], mass, 0, inv_param.cpu_prec, gaugeParam.cpu_prec, tmp, QUDA_EVEN_PARITY);
 #else
-      matdagmat(ref->V(), qdp_fatlink, qdp_longlink, out->V(), mass, 0, inv_param.cpu_prec, gaugeParam.cpu_prec, tmp->V(), QUDA_EVEN_PARITY);
+        matdagmat_mrhs(refArray, qdp_fatlink, qdp_longlink, outArray, inv_param.num_src, mass, 0,
+            inv_param.cpu_prec, gaugeParam.cpu_prec, QUDA_EVEN_PARITY);
 #endif
 
-      mxpy(in->V(), ref->V(), Vh*mySpinorSiteSize, inv_param.cpu_prec);
-      nrm2 = norm_2(ref->V(), Vh*mySpinorSiteSize, inv_param.cpu_prec);
-      src2 = norm_2(in->V(), Vh*mySpinorSiteSize, inv_param.cpu_prec);
+        for(int i=0;i < inv_param.num_src; i++){
+          mxpy(inArray[i], refArray[i], Vh*mySpinorSiteSize, inv_param.cpu_prec);
+          double nrm2_i = norm_2(refArray[i], Vh*mySpinorSiteSize, inv_param.cpu_prec);
+          double src2_i = norm_2(inArray[i], Vh*mySpinorSiteSize, inv_param.cpu_prec);
+          printfQuda("Source %d: (L2 relative) host residual = %g\n", i, sqrt(nrm2_i/src2_i));
+          if (i == 0) { nrm2 = nrm2_i; src2 = src2_i; }
+          if (sqrt(nrm2_i/src2_i) > 10*inv_param.tol) ret |= 1;
+        }
+
+        for(int i=1; i < inv_param.num_src;i++) delete spinorRefArray[i];
+      }
 
       for(int i=1; i < inv_param.num_src;i++) delete spinorOutArray[i];
       for(int i=1; i < inv_param.num_src;i++) delete spinorInArray[i];
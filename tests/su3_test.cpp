@@ -3,6 +3,8 @@
 #include <time.h>
 #include <math.h>
 #include <string.h>
+#include <chrono>
+#include <algorithm>
 
 #include <util_quda.h>
 #include <test_util.h>
@@ -20,6 +22,12 @@
 // In a typical application, quda.h is the only QUDA header required.
 #include <quda.h>
 
+// internal headers, used to run the smearing on host fields
+#include <quda_internal.h>
+#include <gauge_field.h>
+#include <gauge_tools.h>
+#include <comm_quda.h>
+
 extern bool tune;
 extern int device;
 extern int xdim;
@@ -84,6 +92,296 @@ void setGaugeParam(QudaGaugeParam &gauge_param) {
 
 extern void usage(char**);
 
+#ifdef GPU_GAUGE_TOOLS
+template <typename Float>
+double maxDeviation(const quda::GaugeField &a, const quda::GaugeField &b)
+{
+  double dev = 0.0;
+  for (int d = 0; d < 4; d++) {
+    const Float *x = ((const Float **)a.Gauge_p())[d];
+    const Float *y = ((const Float **)b.Gauge_p())[d];
+    for (size_t i = 0; i < (size_t)a.Volume() * gaugeSiteSize; i++) dev = MAX(dev, fabs(x[i] - y[i]));
+  }
+  return dev;
+}
+
+/**
+   Run each smearing for a few steps on a host copy and a device copy
+   of the gauge field, and check that the host paths of APEStep,
+   STOUTStep and OvrImpSTOUTStep agree with the device ones.
+*/
+void checkHostSmearing(void **gauge, QudaGaugeParam &gauge_param)
+{
+  using namespace quda;
+
+  const unsigned int nSteps = 5;
+  const double tol = gauge_param.cpu_prec == QUDA_DOUBLE_PRECISION ? 1e-10 : 1e-4;
+
+  GaugeFieldParam gParam(gauge, gauge_param);
+  gParam.create = QUDA_REFERENCE_FIELD_CREATE;
+  cpuGaugeField cpuGauge(gParam);
+
+  int R[4], y[4];
+  for (int d = 0; d < 4; d++) {
+    R[d] = comm_dim_partitioned(d) ? 2 : 0;
+    y[d] = gauge_param.X[d] + 2 * R[d];
+  }
+  GaugeFieldParam gParamEx(y, gauge_param.cpu_prec, QUDA_RECONSTRUCT_NO, 0, QUDA_VECTOR_GEOMETRY, QUDA_GHOST_EXCHANGE_EXTENDED);
+  gParamEx.create = QUDA_ZERO_FIELD_CREATE;
+  gParamEx.order = QUDA_QDP_GAUGE_ORDER;
+  gParamEx.link_type = QUDA_WILSON_LINKS;
+  gParamEx.siteSubset = QUDA_FULL_SITE_SUBSET;
+  gParamEx.t_boundary = gauge_param.t_boundary;
+  gParamEx.nFace = 1;
+  for (int d = 0; d < 4; d++) gParamEx.r[d] = R[d];
+
+  cpuGaugeField hostOrig(gParamEx), hostSmear(gParamEx), hostTemp(gParamEx), deviceResult(gParamEx);
+  copyExtendedGauge(hostOrig, cpuGauge, QUDA_CPU_FIELD_LOCATION);
+  hostOrig.exchangeExtendedGhost(R);
+
+  GaugeFieldParam gParamDev(gParamEx);
+  gParamDev.order = QUDA_FLOAT2_GAUGE_ORDER;
+  gParamDev.create = QUDA_NULL_FIELD_CREATE;
+  cudaGaugeField deviceSmear(gParamDev), deviceTemp(gParamDev);
+
+  const char *name[] = {"APE", "STOUT", "Over Improved STOUT"};
+  for (int s = 0; s < 3; s++) {
+    hostSmear.copy(hostOrig);
+    deviceSmear.copy(hostOrig);
+
+    for (unsigned int i = 0; i < nSteps; i++) {
+      hostTemp.copy(hostSmear);
+      hostTemp.exchangeExtendedGhost(R);
+      deviceTemp.copy(deviceSmear);
+      deviceTemp.exchangeExtendedGhost(R);
+
+      switch (s) {
+      case 0: APEStep(hostSmear, hostTemp, 0.6); APEStep(deviceSmear, deviceTemp, 0.6); break;
+      case 1: STOUTStep(hostSmear, hostTemp, 0.1); STOUTStep(deviceSmear, deviceTemp, 0.1); break;
+      case 2: OvrImpSTOUTStep(hostSmear, hostTemp, 0.06, -0.25); OvrImpSTOUTStep(deviceSmear, deviceTemp, 0.06, -0.25); break;
+      }
+    }
+
+    deviceResult.copy(deviceSmear);
+    double dev = gauge_param.cpu_prec == QUDA_DOUBLE_PRECISION ? maxDeviation<double>(hostSmear, deviceResult) :
+                                                                 maxDeviation<float>(hostSmear, deviceResult);
+    comm_allreduce_max(&dev);
+    printfQuda("%s host smearing deviates from the device by %e after %u steps\n", name[s], dev, nSteps);
+    if (dev > tol) errorQuda("%s host smearing does not match the device (%e > %e)", name[s], dev, tol);
+  }
+}
+
+/**
+   Compute the field strength and the topological charge on host
+   copies of the gauge field, in QDP and in MILC order, and check that
+   the host paths of computeFmunu and computeQCharge agree with the
+   device ones.
+*/
+void checkHostCharge(void **gauge, QudaGaugeParam &gauge_param)
+{
+  using namespace quda;
+
+  const double tol = gauge_param.cpu_prec == QUDA_DOUBLE_PRECISION ? 1e-10 : 1e-4;
+
+  GaugeFieldParam gParam(gauge, gauge_param);
+  gParam.create = QUDA_REFERENCE_FIELD_CREATE;
+  cpuGaugeField cpuGauge(gParam);
+
+  int R[4], y[4];
+  for (int d = 0; d < 4; d++) {
+    R[d] = comm_dim_partitioned(d) ? 2 : 0;
+    y[d] = gauge_param.X[d] + 2 * R[d];
+  }
+  GaugeFieldParam gParamEx(y, gauge_param.cpu_prec, QUDA_RECONSTRUCT_NO, 0, QUDA_VECTOR_GEOMETRY, QUDA_GHOST_EXCHANGE_EXTENDED);
+  gParamEx.create = QUDA_ZERO_FIELD_CREATE;
+  gParamEx.order = QUDA_QDP_GAUGE_ORDER;
+  gParamEx.link_type = QUDA_WILSON_LINKS;
+  gParamEx.siteSubset = QUDA_FULL_SITE_SUBSET;
+  gParamEx.t_boundary = gauge_param.t_boundary;
+  gParamEx.nFace = 1;
+  for (int d = 0; d < 4; d++) gParamEx.r[d] = R[d];
+
+  cpuGaugeField hostQDP(gParamEx);
+  copyExtendedGauge(hostQDP, cpuGauge, QUDA_CPU_FIELD_LOCATION);
+  hostQDP.exchangeExtendedGhost(R);
+
+  GaugeFieldParam gParamMILC(gParamEx);
+  gParamMILC.order = QUDA_MILC_GAUGE_ORDER;
+  cpuGaugeField hostMILC(gParamMILC);
+  hostMILC.copy(hostQDP);
+
+  GaugeFieldParam gParamDev(gParamEx);
+  gParamDev.order = QUDA_FLOAT2_GAUGE_ORDER;
+  gParamDev.create = QUDA_NULL_FIELD_CREATE;
+  cudaGaugeField device(gParamDev);
+  device.copy(hostQDP);
+
+  GaugeFieldParam tensorParam(gauge_param.X, gauge_param.cpu_prec, QUDA_RECONSTRUCT_NO, 0, QUDA_TENSOR_GEOMETRY);
+  tensorParam.siteSubset = QUDA_FULL_SITE_SUBSET;
+  tensorParam.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
+  tensorParam.create = QUDA_ZERO_FIELD_CREATE;
+
+  tensorParam.order = QUDA_FLOAT2_GAUGE_ORDER;
+  cudaGaugeField deviceFmunu(tensorParam);
+  computeFmunu(deviceFmunu, device, QUDA_CUDA_FIELD_LOCATION);
+  const double deviceCharge = computeQCharge(deviceFmunu, QUDA_CUDA_FIELD_LOCATION);
+
+  const char *name[] = {"QDP", "MILC"};
+  cpuGaugeField *host[] = {&hostQDP, &hostMILC};
+  for (int i = 0; i < 2; i++) {
+    tensorParam.order = host[i]->Order();
+    cpuGaugeField hostFmunu(tensorParam);
+    computeFmunu(hostFmunu, *host[i], QUDA_CPU_FIELD_LOCATION);
+    const double hostCharge = computeQCharge(hostFmunu, QUDA_CPU_FIELD_LOCATION);
+
+    const double dev = fabs(hostCharge - deviceCharge) / MAX(1.0, fabs(deviceCharge));
+    printfQuda("%s host charge %.16e, device charge %.16e\n", name[i], hostCharge, deviceCharge);
+    if (dev > tol) errorQuda("%s host charge does not match the device (%e > %e)", name[i], dev, tol);
+  }
+}
+
+/**
+   Flow a host copy and a device copy of the gauge field for a few
+   steps of each flow type, and check that the host paths of WFlowStep
+   and computeWFlowObservables agree with the device ones.
+*/
+void checkHostWFlow(void **gauge, QudaGaugeParam &gauge_param)
+{
+  using namespace quda;
+
+  const unsigned int nSteps = 5;
+  const double step_size = 0.01;
+  const double tol = gauge_param.cpu_prec == QUDA_DOUBLE_PRECISION ? 1e-10 : 1e-4;
+
+  GaugeFieldParam gParam(gauge, gauge_param);
+  gParam.create = QUDA_REFERENCE_FIELD_CREATE;
+  cpuGaugeField cpuGauge(gParam);
+
+  int R[4], y[4];
+  for (int d = 0; d < 4; d++) {
+    R[d] = comm_dim_partitioned(d) ? 2 : 0;
+    y[d] = gauge_param.X[d] + 2 * R[d];
+  }
+  GaugeFieldParam gParamEx(y, gauge_param.cpu_prec, QUDA_RECONSTRUCT_NO, 0, QUDA_VECTOR_GEOMETRY, QUDA_GHOST_EXCHANGE_EXTENDED);
+  gParamEx.create = QUDA_ZERO_FIELD_CREATE;
+  gParamEx.order = QUDA_QDP_GAUGE_ORDER;
+  gParamEx.link_type = QUDA_WILSON_LINKS;
+  gParamEx.siteSubset = QUDA_FULL_SITE_SUBSET;
+  gParamEx.t_boundary = gauge_param.t_boundary;
+  gParamEx.nFace = 1;
+  for (int d = 0; d < 4; d++) gParamEx.r[d] = R[d];
+
+  cpuGaugeField hostOrig(gParamEx), hostA(gParamEx), hostB(gParamEx), hostZ(gParamEx), deviceResult(gParamEx);
+  copyExtendedGauge(hostOrig, cpuGauge, QUDA_CPU_FIELD_LOCATION);
+  hostOrig.exchangeExtendedGhost(R);
+
+  GaugeFieldParam gParamDev(gParamEx);
+  gParamDev.order = QUDA_FLOAT2_GAUGE_ORDER;
+  gParamDev.create = QUDA_NULL_FIELD_CREATE;
+  cudaGaugeField deviceA(gParamDev), deviceB(gParamDev), deviceZ(gParamDev);
+
+  const char *name[] = {"Wilson", "Symanzik"};
+  for (int s = 0; s < 2; s++) {
+    const QudaWFlowType wflow_type = s == 0 ? QUDA_WFLOW_TYPE_WILSON : QUDA_WFLOW_TYPE_SYMANZIK;
+    GaugeField *host_in = &hostA, *host_out = &hostB, *device_in = &deviceA, *device_out = &deviceB;
+    hostA.copy(hostOrig);
+    hostA.exchangeExtendedGhost(R);
+    deviceA.copy(hostOrig);
+    deviceA.exchangeExtendedGhost(R);
+
+    for (unsigned int i = 0; i < nSteps; i++) {
+      WFlowStep(*host_out, hostZ, *host_in, step_size, wflow_type);
+      WFlowStep(*device_out, deviceZ, *device_in, step_size, wflow_type);
+      std::swap(host_in, host_out);
+      std::swap(device_in, device_out);
+    }
+
+    deviceResult.copy(*device_in);
+    double dev = gauge_param.cpu_prec == QUDA_DOUBLE_PRECISION ? maxDeviation<double>(*host_in, deviceResult) :
+                                                                 maxDeviation<float>(*host_in, deviceResult);
+    comm_allreduce_max(&dev);
+    printfQuda("%s host flow deviates from the device by %e after %u steps\n", name[s], dev, nSteps);
+    if (dev > tol) errorQuda("%s host flow does not match the device (%e > %e)", name[s], dev, tol);
+
+    const double3 host_obs = computeWFlowObservables(*host_in);
+    const double3 device_obs = computeWFlowObservables(*device_in);
+    const double obs_dev = MAX(MAX(fabs(host_obs.x - device_obs.x) / MAX(1.0, fabs(device_obs.x)),
+                                   fabs(host_obs.y - device_obs.y) / MAX(1.0, fabs(device_obs.y))),
+                               fabs(host_obs.z - device_obs.z) / MAX(1.0, fabs(device_obs.z)));
+    printfQuda("%s host flow observables (%e, %e, %e), device (%e, %e, %e)\n", name[s],
+               host_obs.x, host_obs.y, host_obs.z, device_obs.x, device_obs.y, device_obs.z);
+    if (obs_dev > tol) errorQuda("%s host flow observables do not match the device (%e > %e)", name[s], obs_dev, tol);
+  }
+}
+
+/**
+   Time the gradient flow steps alone on a device copy of the gauge
+   field in the resident precision and reconstruction, then with the
+   observables measured every meas_interval steps.  Only the step loop
+   is timed, with a wall clock, after an untimed step to tune the kernels.
+*/
+void timeWFlow(void **gauge, QudaGaugeParam &gauge_param, unsigned int nSteps, double step_size,
+               unsigned int meas_interval, QudaWFlowType wflow_type, const char *wflow_str)
+{
+  using namespace quda;
+
+  GaugeFieldParam gParam(gauge, gauge_param);
+  gParam.create = QUDA_REFERENCE_FIELD_CREATE;
+  cpuGaugeField cpuGauge(gParam);
+
+  int R[4], y[4];
+  for (int d = 0; d < 4; d++) {
+    R[d] = comm_dim_partitioned(d) ? 2 : 0;
+    y[d] = gauge_param.X[d] + 2 * R[d];
+  }
+  GaugeFieldParam gParamEx(y, gauge_param.cpu_prec, QUDA_RECONSTRUCT_NO, 0, QUDA_VECTOR_GEOMETRY, QUDA_GHOST_EXCHANGE_EXTENDED);
+  gParamEx.create = QUDA_ZERO_FIELD_CREATE;
+  gParamEx.order = QUDA_QDP_GAUGE_ORDER;
+  gParamEx.link_type = QUDA_WILSON_LINKS;
+  gParamEx.siteSubset = QUDA_FULL_SITE_SUBSET;
+  gParamEx.t_boundary = gauge_param.t_boundary;
+  gParamEx.nFace = 1;
+  for (int d = 0; d < 4; d++) gParamEx.r[d] = R[d];
+
+  cpuGaugeField hostOrig(gParamEx);
+  copyExtendedGauge(hostOrig, cpuGauge, QUDA_CPU_FIELD_LOCATION);
+  hostOrig.exchangeExtendedGhost(R);
+
+  // the accumulator holds non-unitary matrices so cannot be compressed
+  GaugeFieldParam gParamDev(gParamEx);
+  gParamDev.create = QUDA_NULL_FIELD_CREATE;
+  gParamDev.reconstruct = gauge_param.reconstruct;
+  gParamDev.setPrecision(gauge_param.cuda_prec, true);
+  cudaGaugeField deviceA(gParamDev), deviceB(gParamDev);
+  gParamDev.reconstruct = QUDA_RECONSTRUCT_NO;
+  gParamDev.setPrecision(gauge_param.cuda_prec, true);
+  cudaGaugeField deviceZ(gParamDev);
+
+  GaugeField *in = &deviceA, *out = &deviceB;
+  deviceA.copy(hostOrig);
+  deviceA.exchangeExtendedGhost(R);
+  WFlowStep(*out, deviceZ, *in, step_size, wflow_type);
+  std::swap(in, out);
+  computeWFlowObservables(*in);
+
+  double secs[2];
+  for (int m = 0; m < 2; m++) {
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = 1; i <= nSteps; i++) {
+      WFlowStep(*out, deviceZ, *in, step_size, wflow_type);
+      std::swap(in, out);
+      if (m == 1 && i % meas_interval == 0) computeWFlowObservables(*in);
+    }
+    qudaDeviceSynchronize();
+    secs[m] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+
+  printfQuda("Time for %u steps of %s flow = %g secs, %g secs per step\n", nSteps, wflow_str, secs[0], secs[0] / nSteps);
+  printfQuda("Time for %u steps of %s flow with measurements every %u steps = %g secs, %g secs per step\n", nSteps,
+             wflow_str, meas_interval, secs[1], secs[1] / nSteps);
+}
+#endif
+
 void SU3test(int argc, char **argv) {
 
   for (int i = 1; i < argc; i++){
@@ -151,6 +449,13 @@ void SU3test(int argc, char **argv) {
   time0 /= CLOCKS_PER_SEC;
   printfQuda("Computed topological charge is %.16e Done in %g secs\n", qCharge, time0);
 
+  // the host smearing paths against the device ones
+  if (gauge_param.cpu_prec != QUDA_HALF_PRECISION) {
+    checkHostSmearing(gauge, gauge_param);
+    checkHostCharge(gauge, gauge_param);
+    checkHostWFlow(gauge, gauge_param);
+  }
+
   // Stout smearing should be equivalent to APE smearing
   // on D dimensional lattices for rho = alpha/2*(D-1). 
   // Typical APE values are aplha=0.6, rho=0.1 for Stout.
@@ -194,6 +499,24 @@ void SU3test(int argc, char **argv) {
   qCharge = qChargeCuda();
   printfQuda("Computed topological charge after is %.16e \n", qCharge);
 
+  //Gradient flow
+  nSteps = 100;
+  double step_size = 0.01;
+  const unsigned int meas_interval = 10;
+  double wflow_obs[4*(100/meas_interval+1)];
+  for (int i=0; i<2; i++) {
+    QudaWFlowType wflow_type = i == 0 ? QUDA_WFLOW_TYPE_WILSON : QUDA_WFLOW_TYPE_SYMANZIK;
+    const char *wflow_str = i == 0 ? "Wilson" : "Symanzik";
+
+    // time the step loop alone, then with the fused measurements
+    timeWFlow(gauge, gauge_param, nSteps, step_size, meas_interval, wflow_type, wflow_str);
+
+    performWFlownStep(nSteps, step_size, meas_interval, wflow_type, wflow_obs);
+    printfQuda("t = %g: E = %e, t^2 E = %e, Q = %.16e\n", wflow_obs[4*(nSteps/meas_interval)],
+               wflow_obs[4*(nSteps/meas_interval)+1], wflow_obs[4*(nSteps/meas_interval)+2],
+               wflow_obs[4*(nSteps/meas_interval)+3]);
+  }
+
 #else
   printfQuda("Skipping other gauge tests since gauge tools have not been compiled\n");
 #endif
@@ -1,4 +1,8 @@
+#include <atomic>
 #include <complex>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -14,6 +18,7 @@
 #include <test_util.h>
 
 #include <dslash_quda.h>
+#include <philox_quda.h>
 #include "misc.h"
 
 using namespace std;
@@ -122,6 +127,8 @@ void initRand()
   rank = QMP_get_node_number();
 #elif defined(MPI_COMMS)
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#elif defined(THREADS_COMMS)
+  rank = comm_rank();
 #endif
 
   srand(17*rank + 137);
@@ -439,6 +446,122 @@ int compare_floats(void *a, void *b, int len, double epsilon, QudaPrecision prec
   else return compareFloats((float*)a, (float*)b, len, epsilon);
 }
 
+bool host_geometry_cached = true;
+
+LatticeGeometry::LatticeGeometry(const int *X_, int nFace) : nFace(nFace)
+{
+  bool halo = false;
+  for (int d = 0; d < 4; d++) {
+    X[d] = X_[d];
+    partitioned[d] = comm_dim_partitioned(d);
+    if (partitioned[d]) halo = true;
+  }
+  volumeCB = X[0] * X[1] * X[2] * X[3] / 2;
+  for (int d = 0; d < 4; d++) faceVolumeCB[d] = volumeCB / X[d];
+
+  const int distance[2] = {1, 3};
+  for (int parity = 0; parity < 2; parity++) {
+    full[parity].resize(volumeCB);
+    for (int hop = 0; hop < 2; hop++) {
+      nbr[parity][hop].resize(8 * volumeCB);
+      // ghost zones only hold nFace faces, so deeper hops are not tabulated
+      if (halo && distance[hop] <= nFace) ghost_nbr[parity][hop].resize(8 * volumeCB);
+    }
+  }
+
+  int dim[4] = {X[0], X[1], X[2], X[3]};
+  for (int parity = 0; parity < 2; parity++) {
+#pragma omp parallel for
+    for (int i = 0; i < volumeCB; i++) {
+      const int Y = fullLatticeIndex(dim, i, parity);
+      full[parity][i] = Y;
+      const int x[4] = {Y % X[0], (Y / X[0]) % X[1], (Y / (X[0] * X[1])) % X[2], Y / (X[0] * X[1] * X[2])};
+
+      for (int hop = 0; hop < 2; hop++) {
+        for (int dir = 0; dir < 8; dir++) {
+          const int mu = dir / 2;
+          int y[4] = {x[0], x[1], x[2], x[3]};
+          y[mu] += (dir % 2 == 0) ? distance[hop] : -distance[hop];
+          const int ymu = y[mu];
+          y[mu] = ((ymu % X[mu]) + X[mu]) % X[mu];
+
+          const int local = (((y[3] * X[2] + y[2]) * X[1] + y[1]) * X[0] + y[0]) / 2;
+          nbr[parity][hop][8 * i + dir] = local;
+
+          if (ghost_nbr[parity][hop].size()) {
+            if ((ymu < 0 || ymu >= X[mu]) && partitioned[mu]) {
+              // faces are ordered by depth, and within a face lexicographically in the remaining dimensions
+              const int depth = ymu >= X[mu] ? ymu - X[mu] : ymu + nFace;
+              int face = 0;
+              for (int d = 3; d >= 0; d--)
+                if (d != mu) face = face * X[d] + x[d];
+              ghost_nbr[parity][hop][8 * i + dir] = -(depth * faceVolumeCB[mu] + face / 2 + 1);
+            } else {
+              ghost_nbr[parity][hop][8 * i + dir] = local;
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+const LatticeGeometry &latticeGeometry(const int *X, int nFace)
+{
+  static std::map<std::vector<int>, std::unique_ptr<LatticeGeometry>> cache;
+  static std::mutex mutex;
+
+  int partition = 0;
+  for (int d = 0; d < 4; d++) partition |= comm_dim_partitioned(d) << d;
+  std::vector<int> key = {X[0], X[1], X[2], X[3], nFace, partition};
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = cache.find(key);
+  if (it == cache.end()) {
+    it = cache.insert(std::make_pair(key, std::unique_ptr<LatticeGeometry>(new LatticeGeometry(X, nFace)))).first;
+  }
+  return *(it->second);
+}
+
+// nFace = 0 requests only the periodic tables, which do not depend on
+// the partitioning, so we can skip checking it on the hot path.  This
+// is called from inside the threaded reference operators, so the
+// per-depth shortcut is atomic; the geometries it points to are owned
+// by the latticeGeometry cache and never freed.
+const LatticeGeometry *hostGeometry(int nFace)
+{
+  static std::atomic<const LatticeGeometry*> current[4];
+  if (!host_geometry_cached || nFace < 0 || nFace > 3) return NULL;
+
+  const LatticeGeometry *geom = current[nFace].load(std::memory_order_acquire);
+  bool valid = geom != NULL;
+  for (int d = 0; d < 4 && valid; d++) {
+    if (geom->X[d] != Z[d]) valid = false;
+    if (nFace > 0 && geom->partitioned[d] != comm_dim_partitioned(d)) valid = false;
+  }
+
+  if (!valid) {
+    geom = &latticeGeometry(Z, nFace > 0 ? nFace : 1);
+    current[nFace].store(geom, std::memory_order_release);
+  }
+  return geom;
+}
+
+// decodes a displacement along a single axis into a hop table direction
+static inline bool singleHop(int dx4, int dx3, int dx2, int dx1, int &dir, int &distance)
+{
+  const int dx[4] = {dx1, dx2, dx3, dx4};
+  int n = 0;
+  for (int mu = 0; mu < 4; mu++) {
+    if (dx[mu] != 0) {
+      n++;
+      dir = 2 * mu + (dx[mu] < 0 ? 1 : 0);
+      distance = dx[mu] < 0 ? -dx[mu] : dx[mu];
+    }
+  }
+  return n == 1 && LatticeGeometry::hopIndex(distance) >= 0;
+}
+
 int fullLatticeIndex(int dim[4], int index, int oddBit){
 
   int za = index/(dim[0]>>1);
@@ -453,6 +576,9 @@ int fullLatticeIndex(int dim[4], int index, int oddBit){
 // given a "half index" i into either an even or odd half lattice (corresponding
 // to oddBit = {0, 1}), returns the corresponding full lattice index.
 int fullLatticeIndex(int i, int oddBit) {
+  const LatticeGeometry *geom = hostGeometry();
+  if (geom && i < geom->volumeCB) return geom->full[oddBit][i];
+
   /*
     int boundaryCrossings = i/(Z[0]/2) + i/(Z[1]*Z[0]/2) + i/(Z[2]*Z[1]*Z[0]/2);
     return 2*i + (boundaryCrossings + oddBit) % 2;
@@ -490,6 +616,11 @@ int fullLatticeIndex(int i, int oddBit) {
 //
 
 int neighborIndex(int i, int oddBit, int dx4, int dx3, int dx2, int dx1) {
+  int dir, distance;
+  const LatticeGeometry *geom = hostGeometry();
+  if (geom && i < geom->volumeCB && singleHop(dx4, dx3, dx2, dx1, dir, distance))
+    return geom->neighbor(oddBit, i, dir, distance);
+
   int Y = fullLatticeIndex(i, oddBit);
   int x4 = Y/(Z[2]*Z[1]*Z[0]);
   int x3 = (Y/(Z[1]*Z[0])) % Z[2];
@@ -509,6 +640,12 @@ int neighborIndex(int i, int oddBit, int dx4, int dx3, int dx2, int dx1) {
 
 int neighborIndex(int dim[4], int index, int oddBit, int dx[4]){
 
+  int dir, distance;
+  const LatticeGeometry *geom = hostGeometry();
+  if (geom && geom->X[0] == dim[0] && geom->X[1] == dim[1] && geom->X[2] == dim[2] && geom->X[3] == dim[3]
+      && singleHop(dx[3], dx[2], dx[1], dx[0], dir, distance))
+    return geom->neighbor(oddBit, index, dir, distance);
+
   const int fullIndex = fullLatticeIndex(dim, index, oddBit);
 
   int x[4];
@@ -527,6 +664,13 @@ int
 neighborIndex_mg(int i, int oddBit, int dx4, int dx3, int dx2, int dx1)
 {
   int ret;
+
+  // hops in t that may leave a partitioned dimension return a face index, so are not tabulated
+  int dir, distance;
+  const LatticeGeometry *geom = hostGeometry();
+  if (geom && i < geom->volumeCB && singleHop(dx4, dx3, dx2, dx1, dir, distance)
+      && (dx4 == 0 || !comm_dim_partitioned(3)))
+    return geom->neighbor(oddBit, i, dir, distance);
   
   int Y = fullLatticeIndex(i, oddBit);
   int x4 = Y/(Z[2]*Z[1]*Z[0]);
@@ -657,6 +801,9 @@ neighborIndexFullLattice_mg(int i, int dx4, int dx3, int dx2, int dx1)
 // There, i is the thread index.
 int fullLatticeIndex_4d(int i, int oddBit) {
   if (i >= Vh || i < 0) {printf("i out of range in fullLatticeIndex_4d"); exit(-1);}
+  const LatticeGeometry *geom = hostGeometry();
+  if (geom) return geom->full[oddBit][i];
+
   /*
     int boundaryCrossings = i/(Z[0]/2) + i/(Z[1]*Z[0]/2) + i/(Z[2]*Z[1]*Z[0]/2);
     return 2*i + (boundaryCrossings + oddBit) % 2;
@@ -920,6 +1067,26 @@ static void orthogonalize(complex<Float> *a, complex<Float> *b, int len) {
   for (int i=0; i<len; i++) b[i] -= (complex<Float>)dot*a[i];
 }
 
+// Random test fields are drawn from Philox streams keyed on the
+// global site and a stream within the site (e.g., the direction)
+// rather than from rand(), so that they do not depend on the process
+// grid.  Each field uses a new generation.
+static unsigned int random_field_generation = 0;
+
+static quda::PhiloxState gaugeRandomState(int i, int oddBit, int stream, int n_stream=4)
+{
+  int X = fullLatticeIndex(i, oddBit);
+  int x[4];
+  for (int d=0; d<4; d++) { x[d] = X % Z[d]; X /= Z[d]; }
+
+  long long g = 0;
+  for (int d=3; d>=0; d--) g = g * Z[d] * comm_dim(d) + x[d] + comm_coord(d) * Z[d];
+
+  quda::PhiloxState state;
+  quda::philoxInit(state, 1234, n_stream * g + stream, random_field_generation);
+  return state;
+}
+
 template <typename Float> 
 static void constructGaugeField(Float **res, QudaGaugeParam *param, QudaDslashType dslash_type=QUDA_WILSON_DSLASH) {
   Float *resOdd[4], *resEven[4];
@@ -930,12 +1097,14 @@ static void constructGaugeField(Float **res, QudaGaugeParam *param, QudaDslashTy
     
   for (int dir = 0; dir < 4; dir++) {
     for (int i = 0; i < Vh; i++) {
+      quda::PhiloxState even = gaugeRandomState(i, 0, dir);
+      quda::PhiloxState odd = gaugeRandomState(i, 1, dir);
       for (int m = 1; m < 3; m++) { // last 2 rows
 	for (int n = 0; n < 3; n++) { // 3 columns
-	  resEven[dir][i*(3*3*2) + m*(3*2) + n*(2) + 0] = rand() / (Float)RAND_MAX;
-	  resEven[dir][i*(3*3*2) + m*(3*2) + n*(2) + 1] = rand() / (Float)RAND_MAX;
-	  resOdd[dir][i*(3*3*2) + m*(3*2) + n*(2) + 0] = rand() / (Float)RAND_MAX;
-	  resOdd[dir][i*(3*3*2) + m*(3*2) + n*(2) + 1] = rand() / (Float)RAND_MAX;                    
+	  resEven[dir][i*(3*3*2) + m*(3*2) + n*(2) + 0] = quda::Random<Float>(even);
+	  resEven[dir][i*(3*3*2) + m*(3*2) + n*(2) + 1] = quda::Random<Float>(even);
+	  resOdd[dir][i*(3*3*2) + m*(3*2) + n*(2) + 0] = quda::Random<Float>(odd);
+	  resOdd[dir][i*(3*3*2) + m*(3*2) + n*(2) + 1] = quda::Random<Float>(odd);
 	}
       }
       normalize((complex<Float>*)(resEven[dir] + (i*3+1)*3*2), 3);
@@ -976,6 +1145,7 @@ static void constructGaugeField(Float **res, QudaGaugeParam *param, QudaDslashTy
 
     }
   }
+  random_field_generation++;
 
   if (param->type == QUDA_WILSON_LINKS){  
     applyGaugeFieldScaling(res, Vh, param);
@@ -984,17 +1154,19 @@ static void constructGaugeField(Float **res, QudaGaugeParam *param, QudaDslashTy
   } else if (param->type == QUDA_ASQTAD_FAT_LINKS){
     for (int dir = 0; dir < 4; dir++){ 
       for (int i = 0; i < Vh; i++) {
+	quda::PhiloxState even = gaugeRandomState(i, 0, dir);
+	quda::PhiloxState odd = gaugeRandomState(i, 1, dir);
 	for (int m = 0; m < 3; m++) { // last 2 rows
 	  for (int n = 0; n < 3; n++) { // 3 columns
-	    resEven[dir][i*(3*3*2) + m*(3*2) + n*(2) + 0] =1.0* rand() / (Float)RAND_MAX;
-	    resEven[dir][i*(3*3*2) + m*(3*2) + n*(2) + 1] = 2.0* rand() / (Float)RAND_MAX;
-	    resOdd[dir][i*(3*3*2) + m*(3*2) + n*(2) + 0] = 3.0*rand() / (Float)RAND_MAX;
-	    resOdd[dir][i*(3*3*2) + m*(3*2) + n*(2) + 1] = 4.0*rand() / (Float)RAND_MAX;
+	    resEven[dir][i*(3*3*2) + m*(3*2) + n*(2) + 0] = 1.0 * quda::Random<Float>(even);
+	    resEven[dir][i*(3*3*2) + m*(3*2) + n*(2) + 1] = 2.0 * quda::Random<Float>(even);
+	    resOdd[dir][i*(3*3*2) + m*(3*2) + n*(2) + 0] = 3.0 * quda::Random<Float>(odd);
+	    resOdd[dir][i*(3*3*2) + m*(3*2) + n*(2) + 1] = 4.0 * quda::Random<Float>(odd);
 	  }
 	}
       }
     }
-    
+    random_field_generation++;
   }
 
 }
@@ -1010,12 +1182,14 @@ void constructUnitaryGaugeField(Float **res)
   
   for (int dir = 0; dir < 4; dir++) {
     for (int i = 0; i < Vh; i++) {
+      quda::PhiloxState even = gaugeRandomState(i, 0, dir);
+      quda::PhiloxState odd = gaugeRandomState(i, 1, dir);
       for (int m = 1; m < 3; m++) { // last 2 rows
 	for (int n = 0; n < 3; n++) { // 3 columns
-	  resEven[dir][i*(3*3*2) + m*(3*2) + n*(2) + 0] = rand() / (Float)RAND_MAX;
-	  resEven[dir][i*(3*3*2) + m*(3*2) + n*(2) + 1] = rand() / (Float)RAND_MAX;
-	  resOdd[dir][i*(3*3*2) + m*(3*2) + n*(2) + 0] = rand() / (Float)RAND_MAX;
-	  resOdd[dir][i*(3*3*2) + m*(3*2) + n*(2) + 1] = rand() / (Float)RAND_MAX;                    
+	  resEven[dir][i*(3*3*2) + m*(3*2) + n*(2) + 0] = quda::Random<Float>(even);
+	  resEven[dir][i*(3*3*2) + m*(3*2) + n*(2) + 1] = quda::Random<Float>(even);
+	  resOdd[dir][i*(3*3*2) + m*(3*2) + n*(2) + 0] = quda::Random<Float>(odd);
+	  resOdd[dir][i*(3*3*2) + m*(3*2) + n*(2) + 1] = quda::Random<Float>(odd);
 	}
       }
       normalize((complex<Float>*)(resEven[dir] + (i*3+1)*3*2), 3);
@@ -1056,6 +1230,7 @@ void constructUnitaryGaugeField(Float **res)
       
     }
   }
+  random_field_generation++;
 }
 
 template <typename Float> 
@@ -1123,7 +1298,10 @@ construct_fat_long_gauge_field(void **fatlink, void** longlink, int type,
   if (param->reconstruct == QUDA_RECONSTRUCT_9 || param->reconstruct == QUDA_RECONSTRUCT_13) {
     // incorporate non-trivial phase into long links
 
-    const double phase = (M_PI * rand())/RAND_MAX;
+    // a single stream past all the site streams, so that every rank draws the same phase
+    quda::PhiloxState state;
+    quda::philoxInit(state, 1234, ~0ull, random_field_generation++);
+    const double phase = M_PI * quda::Random<double>(state);
     const complex<double> z = polar(1.0, phase);
     for (int dir=0; dir<4; ++dir) {
       for (int i=0; i<V; ++i) {
@@ -1165,11 +1343,10 @@ construct_fat_long_gauge_field(void **fatlink, void** longlink, int type,
 template <typename Float>
 static void constructCloverField(Float *res, double norm, double diag) {
 
-  Float c = 2.0 * norm / RAND_MAX;
-
   for(int i = 0; i < V; i++) {
+    quda::PhiloxState state = gaugeRandomState(i % Vh, i / Vh, 0, 1);
     for (int j = 0; j < 72; j++) {
-      res[i*72 + j] = c*rand() - norm;
+      res[i*72 + j] = 2.0 * norm * quda::Random<Float>(state) - norm;
     }
 
     //impose clover symmetry on each chiral block
@@ -1190,6 +1367,7 @@ static void constructCloverField(Float *res, double norm, double diag) {
       res[i*72 + j+36] += diag;
     }
   }
+  random_field_generation++;
 }
 
 void construct_clover_field(void *clover, double norm, double diag, QudaPrecision precision) {
@@ -1497,21 +1675,24 @@ createMomCPU(void* mom,  QudaPrecision precision)
     if (precision == QUDA_DOUBLE_PRECISION){
       for(int dir=0;dir < 4;dir++){
 	double* thismom = (double*)mom;	    
+	quda::PhiloxState state = gaugeRandomState(i % Vh, i / Vh, dir);
 	for(int k=0; k < momSiteSize; k++){
-	  thismom[ (4*i+dir)*momSiteSize + k ]= 1.0* rand() /RAND_MAX;				
+	  thismom[ (4*i+dir)*momSiteSize + k ]= quda::Random<double>(state);
 	  if (k==momSiteSize-1) thismom[ (4*i+dir)*momSiteSize + k ]= 0.0;
 	}	    
       }	    
     }else{
       for(int dir=0;dir < 4;dir++){
 	float* thismom=(float*)mom;
+	quda::PhiloxState state = gaugeRandomState(i % Vh, i / Vh, dir);
 	for(int k=0; k < momSiteSize; k++){
-	  thismom[ (4*i+dir)*momSiteSize + k ]= 1.0* rand() /RAND_MAX;		
+	  thismom[ (4*i+dir)*momSiteSize + k ]= quda::Random<float>(state);
 	  if (k==momSiteSize-1) thismom[ (4*i+dir)*momSiteSize + k ]= 0.0;
 	}	    
       }
     }
   }
+  random_field_generation++;
     
   free(temp);
   return;
@@ -1524,19 +1705,22 @@ createHwCPU(void* hw,  QudaPrecision precision)
     if (precision == QUDA_DOUBLE_PRECISION){
       for(int dir=0;dir < 4;dir++){
 	double* thishw = (double*)hw;
+	quda::PhiloxState state = gaugeRandomState(i % Vh, i / Vh, dir);
 	for(int k=0; k < hwSiteSize; k++){
-	  thishw[ (4*i+dir)*hwSiteSize + k ]= 1.0* rand() /RAND_MAX;
+	  thishw[ (4*i+dir)*hwSiteSize + k ]= quda::Random<double>(state);
 	}
       }
     }else{
       for(int dir=0;dir < 4;dir++){
 	float* thishw=(float*)hw;
+	quda::PhiloxState state = gaugeRandomState(i % Vh, i / Vh, dir);
 	for(int k=0; k < hwSiteSize; k++){
-	  thishw[ (4*i+dir)*hwSiteSize + k ]= 1.0* rand() /RAND_MAX;
+	  thishw[ (4*i+dir)*hwSiteSize + k ]= quda::Random<float>(state);
 	}
       }
     }
   }
+  random_field_generation++;
 
   return;
 }
@@ -1670,6 +1854,7 @@ int test_type = 0;
 int nvec[QUDA_MAX_MG_LEVEL] = { };
 char vec_infile[256] = "";
 char vec_outfile[256] = "";
+char vec_compare[256] = "";
 QudaInverterType inv_type;
 QudaInverterType precon_type = QUDA_INVALID_INVERTER;
 int multishift = 0;
@@ -1756,6 +1941,8 @@ int heatbath_num_heatbath_per_step = 5;
 int heatbath_num_overrelax_per_step = 5;
 bool heatbath_coldstart = false;
 
+bool host_dslash_threaded = true;
+
 
 static int dim_partitioned[4] = {0,0,0,0};
 
@@ -1802,8 +1989,8 @@ void usage(char** argv )
 	 "                                                  wilson/clover/twisted-mass/twisted-clover/staggered\n"
          "                                                  /asqtad/domain-wall/domain-wall-4d/mobius/laplace\n");
   printf("    --flavor <type>                           # Set the twisted mass flavor type (singlet (default), deg-doublet, nondeg-doublet)\n");
-  printf("    --load-gauge file                         # Load gauge field \"file\" for the test (requires QIO)\n");
-  printf("    --save-gauge file                         # Save gauge field \"file\" for the test (requires QIO, heatbath test only)\n");
+  printf("    --load-gauge file                         # Load gauge field \"file\" for the test (QIO or native format)\n");
+  printf("    --save-gauge file                         # Save gauge field \"file\" for the test (heatbath test only)\n");
   printf("    --niter <n>                               # The number of iterations to perform (default 10)\n");
   printf("    --ngcrkrylov <n>                          # The number of inner iterations to use for GCR, BiCGstab-l, CA-CG (default 10)\n");
   printf("    --ca-basis-type <power/chebyshev>         # The basis to use for CA-CG (default power)\n");
@@ -1869,8 +2056,9 @@ void usage(char** argv )
   printf("    --mg-mu-factor <level factor>             # Set the multiplicative factor for the twisted mass mu parameter on each level (default 1)\n");
   printf("    --mg-generate-nullspace <true/false>      # Generate the null-space vector dynamically (default true, if set false and mg-load-vec isn't set, creates free-field null vectors)\n");
   printf("    --mg-generate-all-levels <true/talse>     # true=generate null-space on all levels, false=generate on level 0 and create other levels from that (default true)\n");
-  printf("    --mg-load-vec file                        # Load the vectors \"file\" for the multigrid_test (requires QIO)\n");
-  printf("    --mg-save-vec file                        # Save the generated null-space vectors \"file\" from the multigrid_test (requires QIO)\n");
+  printf("    --mg-load-vec file                        # Load the vectors \"file\" for the multigrid_test\n");
+  printf("    --mg-save-vec file                        # Save the generated null-space vectors \"file\" from the multigrid_test\n");
+  printf("    --mg-compare-vec file                     # Save the null-space vectors to \"file\" at full, half and quarter precision and compare solves using each (multigrid_invert_test)\n");
   printf("    --mg-verbosity <level verb>                # The verbosity to use on each level of the multigrid (default summarize)\n");
   printf("    --df-nev <nev>                            # Set number of eigenvectors computed within a single solve cycle (default 8)\n");
   printf("    --df-max-search-dim <dim>                 # Set the size of eigenvector search space (default 64)\n");
@@ -1896,6 +2084,8 @@ void usage(char** argv )
   printf("    --heatbath-num-hb-per-step <n>            # Number of heatbath hits per heatbath step (default 5)\n");
   printf("    --heatbath-num-or-per-step <n>            # Number of overrelaxation hits per heatbath step (default 5)\n");
   printf("    --heatbath-coldstart <true/false>         # Whether to use a cold or hot start in heatbath test (default false)\n");
+  printf("    --host-dslash <threaded/serial>           # Host Wilson dslash used for verification: threaded engine or serial reference loop (default threaded)\n");
+  printf("    --host-geometry <cached/computed>         # Whether host reference operators use cached neighbor tables or recompute indices (default cached)\n");
   printf("    --help                                    # Print out this message\n");
 
   usage_extra(argv); 
@@ -3384,6 +3574,16 @@ int process_command_line_option(int argc, char** argv, int* idx)
     goto out;
   }
 
+  if( strcmp(argv[i], "--mg-compare-vec") == 0){
+    if (i+1 >= argc){
+      usage(argv);
+    }
+    strcpy(vec_compare, argv[i+1]);
+    i++;
+    ret = 0;
+    goto out;
+  }
+
   if( strcmp(argv[i], "--df-nev") == 0){
     if (i+1 >= argc){
       usage(argv);
@@ -3704,6 +3904,44 @@ int process_command_line_option(int argc, char** argv, int* idx)
     goto out;
   }
 
+  if( strcmp(argv[i], "--host-dslash") == 0){
+    if (i+1 >= argc){
+      usage(argv);
+    }
+
+    if (strcmp(argv[i+1], "threaded") == 0){
+      host_dslash_threaded = true;
+    }else if (strcmp(argv[i+1], "serial") == 0){
+      host_dslash_threaded = false;
+    }else{
+      fprintf(stderr, "ERROR: invalid host dslash type\n");
+      usage(argv);
+    }
+
+    i++;
+    ret = 0;
+    goto out;
+  }
+
+  if( strcmp(argv[i], "--host-geometry") == 0){
+    if (i+1 >= argc){
+      usage(argv);
+    }
+
+    if (strcmp(argv[i+1], "cached") == 0){
+      host_geometry_cached = true;
+    }else if (strcmp(argv[i+1], "computed") == 0){
+      host_geometry_cached = false;
+    }else{
+      fprintf(stderr, "ERROR: invalid host geometry type\n");
+      usage(argv);
+    }
+
+    i++;
+    ret = 0;
+    goto out;
+  }
+
   if( strcmp(argv[i], "--version") == 0){
     printf("This program is linked with QUDA library, version %s,", 
 	   get_quda_ver_str());
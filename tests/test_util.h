@@ -2,6 +2,7 @@
 #define _TEST_UTIL_H
 
 #include <quda.h>
+#include <vector>
 
 #define gaugeSiteSize 18 // real numbers per link
 #define spinorSiteSize 24 // real numbers per spinor
@@ -47,6 +48,58 @@
   int neighborIndex_mg(int i, int oddBit, int dx4, int dx3, int dx2, int dx1);
   int neighborIndexFullLattice_mg(int i, int dx4, int dx3, int dx2, int dx1);
 
+  /**
+     Checkerboarded geometry of the local lattice shared by the host
+     reference operators.  The neighbor tables for single hops and for
+     the three-hop displacements of the staggered long links are built
+     once per (dimensions, nFace, partitioning) and cached for the
+     lifetime of the process, replacing the per-call coordinate
+     arithmetic of neighborIndex and friends.
+   */
+  struct LatticeGeometry {
+    int X[4];
+    int nFace;
+    int partitioned[4];
+    int volumeCB;
+    int faceVolumeCB[4];
+
+    // full lattice index of each checkerboard site
+    std::vector<int> full[2];
+    // periodic neighbors, indexed [parity][hop][8*i + dir] with dir = 2*mu + (backwards)
+    std::vector<int> nbr[2][2];
+    // as nbr, but hops leaving a partitioned dimension are encoded as -(ghost index + 1)
+    std::vector<int> ghost_nbr[2][2];
+
+    LatticeGeometry(const int *X, int nFace);
+
+    /** @return Index into the hop tables for a displacement of distance sites, or -1 if not tabulated */
+    static inline int hopIndex(int distance) { return distance == 1 ? 0 : (distance == 3 ? 1 : -1); }
+
+    /** @return Checkerboard index of the neighbor of site i, with periodic boundaries */
+    inline int neighbor(int parity, int i, int dir, int distance) const
+    { return nbr[parity][hopIndex(distance)][8 * i + dir]; }
+
+    /**
+       @return Checkerboard index of the neighbor of site i if it is
+       local, else -(ghost index + 1) where the ghost index follows the
+       layout of the ghost zones exchanged with nFace faces
+    */
+    inline int ghostNeighbor(int parity, int i, int dir, int distance) const
+    {
+      const int hop = hopIndex(distance);
+      return ghost_nbr[parity][hop].size() ? ghost_nbr[parity][hop][8 * i + dir] : nbr[parity][hop][8 * i + dir];
+    }
+  };
+
+  /** @return The cached geometry for the given local dimensions and ghost depth */
+  const LatticeGeometry &latticeGeometry(const int *X, int nFace);
+
+  /**
+     @return The cached geometry of the current lattice Z, or NULL if table lookups are disabled.
+     With nFace = 0 only the periodic neighbor tables are meant to be used.
+  */
+  const LatticeGeometry *hostGeometry(int nFace = 0);
+
   void printSpinorElement(void *spinor, int X, QudaPrecision precision);
   void printGaugeElement(void *gauge, int X, QudaPrecision precision);
   
@@ -0,0 +1,116 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <typeinfo>
+
+#include <quda_internal.h>
+#include <tune_quda.h>
+#include <test_util.h>
+
+// In a typical application, quda.h is the only QUDA header required.
+#include <quda.h>
+
+extern int device;
+extern int niter;
+extern int gridsize_from_cmdline[];
+
+extern void usage(char** );
+
+using namespace quda;
+
+// number of distinct kernels that are placed in the tunecache
+static const int n_kernel = 10000;
+
+// number of kernels that are cycled over when measuring hot lookups
+static const int n_hot = 16;
+
+/**
+   A kernel that does no work, used to measure the cost of the
+   tunecache lookup in tuneLaunch on its own.  As with real kernels
+   the key is rebuilt on every launch.
+ */
+class TuneCacheKernel : public Tunable {
+
+  int id;
+
+  long long flops() const { return 0; }
+  long long bytes() const { return 0; }
+  unsigned int sharedBytesPerThread() const { return 0; }
+  unsigned int sharedBytesPerBlock(const TuneParam &param) const { return 0; }
+  bool advanceTuneParam(TuneParam &param) const { return false; } // a single trial is enough
+
+public:
+  TuneCacheKernel(int id) : id(id) { }
+  virtual ~TuneCacheKernel() { }
+
+  TuneKey tuneKey() const {
+    char aux_[TuneKey::aux_n];
+    sprintf(aux_, "vol=%d,stride=%d,precision=%d,Ns=4,Nc=3,id=%d", 16*16*16*16, 16*16*16*8, 8, id);
+    return TuneKey("16x16x16x16", typeid(*this).name(), aux_);
+  }
+
+  void apply(const cudaStream_t &stream) { tuneLaunch(*this, getTuning(), getVerbosity()); }
+};
+
+void display_test_info()
+{
+  printfQuda("running the following test:\n");
+  printfQuda("tunecache lookup with %d kernels, %d iterations\n", n_kernel, niter);
+  printfQuda("Grid partition info:     X  Y  Z  T\n");
+  printfQuda("                         %d  %d  %d  %d\n", dimPartitioned(0), dimPartitioned(1), dimPartitioned(2),
+             dimPartitioned(3));
+}
+
+int main(int argc, char **argv)
+{
+  for (int i = 1; i < argc; i++) {
+    if (process_command_line_option(argc, argv, &i) == 0) continue;
+    printfQuda("ERROR: Invalid option:%s\n", argv[i]);
+    usage(argv);
+  }
+
+  initComms(argc, argv, gridsize_from_cmdline);
+  display_test_info();
+  initQuda(device);
+  setVerbosity(QUDA_SUMMARIZE);
+
+  TuneCacheKernel **kernel = new TuneCacheKernel*[n_kernel];
+  for (int i = 0; i < n_kernel; i++) kernel[i] = new TuneCacheKernel(i);
+
+  // populate the cache, tuning any kernel not already present
+  stopwatchStart();
+  for (int i = 0; i < n_kernel; i++) kernel[i]->apply(0);
+  double populate = stopwatchReadSeconds();
+  printfQuda("Populated tunecache with %d kernels in %g secs\n", n_kernel, populate);
+
+  const long n_launch = static_cast<long>(niter) * n_kernel;
+
+  stopwatchStart();
+  for (long i = 0; i < n_launch; i++) kernel[i % n_hot]->apply(0);
+  double hot = stopwatchReadSeconds();
+
+  // stride through the kernels so that successive lookups do not share cache lines
+  stopwatchStart();
+  for (long i = 0; i < n_launch; i++) kernel[(i * 7919) % n_kernel]->apply(0);
+  double cold = stopwatchReadSeconds();
+
+  printfQuda("tuneLaunch lookup: %g ns per launch cycling over %d kernels, %g ns per launch over %d kernels\n",
+             1e9 * hot / n_launch, n_hot, 1e9 * cold / n_launch, n_kernel);
+
+  // saving is skipped by tune.cpp unless QUDA_RESOURCE_PATH is set
+  stopwatchStart();
+  saveTuneCache();
+  double save = stopwatchReadSeconds();
+  stopwatchStart();
+  loadTuneCache();
+  double load = stopwatchReadSeconds();
+  printfQuda("tunecache save %g secs, load %g secs\n", save, load);
+
+  for (int i = 0; i < n_kernel; i++) delete kernel[i];
+  delete[] kernel;
+
+  endQuda();
+  finalizeComms();
+
+  return 0;
+}
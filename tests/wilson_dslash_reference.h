@@ -17,6 +17,17 @@ extern "C" {
   void wil_matpc(void *out, void **gauge, void *in, double kappa,
 		 QudaMatPCType matpc_type,  int daggerBit, QudaPrecision precision, QudaGaugeParam &param);
 
+  // multi-RHS variants, applying the operator to the nrhs vectors out[i] = M in[i]
+  // with each gauge link loaded once per block of up to maxMultiRHS vectors
+  void wil_dslash_mrhs(void **out, void **gauge, void **in, int nrhs, int oddBit,
+		       int daggerBit, QudaPrecision precision, QudaGaugeParam &param);
+
+  void wil_mat_mrhs(void **out, void **gauge, void **in, int nrhs, double kappa, int daggerBit,
+		    QudaPrecision precision, QudaGaugeParam &param);
+
+  void wil_matpc_mrhs(void **out, void **gauge, void **in, int nrhs, double kappa,
+		      QudaMatPCType matpc_type, int daggerBit, QudaPrecision precision, QudaGaugeParam &param);
+
   void tm_dslash(void *res, void **gauge, void *spinorField, double kappa,
 		 double mu, QudaTwistFlavorType flavor, int oddBit, QudaMatPCType matpc_type,
 		 int daggerBit, QudaPrecision sprecision, QudaGaugeParam &param);
@@ -58,6 +69,13 @@ extern "C" {
   void clover_matpc(void *out, void **gauge, void *clover, void *clover_inv, void *in, double kappa,
 		    QudaMatPCType matpc_type, int dagger, QudaPrecision precision, QudaGaugeParam &gauge_param);
 
+  void clover_mat_mrhs(void **out, void **gauge, void *clover, void **in, int nrhs, double kappa,
+		       int dagger, QudaPrecision precision, QudaGaugeParam &gauge_param);
+
+  void clover_matpc_mrhs(void **out, void **gauge, void *clover, void *clover_inv, void **in, int nrhs,
+			 double kappa, QudaMatPCType matpc_type, int dagger, QudaPrecision precision,
+			 QudaGaugeParam &gauge_param);
+
 #ifdef __cplusplus
 }
 #endif